@@ -1,50 +1,229 @@
 #include "clifford.h"
+#include "fixed_clifford.h"
+#include "pauli/pauli_kernels.h"
 #include "util/f2_helper.h"
 #include "stabiliser_state/check_matrix.h"
 #include "stabiliser_state/stabiliser_state.h"
+#include "util/fixed_size.h"
+#include "util/hash.h"
+#include "util/phase.h"
+#include "util/parallel.h"
+#include "util/stats.h"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <fstream>
+#include <stdexcept>
 
 namespace fst
 {
-    Clifford::Clifford(const std::vector<Pauli> z_conjugates, const std::vector<Pauli> x_conjugates, const std::complex<float> global_phase )
-        : z_conjugates(z_conjugates), x_conjugates(x_conjugates), global_phase(global_phase)
+    namespace
+    {
+        /// The number of columns each thread finds at a time, at least 2^16 entries so that small matrices stay on one thread
+        std::size_t column_grain_size(const std::size_t number_qubits)
+        {
+            return std::max<std::size_t>(1, (std::size_t(1) << 16) >> number_qubits);
+        }
+
+        /// The largest number of qubits for which get_matrix uses the fixed size kernel, whose temporary is as large as
+        /// the matrix. Larger matrices are filled from tiles of columns found in parallel by get_columns.
+        constexpr std::size_t max_fixed_matrix_qubits = 9;
+
+        /// The size of the largest block of columns [begin, begin + 2^m) within [begin, end) with begin a multiple of 2^m
+        std::size_t aligned_block_size(const std::size_t begin, const std::size_t end)
+        {
+            const std::size_t block_size = std::bit_floor(end - begin);
+            return begin == 0 ? block_size : std::min(block_size, std::size_t(1) << std::countr_zero(begin));
+        }
+    }
+
+    Clifford::Clifford(std::span<const Pauli> z_conjugates, std::span<const Pauli> x_conjugates, const std::complex<float> global_phase, const allocator_type &allocator)
+        : z_conjugates(z_conjugates.begin(), z_conjugates.end(), allocator), x_conjugates(x_conjugates.begin(), x_conjugates.end(), allocator), global_phase(global_phase)
         {
             number_qubits = z_conjugates.size();
         }
 
+    Clifford::Clifford(const Clifford &other, const allocator_type &allocator)
+        : number_qubits(other.number_qubits), z_conjugates(other.z_conjugates, allocator), x_conjugates(other.x_conjugates, allocator), global_phase(other.global_phase)
+    {
+    }
+
+    Clifford::allocator_type Clifford::get_allocator() const
+    {
+        return z_conjugates.get_allocator();
+    }
+
     std::vector<std::vector<std::complex<float>>> Clifford::get_matrix() const
     {
+        FST_TIME_SCOPE(clifford_matrix);
+
+        if (number_qubits <= max_fixed_matrix_qubits)
+        {
+            return dispatch_fixed_qubits(number_qubits, [this]<std::size_t N>() { return Fixed_Clifford<N>(*this).get_matrix(); });
+        }
+
         const std::size_t size = integral_pow_2(number_qubits);
-        std::vector<std::vector<std::complex<float>>> transposed_matrix(size, std::vector<std::complex<float>> (size, 0) );
+        std::vector<std::vector<std::complex<float>>> matrix(size, std::vector<std::complex<float>>(size, 0));
+
+        // Copy a batch of columns at a time into the rows, in tiles of 64 rows that stay in the cache
+        const std::size_t batch_size = std::min(size, std::max<std::size_t>(64, number_threads() * column_grain_size(number_qubits)));
+        std::vector<std::complex<float>> columns(batch_size * size);
+        FST_COUNT(bytes_allocated, (size + batch_size) * size * sizeof(std::complex<float>));
+
+        for (std::size_t first_column = 0; first_column < size; first_column += batch_size)
+        {
+            const std::size_t number_columns = std::min(batch_size, size - first_column);
+            get_columns(first_column, std::span(columns).first(number_columns * size));
 
+            // Beyond the fixed size kernel, the size is a multiple of 64
+            for (std::size_t first_row = 0; first_row < size; first_row += 64)
+            {
+                for (std::size_t k = 0; k < number_columns; k++)
+                {
+                    for (std::size_t i = first_row; i < first_row + 64; i++)
+                    {
+                        matrix[i][first_column + k] = columns[k * size + i];
+                    }
+                }
+            }
+        }
+
+        return matrix;
+    }
+
+    std::vector<std::complex<float>> Clifford::get_first_column() const
+    {
         Check_Matrix first_col_check_matrix(z_conjugates);
         Stabiliser_State state (first_col_check_matrix);
         state.global_phase = global_phase;
 
-        transposed_matrix[0] = state.get_state_vector();
+        std::vector<std::complex<float>> first_col = state.get_state_vector();
 
-        std::size_t old_col_index = 0;
+        // The global phase is that of the first non-zero entry of the first column, which need not be the entry at the
+        // shift of the state built from the check matrix
+        correct_first_column_phase(first_col, state.dim, global_phase);
 
-        for(std::size_t i = 1; i < size; i++)
-        {
-            // Iterate through the Gray code
-            std::size_t new_col_index = i ^ (i >> 1);
-            std::size_t bit_flipped = integral_log_2( old_col_index ^ new_col_index );
+        return first_col;
+    }
 
-            transposed_matrix[new_col_index] = x_conjugates.at(bit_flipped).multiply_vector(transposed_matrix[old_col_index]);
+    void Clifford::get_columns(const std::size_t first_column, std::span<std::complex<float>> columns) const
+    {
+        const std::size_t size = integral_pow_2(number_qubits);
+        const std::size_t number_columns = columns.size() / size;
 
-            old_col_index = new_col_index;
+        if (columns.size() % size != 0 || first_column > size || number_columns > size - first_column)
+        {
+            throw std::invalid_argument("The columns must be a whole number of columns of the matrix.");
         }
 
-        std::vector<std::vector<std::complex<float>>> matrix(size, std::vector<std::complex<float>>(size, 0));
-        
-        for(std::size_t i = 0; i < size; i++)
+        if (number_columns == 0)
         {
-            for(std::size_t j = 0; j < size; j++)
+            return;
+        }
+
+        const std::vector<std::complex<float>> first_col = get_first_column();
+
+        parallel_for(number_columns, column_grain_size(number_qubits), [&](const std::size_t begin, const std::size_t end)
             {
-                matrix[i][j] = transposed_matrix[j][i];
+                // U|j> = U X^j |0>, so a column follows from any other by the conjugates of the X_i for the bits where
+                // their indices differ. The range is covered by aligned blocks of 2^m columns, each walked in Gray code
+                // order, so that each column but the first of a block is one conjugate away from the previous one.
+                std::size_t previous_index = 0;
+                std::span<const std::complex<float>> previous_column = first_col;
+
+                for (std::size_t block_begin = first_column + begin; block_begin < first_column + end;)
+                {
+                    const std::size_t block_size = aligned_block_size(block_begin, first_column + end);
+
+                    for (std::size_t i = 0; i < block_size; i++)
+                    {
+                        const std::size_t index = block_begin + (i ^ (i >> 1));
+                        const std::span<std::complex<float>> column = columns.subspan((index - first_column) * size, size);
+
+                        if (i == 0)
+                        {
+                            std::ranges::copy(previous_column, column.begin());
+
+                            for (std::size_t bits = previous_index ^ index; bits != 0; bits &= bits - 1)
+                            {
+                                x_conjugates[std::countr_zero(bits)].apply_in_place(column);
+                            }
+                        }
+                        else
+                        {
+                            const Pauli &x_conjugate = x_conjugates[std::countr_zero(i)];
+                            apply_pauli_action({x_conjugate.x_vector, x_conjugate.z_vector, x_conjugate.get_phase_exponent()},
+                                previous_column.data(), column.data(), size);
+                        }
+
+                        previous_index = index;
+                        previous_column = column;
+                    }
+
+                    FST_COUNT(gray_code_steps, block_size - 1);
+                    block_begin += block_size;
+                }
+            });
+    }
+
+    void Clifford::for_each_column(const std::function<void(std::size_t, std::span<const std::complex<float>>)> &function, const std::size_t batch_columns) const
+    {
+        const std::size_t size = integral_pow_2(number_qubits);
+        const std::size_t batch_size = std::min(size, batch_columns != 0 ? batch_columns : number_threads() * column_grain_size(number_qubits));
+
+        std::vector<std::complex<float>> batch(batch_size * size);
+        FST_COUNT(bytes_allocated, batch.size() * sizeof(std::complex<float>));
+
+        for (std::size_t first_column = 0; first_column < size; first_column += batch_size)
+        {
+            const std::size_t number_columns = std::min(batch_size, size - first_column);
+            const std::span<std::complex<float>> columns(batch.data(), number_columns * size);
+            get_columns(first_column, columns);
+
+            for (std::size_t k = 0; k < number_columns; k++)
+            {
+                function(first_column + k, columns.subspan(k * size, size));
             }
         }
+    }
+
+    void Clifford::write_matrix(const std::string &path) const
+    {
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+
+        if (!file)
+        {
+            throw std::runtime_error("Could not open " + path);
+        }
 
-        return matrix;
+        for_each_column([&file](const std::size_t, std::span<const std::complex<float>> column)
+            {
+                file.write(reinterpret_cast<const char *>(column.data()), static_cast<std::streamsize>(column.size_bytes()));
+            });
+
+        if (!file)
+        {
+            throw std::runtime_error("Could not write " + path);
+        }
     }
-}
\ No newline at end of file
+
+    bool Clifford::operator==(const Clifford &other) const
+    {
+        return number_qubits == other.number_qubits && z_conjugates == other.z_conjugates && x_conjugates == other.x_conjugates
+            && std::norm(global_phase - other.global_phase) < 0.001;
+    }
+}
+
+std::size_t std::hash<fst::Clifford>::operator()(const fst::Clifford &clifford) const
+{
+    std::size_t seed = clifford.number_qubits;
+
+    for (std::size_t i = 0; i < clifford.number_qubits; i++)
+    {
+        fst::hash_combine(seed, std::hash<fst::Pauli>{}(clifford.z_conjugates[i]));
+        fst::hash_combine(seed, std::hash<fst::Pauli>{}(clifford.x_conjugates[i]));
+    }
+
+    return seed;
+}
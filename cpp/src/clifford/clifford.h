@@ -5,26 +5,80 @@
 
 #include <vector>
 #include <complex>
+#include <functional>
+#include <memory_resource>
+#include <span>
+#include <string>
 
 namespace fst
 {
     /// The class used to represent a Clifford operator U.
     /// Represented by its action on the Pauli basis:
     /// z_conjugates[i] = UZ_iU*, x_conjugates[i] = UX_iU*
+    ///
+    /// The conjugates are allocated with the allocator the Clifford is constructed with, as for Stabiliser_State.
     struct Clifford
     {
+        using allocator_type = std::pmr::polymorphic_allocator<>;
+
         std::size_t number_qubits = 0;
 
-        std::vector<Pauli> z_conjugates;
-        std::vector<Pauli> x_conjugates;
+        std::pmr::vector<Pauli> z_conjugates;
+        std::pmr::vector<Pauli> x_conjugates;
 
         std::complex<float> global_phase;
 
-        Clifford(const std::vector<Pauli> z_conjugates, const std::vector<Pauli> x_conjugates, const std::complex<float> global_phase = 1.0f);
+        Clifford(std::span<const Pauli> z_conjugates, std::span<const Pauli> x_conjugates, const std::complex<float> global_phase = 1.0f, const allocator_type &allocator = {});
+
+        Clifford(const Clifford &other) = default;
+        Clifford(Clifford &&other) = default;
+        Clifford &operator=(const Clifford &other) = default;
+        Clifford &operator=(Clifford &&other) = default;
+
+        /// Copies the Clifford, allocating with the given allocator
+        Clifford(const Clifford &other, const allocator_type &allocator);
 
-        /// Returns the matrix of the Clifford (with respect to the computational basis) 
+        allocator_type get_allocator() const;
+
+        /// Returns the matrix of the Clifford (with respect to the computational basis). Beyond a few qubits, tiles of
+        /// columns are found in parallel by get_columns and copied into the rows, so only a tile is held besides the
+        /// matrix.
         std::vector<std::vector<std::complex<float>>> get_matrix() const; 
+
+        /// Writes columns first_column, ..., first_column + k - 1 of the matrix into columns, which must hold the k
+        /// columns of length 2^n one after another. The range is split over number_threads() threads, each of which
+        /// covers its part by aligned blocks of 2^m columns walked in Gray code order, so that each column is found
+        /// from the previous one by a single conjugate of an X_i. The first column of each block is found from the
+        /// previous column (or U|0>) by the conjugates of the X_i for the bits that differ. Throws if the columns do
+        /// not fit in the matrix or the buffer is not a whole number of columns.
+        void get_columns(const std::size_t first_column, std::span<std::complex<float>> columns) const;
+
+        /// Calls function(j, column) for each column j of the matrix in order, on the calling thread. The columns are
+        /// found batch_columns at a time by get_columns, so the memory used is batch_columns * 2^n entries. By
+        /// default a batch has enough columns for each thread to find at least 2^16 entries.
+        void for_each_column(const std::function<void(std::size_t, std::span<const std::complex<float>>)> &function, const std::size_t batch_columns = 0) const;
+
+        /// Writes the matrix to the file at the given path as raw complex64 entries in column-major order, streamed
+        /// from for_each_column, and throws std::runtime_error if the file cannot be written
+        void write_matrix(const std::string &path) const;
+
+        /// The conjugates of the Z_i and X_i determine a Clifford up to phase, so the canonical form of a Clifford is
+        /// its tableau and global phase. Cliffords are equal when their tableaus are, and their global phases agree
+        /// up to a small error. This takes O(n^2) time.
+        bool operator==(const Clifford &other) const;
+
+        private:
+
+        /// Returns U|0>, whose first non-zero entry has the global phase
+        std::vector<std::complex<float>> get_first_column() const;
     };
 }
 
+/// Hashes the tableau of the Clifford (ignoring the global phase), so that equal Cliffords have equal hashes
+template <>
+struct std::hash<fst::Clifford>
+{
+    std::size_t operator()(const fst::Clifford &clifford) const;
+};
+
 #endif
\ No newline at end of file
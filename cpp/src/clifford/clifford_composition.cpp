@@ -0,0 +1,70 @@
+#include "clifford_composition.h"
+#include "stabiliser_state/check_matrix.h"
+#include "stabiliser_state/composition.h"
+#include "stabiliser_state/stabiliser_state.h"
+#include "util/f2_helper.h"
+
+#include <stdexcept>
+#include <vector>
+
+namespace fst
+{
+    Clifford tensor(const Clifford &first, const Clifford &second)
+    {
+        if (first.number_qubits + second.number_qubits > 64)
+        {
+            throw std::invalid_argument("The tensor product must have at most 64 qubits.");
+        }
+
+        const Pauli first_identity(first.number_qubits, 0, 0, 0, 0);
+        const Pauli second_identity(second.number_qubits, 0, 0, 0, 0);
+
+        std::vector<Pauli> z_conjugates;
+        std::vector<Pauli> x_conjugates;
+        z_conjugates.reserve(first.number_qubits + second.number_qubits);
+        x_conjugates.reserve(first.number_qubits + second.number_qubits);
+
+        for (std::size_t i = 0; i < second.number_qubits; i++)
+        {
+            z_conjugates.push_back(tensor(first_identity, second.z_conjugates[i]));
+            x_conjugates.push_back(tensor(first_identity, second.x_conjugates[i]));
+        }
+
+        for (std::size_t i = 0; i < first.number_qubits; i++)
+        {
+            z_conjugates.push_back(tensor(first.z_conjugates[i], second_identity));
+            x_conjugates.push_back(tensor(first.x_conjugates[i], second_identity));
+        }
+
+        // The first non-zero entry of the first column of the product is the product of those of the factors
+        return Clifford(z_conjugates, x_conjugates, first.global_phase * second.global_phase);
+    }
+
+    Clifford permute_qubits(const Clifford &clifford, std::span<const std::size_t> permutation)
+    {
+        if (!is_bit_permutation(permutation, clifford.number_qubits))
+        {
+            throw std::invalid_argument("The permutation must be a permutation of the qubits.");
+        }
+
+        std::vector<Pauli> z_conjugates(clifford.number_qubits);
+        std::vector<Pauli> x_conjugates(clifford.number_qubits);
+
+        for (std::size_t q = 0; q < clifford.number_qubits; q++)
+        {
+            z_conjugates[permutation[q]] = permute_qubits(clifford.z_conjugates[q], permutation);
+            x_conjugates[permutation[q]] = permute_qubits(clifford.x_conjugates[q], permutation);
+        }
+
+        // The shift of a canonical state is the first index of its support, and its global phase is the phase there
+        Check_Matrix first_column_check_matrix(clifford.z_conjugates);
+        Stabiliser_State first_column(first_column_check_matrix);
+        first_column.canonicalise();
+        first_column.global_phase = clifford.global_phase;
+
+        Stabiliser_State permuted_first_column = permute_qubits(first_column, permutation);
+        permuted_first_column.canonicalise();
+
+        return Clifford(z_conjugates, x_conjugates, permuted_first_column.global_phase);
+    }
+}
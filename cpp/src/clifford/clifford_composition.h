@@ -0,0 +1,21 @@
+#ifndef _FAST_STABILISER_CLIFFORD_COMPOSITION_H
+#define _FAST_STABILISER_CLIFFORD_COMPOSITION_H
+
+#include "clifford.h"
+
+#include <span>
+
+namespace fst
+{
+    /// Returns the tensor product of the Cliffords, equal to np.kron of their matrices: the qubits of the second
+    /// Clifford come first, followed by those of the first. The conjugates are padded with identities in O(n) time,
+    /// and the global phases multiply. Throws if the product has more than 64 qubits.
+    Clifford tensor(const Clifford &first, const Clifford &second);
+
+    /// Returns P U P*, for the permutation P moving qubit q to qubit permutation[q], in O(n^3) time. The global
+    /// phase is that of the first non-zero entry of the permuted first column, found from the canonical forms of the
+    /// states U|0> and P U|0>. Throws unless the permutation is a permutation of the qubits.
+    Clifford permute_qubits(const Clifford &clifford, std::span<const std::size_t> permutation);
+}
+
+#endif
@@ -0,0 +1,25 @@
+#ifndef _FAST_STABILISER_CLIFFORD_COMPOSITION_PYBIND_H
+#define _FAST_STABILISER_CLIFFORD_COMPOSITION_PYBIND_H
+
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+
+#include <vector>
+
+#include "clifford_composition.h"
+
+namespace py = pybind11;
+using namespace fst;
+
+namespace fst_pybind
+{
+    void init_clifford_composition(py::module_ &m)
+    {
+        m.def("tensor", py::overload_cast<const Clifford &, const Clifford &>(&tensor), py::arg("first"), py::arg("second"),
+            "Returns the tensor product of the Cliffords, equal to np.kron of their matrices, in polynomial time");
+        m.def("permute_qubits", [](const Clifford &clifford, const std::vector<std::size_t> &permutation) { return permute_qubits(clifford, permutation); },
+            py::arg("clifford"), py::arg("permutation"), "Returns P U P* for the permutation P moving qubit q to qubit permutation[q]");
+    }
+}
+
+#endif
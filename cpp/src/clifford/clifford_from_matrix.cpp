@@ -1,49 +1,347 @@
 #include "clifford_from_matrix.h"
 
+#include "pauli/pauli_kernels.h"
 #include "util/f2_helper.h"
+#include "util/phase.h"
+#include "util/stats.h"
 #include "stabiliser_state/stabiliser_state.h"
 #include "stabiliser_state/check_matrix.h"
 #include "stabiliser_state/stabiliser_state_from_statevector.h"
 
+#include <concepts>
+#include <memory_resource>
 #include <optional>
+#include <span>
 #include <tuple>
+#include <utility>
 
 using namespace fst;
 
 namespace
 {
-    std::vector<std::vector<std::complex<float>>> transpose_matrix(const std::vector<std::vector<std::complex<float>>> &matrix, const std::size_t &size)
+    /// Returns the transpose of the matrix, flattened in row-major order, so that its rows are the columns of the matrix
+    template <std::floating_point Real>
+    std::pmr::vector<std::complex<Real>> transpose_matrix(const std::vector<std::vector<std::complex<Real>>> &matrix, const std::size_t &size, Scratch_Arena &scratch)
     {
-        std::vector<std::vector<std::complex<float>>> transposed_matrix ( size, std::vector<std::complex<float>> (size) );
+        std::pmr::vector<std::complex<Real>> transposed_matrix (size * size, &scratch);
         
         for (std::size_t i = 0; i < size; i++)
         {
             for (std::size_t j = 0; j < size; j++)
             {
-                transposed_matrix[i][j] = matrix[j][i];
+                transposed_matrix[i * size + j] = matrix[j][i];
             }
         }
 
         return transposed_matrix;
     }
 
-    template <bool assume_valid, bool return_state>
-    auto clifford_from_matrix_internal(const std::vector<std::vector<std::complex<float>>> &matrix)
+    /// Read access to a dense matrix, indexed by row then column
+    template <std::floating_point Real>
+    struct Dense_Matrix_View
+    {
+        using amplitude_type = std::complex<Real>;
+
+        const std::vector<std::vector<std::complex<Real>>> &matrix;
+
+        std::complex<Real> at(const std::size_t row, const std::size_t column) const
+        {
+            return matrix[row][column];
+        }
+
+        /// Returns the row of the first non-zero entry of the column, or the size of the matrix if there are none
+        std::size_t non_zero_row(const std::size_t column) const
+        {
+            std::size_t row = 0;
+
+            while (row < matrix.size() && matrix[row][column] == Real(0))
+            {
+                ++row;
+            }
+
+            return row;
+        }
+
+        bool is_zero_except_at(const std::size_t column, const std::size_t non_zero_row) const
+        {
+            for (std::size_t row = 0; row < matrix.size(); row++)
+            {
+                if (row != non_zero_row && matrix[row][column] != Real(0))
+                {
+                    return false;
+                }
+            }
+
+            return true;
+        }
+    };
+
+    /// Read access to a monomial matrix, in the same form as Dense_Matrix_View
+    struct Monomial_Matrix_View
+    {
+        using amplitude_type = std::complex<float>;
+
+        const Monomial_Matrix &matrix;
+
+        std::complex<float> at(const std::size_t row, const std::size_t column) const
+        {
+            return matrix.rows[column] == row ? matrix.entries[column] : 0;
+        }
+
+        std::size_t non_zero_row(const std::size_t column) const
+        {
+            return matrix.rows[column];
+        }
+
+        bool is_zero_except_at(const std::size_t, const std::size_t) const
+        {
+            return true;
+        }
+    };
+
+    /// Given the columns a_i of an invertible matrix A over F_2, returns the rows of A^(-1), or nothing if
+    /// A is singular
+    std::optional<std::pmr::vector<std::size_t>> invert_f2_matrix(const std::span<const std::size_t> columns, Scratch_Arena &scratch)
+    {
+        const std::size_t size = columns.size();
+        std::pmr::vector<std::size_t> rows (size, 0, &scratch);
+        std::pmr::vector<std::size_t> inverse_rows (size, 0, &scratch);
+
+        for (std::size_t i = 0; i < size; i++)
+        {
+            inverse_rows[i] = integral_pow_2(i);
+
+            for (std::size_t j = 0; j < size; j++)
+            {
+                rows[i] |= static_cast<std::size_t>(bit_set_at(columns[j], i)) << j;
+            }
+        }
+
+        // Gauss-Jordan elimination, applying the same row operations to the identity
+        for (std::size_t i = 0; i < size; i++)
+        {
+            std::size_t pivot_row = i;
+
+            while (pivot_row < size && !bit_set_at(rows[pivot_row], i))
+            {
+                ++pivot_row;
+            }
+
+            if (pivot_row == size)
+            {
+                return std::nullopt;
+            }
+
+            std::swap(rows[i], rows[pivot_row]);
+            std::swap(inverse_rows[i], inverse_rows[pivot_row]);
+
+            for (std::size_t j = 0; j < size; j++)
+            {
+                if (j != i && bit_set_at(rows[j], i))
+                {
+                    rows[j] ^= rows[i];
+                    inverse_rows[j] ^= inverse_rows[i];
+                }
+            }
+        }
+
+        return inverse_rows;
+    }
+
+    /// The fast path for Cliffords whose matrix is monomial, i.e. U|c> = p(c) |Ac + b> for an invertible A over F_2.
+    /// These are exactly the Cliffords whose first column is a computational basis state, and are built from
+    /// X, CNOT, SWAP, S and CZ gates. Then U Z_i U* = (-1)^(v_i . b) Z^(v_i) for v_i the i-th row of A^(-1), and
+    /// U X_i U* is X^(a_i) Z^(z) up to a phase, where a_i is the i-th column of A. Writing z = sum_j t_j v_j, the
+    /// bits t_j and the phase are read off the ratios of the entries in the columns 0, e_i, e_j and e_i + e_j.
+    /// This takes O(n^2) entries, plus O(n 2^n) to find the non-zero entries of the columns e_i in a dense matrix.
+    template <bool assume_valid, bool return_state, typename Matrix_View>
+    auto monomial_clifford_internal(const Matrix_View &matrix, const std::size_t size, Scratch_Arena &scratch, const Clifford::allocator_type &allocator)
+        -> std::conditional_t<return_state, std::optional<fst::Clifford>, bool>
+    {
+        using Amplitude = typename Matrix_View::amplitude_type;
+
+        const std::size_t number_qubits = integral_log_2(size);
+
+        const std::size_t shift = matrix.non_zero_row(0);
+
+        if (shift == size)
+        {
+            return {};
+        }
+
+        const Amplitude first_entry = matrix.at(shift, 0);
+
+        if (std::abs(std::norm(first_entry) - 1) >= 0.125)
+        {
+            return {};
+        }
+
+        std::pmr::vector<std::size_t> x_vectors (number_qubits, &scratch);
+        std::pmr::vector<Phase_Exponent> column_phase_exponents (number_qubits, &scratch);
+
+        for (std::size_t i = 0; i < number_qubits; i++)
+        {
+            const std::size_t row = matrix.non_zero_row(integral_pow_2(i));
+
+            if (row == size)
+            {
+                return {};
+            }
+
+            const std::optional<Phase_Exponent> phase_exponent = quarter_phase_exponent(matrix.at(row, integral_pow_2(i)) / first_entry);
+
+            if (!phase_exponent)
+            {
+                return {};
+            }
+
+            x_vectors[i] = row ^ shift;
+            column_phase_exponents[i] = *phase_exponent;
+        }
+
+        const std::optional<std::pmr::vector<std::size_t>> inverse_rows = invert_f2_matrix(x_vectors, scratch);
+
+        if (!inverse_rows)
+        {
+            return {};
+        }
+
+        std::pmr::vector<Pauli> z_conjugates (&scratch);
+        std::pmr::vector<Pauli> x_conjugates (&scratch);
+        z_conjugates.reserve(number_qubits);
+        x_conjugates.reserve(number_qubits);
+
+        for (std::size_t i = 0; i < number_qubits; i++)
+        {
+            z_conjugates.push_back(Pauli(number_qubits, 0, (*inverse_rows)[i], f2_dot_product(shift, (*inverse_rows)[i]), 0));
+        }
+
+        for (std::size_t i = 0; i < number_qubits; i++)
+        {
+            const std::size_t column_index = integral_pow_2(i);
+            std::size_t z_vector = 0;
+
+            // p(e_i + e_j) / p(e_j) = p(e_i) / p(0) * (-1)^(a_j . z)
+            for (std::size_t j = 0; j < number_qubits; j++)
+            {
+                const std::size_t row = shift ^ x_vectors[i] ^ x_vectors[j];
+                const Amplitude entry = matrix.at(row, column_index ^ integral_pow_2(j));
+                const Amplitude previous_entry = matrix.at(shift ^ x_vectors[j], integral_pow_2(j));
+
+                const std::optional<Phase_Exponent> phase_exponent = quarter_phase_exponent(entry / previous_entry);
+
+                if (!phase_exponent)
+                {
+                    return {};
+                }
+
+                const Phase_Exponent relative_phase_exponent = (*phase_exponent - column_phase_exponents[i]) & 7;
+
+                if (relative_phase_exponent == 4)
+                {
+                    z_vector ^= (*inverse_rows)[j];
+                }
+                else if (relative_phase_exponent != 0)
+                {
+                    return {};
+                }
+            }
+
+            Pauli x_conjugate (number_qubits, x_vectors[i], z_vector, 0, 0);
+            x_conjugate.set_phase_exponent(column_phase_exponents[i] - 4 * f2_dot_product(shift, z_vector));
+            x_conjugates.push_back(std::move(x_conjugate));
+        }
+
+        if constexpr (!assume_valid)
+        {
+            std::size_t old_col_index = 0;
+            std::size_t old_row = shift;
+            Amplitude old_entry = first_entry;
+
+            if (!matrix.is_zero_except_at(0, shift))
+            {
+                return {};
+            }
+
+            for (std::size_t i = 1; i < size; i++)
+            {
+                // Iterate through the gray code
+                const std::size_t new_col_index = i ^ (i >> 1);
+                const Pauli &pauli_flip = x_conjugates[integral_log_2(new_col_index ^ old_col_index)];
+
+                const std::size_t new_row = old_row ^ pauli_flip.x_vector;
+                const Amplitude new_entry = multiply_by_phase(old_entry, pauli_flip.get_phase_exponent() + 4 * f2_dot_product(old_row, pauli_flip.z_vector));
+
+                if (!amplitudes_match(matrix.at(new_row, new_col_index), new_entry) || !matrix.is_zero_except_at(new_col_index, new_row))
+                {
+                    return {};
+                }
+
+                old_col_index = new_col_index;
+                old_row = new_row;
+                old_entry = new_entry;
+            }
+        }
+
+        if constexpr (return_state)
+        {
+            return Clifford (z_conjugates, x_conjugates, std::complex<float>(first_entry), allocator);
+        }
+        else
+        {
+            return true;
+        }
+    }
+
+    /// Returns whether the first column of the matrix has a single non-zero entry, in which case the matrix can
+    /// only be a Clifford if it is monomial
+    template <std::floating_point Real>
+    bool has_basis_state_first_column(const std::vector<std::vector<std::complex<Real>>> &matrix)
+    {
+        std::size_t number_non_zero = 0;
+
+        for (const std::vector<std::complex<Real>> &row : matrix)
+        {
+            if (row.empty())
+            {
+                return false;
+            }
+
+            number_non_zero += row[0] != Real(0);
+        }
+
+        return number_non_zero == 1;
+    }
+
+    template <bool assume_valid, bool return_state, std::floating_point Real>
+    auto clifford_from_matrix_internal(const std::vector<std::vector<std::complex<Real>>> &matrix, Scratch_Arena &scratch, const Clifford::allocator_type &allocator)
         -> std::conditional_t<return_state, std::optional<fst::Clifford>, bool>
     {
         const std::size_t size = matrix.size();
-        std::vector<std::vector<std::complex<float>>> transposed_matrix = transpose_matrix(matrix, size);
 
         if (!is_power_of_2(size))
         {   
             return {};
         }
 
-        Stabiliser_State first_col_state;
+        if (has_basis_state_first_column(matrix))
+        {
+            return monomial_clifford_internal<assume_valid, return_state>(Dense_Matrix_View<Real> {matrix}, size, scratch, allocator);
+        }
+
+        const std::pmr::vector<std::complex<Real>> transposed_matrix = transpose_matrix(matrix, size, scratch);
+
+        // The columns of the matrix, as rows of the transpose
+        const auto column = [&transposed_matrix, size](const std::size_t index)
+        {
+            return std::span<const std::complex<Real>>(transposed_matrix).subspan(index * size, size);
+        };
+
+        Stabiliser_State first_col_state (&scratch);
 
         try
         {
-            first_col_state = std::move(stabiliser_from_statevector(transposed_matrix[0], assume_valid));
+            first_col_state = stabiliser_from_statevector(column(0), scratch, assume_valid);
         }
         catch (...)
         {   
@@ -52,39 +350,38 @@ namespace
 
         std::size_t number_qubits = first_col_state.number_qubits;
 
-        Check_Matrix first_col_check_matrix (first_col_state);
+        Check_Matrix first_col_check_matrix (first_col_state, &scratch);
         
-        std::vector<Pauli> uncorrected_W_paulis;
+        std::pmr::vector<Pauli> uncorrected_W_paulis (&scratch);
         uncorrected_W_paulis.reserve(number_qubits);
 
         // TODO: we calculate these when constructing the check_matrix, remove calculation?
-        std::unordered_set<std::size_t> pivot_indices;
-        pivot_indices.reserve(number_qubits);
+        std::size_t pivot_mask = 0;
 
         for (auto pauli_p : first_col_check_matrix.get_x_stabilisers())
         {
             std::size_t pivot_index = integral_log_2(pauli_p->x_vector);
-            pivot_indices.insert(pivot_index);            
+            pivot_mask |= integral_pow_2(pivot_index);
             uncorrected_W_paulis.push_back(Pauli(number_qubits, 0, integral_pow_2(pivot_index), 0, 0));
         }
 
         for (std::size_t i = 0; i < number_qubits; i++)
         {
-            if (!pivot_indices.contains(i))
+            if (!bit_set_at(pivot_mask, i))
             {
                 uncorrected_W_paulis.push_back(Pauli(number_qubits, integral_pow_2(i),0, 0, 0));
             }
         }
 
-        std::vector<Pauli> first_col_paulis = first_col_check_matrix.get_paulis();
-        std::vector<std::size_t> first_col_effects (number_qubits, 0);
+        std::pmr::vector<Pauli> first_col_paulis (first_col_check_matrix.get_paulis(), &scratch);
+        std::pmr::vector<std::size_t> first_col_effects (number_qubits, 0, &scratch);
 
         for (std::size_t i = 0; i < number_qubits; i++)
         {
             std::size_t col_index = integral_pow_2(i);
             std::size_t row_index = 0;
 
-            while (row_index < size && transposed_matrix[col_index][row_index] == .0f)
+            while (row_index < size && column(col_index)[row_index] == Real(0))
             {
                 ++row_index;
             }
@@ -94,26 +391,33 @@ namespace
                 return {};
             }
 
-            std::complex<float> non_zero_entry = transposed_matrix[col_index][row_index];
+            std::complex<Real> non_zero_entry = column(col_index)[row_index];
 
             for (std::size_t j = 0; j < number_qubits; j++)
             {
-                //TODO make pointer?
-                Pauli pauli = first_col_paulis[j];
-                std::complex<float> phase = transposed_matrix[col_index][row_index ^ pauli.x_vector]/(non_zero_entry * sign_f2_dot_product(row_index, pauli.z_vector) * pauli.get_phase());
+                const Pauli &pauli = first_col_paulis[j];
+                const std::optional<Phase_Exponent> phase_exponent = quarter_phase_exponent(column(col_index)[row_index ^ pauli.x_vector] / non_zero_entry);
 
-                if (std::norm(phase + 1.0f) < 0.125)
+                if (!phase_exponent)
+                {
+                    return {};
+                }
+
+                // The column is an eigenvector of the pauli with eigenvalue (-1)^(relative_phase_exponent/4)
+                const Phase_Exponent relative_phase_exponent = (*phase_exponent - pauli.get_phase_exponent() - 4 * f2_dot_product(row_index, pauli.z_vector)) & 7;
+
+                if (relative_phase_exponent == 4)
                 {
                     first_col_effects[j] ^= col_index;
                 }
-                else if (std::norm(phase - 1.0f) >= 0.125)
+                else if (relative_phase_exponent != 0)
                 {
                     return {};
                 }
             }
         }
 
-        std::vector<std::size_t> pauli_ordering (number_qubits);
+        std::pmr::vector<std::size_t> pauli_ordering (number_qubits, &scratch);
 
         for (std::size_t i = 0; i < number_qubits; i++)
         {
@@ -136,8 +440,8 @@ namespace
             }
         }
 
-        std::vector<Pauli> z_conjugates (number_qubits);
-        std::vector<Pauli> W_paulis (number_qubits);
+        std::pmr::vector<Pauli> z_conjugates (number_qubits, &scratch);
+        std::pmr::vector<Pauli> W_paulis (number_qubits, &scratch);
 
         for (std::size_t i = 0; i < number_qubits; i++)
         {
@@ -151,7 +455,9 @@ namespace
             {
                 for (std::size_t i = 1; i < number_qubits; i++)
                 {
-                    if (! z_conjugates[i].has_eigenstate(transposed_matrix[col_index], bit_set_at(col_index, i)))
+                    const Pauli &pauli = z_conjugates[i];
+
+                    if (!is_fixed_by_pauli_action({pauli.x_vector, pauli.z_vector, pauli.get_phase_exponent() + 4 * bit_set_at(col_index, i)}, column(col_index).data(), size))
                     {
                         return {};
                     }
@@ -163,44 +469,40 @@ namespace
         {
             std::size_t non_zero_index = first_col_state.shift ^ W_paulis[i].x_vector;
             std::size_t col_index = integral_pow_2(i);
-            std::complex<float> relative_phase = transposed_matrix[col_index][non_zero_index]/(transposed_matrix[0][first_col_state.shift]*sign_f2_dot_product(first_col_state.shift, W_paulis[i].z_vector)*W_paulis[i].get_phase());
+            const std::optional<Phase_Exponent> phase_exponent = quarter_phase_exponent(column(col_index)[non_zero_index] / column(0)[first_col_state.shift]);
 
-            if (std::norm(relative_phase + 1.0f) < 0.125)
-            {
-                W_paulis[i].sign_bit ^= 1;
-            }
-            else if (std::norm(relative_phase + std::complex<float>{0,1}) < 0.125)
-            {
-                W_paulis[i].sign_bit ^= W_paulis[i].imag_bit;
-                W_paulis[i].imag_bit ^= 1;
-            }
-            else if (std::norm(relative_phase - std::complex<float>{0,1}) < 0.125)
-            {
-                W_paulis[i].sign_bit ^= !W_paulis[i].imag_bit;
-                W_paulis[i].imag_bit ^= 1;
-            }
-            else if (std::norm(relative_phase - 1.0f) >= 0.125)
+            if (!phase_exponent)
             {
                 return {};
             }
+
+            // Multiply the phase of the pauli by the relative phase, so that it maps the first column to this one
+            W_paulis[i].set_phase_exponent(*phase_exponent - 4 * f2_dot_product(first_col_state.shift, W_paulis[i].z_vector));
         }
 
         for (std::size_t i = 0; i < number_qubits; i++)
         {
             std::size_t i_non_zero_index = first_col_state.shift ^ W_paulis[i].x_vector;
             std::size_t i_col_index = integral_pow_2(i);
-            std::complex<float> i_non_zero_entry = transposed_matrix[i_col_index][i_non_zero_index]; 
+            std::complex<Real> i_non_zero_entry = column(i_col_index)[i_non_zero_index]; 
 
             for (std::size_t j = 0; j < number_qubits; j++)
             {
                 std::size_t ij_non_zero_index = i_non_zero_index ^ W_paulis[j].x_vector;
-                std::complex<float> relative_phase = transposed_matrix[i_col_index ^ integral_pow_2(j)][ij_non_zero_index]/(i_non_zero_entry*sign_f2_dot_product(i_non_zero_index, W_paulis[j].z_vector)*W_paulis[j].get_phase());
+                const std::optional<Phase_Exponent> phase_exponent = quarter_phase_exponent(column(i_col_index ^ integral_pow_2(j))[ij_non_zero_index] / i_non_zero_entry);
+
+                if (!phase_exponent)
+                {
+                    return {};
+                }
 
-                if (std::norm(relative_phase + 1.0f) < 0.125)
+                const Phase_Exponent relative_phase_exponent = (*phase_exponent - W_paulis[j].get_phase_exponent() - 4 * f2_dot_product(i_non_zero_index, W_paulis[j].z_vector)) & 7;
+
+                if (relative_phase_exponent == 4)
                 {
                     W_paulis[j].multiply_by_pauli_on_right(z_conjugates[i]);
                 }
-                else if (std::norm(relative_phase - 1.0f) >= 0.125)
+                else if (relative_phase_exponent != 0)
                 {
                     return {};
                 }
@@ -218,10 +520,12 @@ namespace
                 std::size_t new_col_index = i ^ (i >> 1);
                 std::size_t flipped_bit = integral_log_2(new_col_index ^ old_col_index);
 
-                Pauli pauli_flip = W_paulis[flipped_bit];
+                const Pauli &pauli_flip = W_paulis[flipped_bit];
                 std::size_t new_support = old_support ^ pauli_flip.x_vector;
 
-                if (std::norm(transposed_matrix[new_col_index][new_support] - transposed_matrix[old_col_index][old_support]*sign_f2_dot_product(old_support, pauli_flip.z_vector)*pauli_flip.get_phase()) >= 0.001)
+                const Phase_Exponent phase_exponent = pauli_flip.get_phase_exponent() + 4 * f2_dot_product(old_support, pauli_flip.z_vector);
+
+                if (!amplitudes_match(column(new_col_index)[new_support], multiply_by_phase(column(old_col_index)[old_support], phase_exponent)))
                 {
                     return {};
                 }
@@ -233,30 +537,130 @@ namespace
 
         if constexpr (return_state)
         {
-            return Clifford (z_conjugates, W_paulis, first_col_state.global_phase);
+            return Clifford (z_conjugates, W_paulis, first_col_state.global_phase, allocator);
         }
         else
         {
             return true;
         }
     }
+
+    template <std::floating_point Real>
+    Clifford convert_dense_matrix(const std::vector<std::vector<std::complex<Real>>> &matrix, const bool assume_valid, Scratch_Arena &scratch,
+        const Clifford::allocator_type &allocator)
+    {
+        std::optional<Clifford> clifford = assume_valid 
+                                    ? clifford_from_matrix_internal<true, true, Real>(matrix, scratch, allocator)
+                                    : clifford_from_matrix_internal<false, true, Real>(matrix, scratch, allocator);
+
+        if (!clifford)
+        {
+            throw std::invalid_argument("Matrix was not a Clifford");
+        }
+
+        return *std::move(clifford);
+    }
+
+    Clifford convert_monomial_matrix(const Monomial_Matrix &matrix, const bool assume_valid, Scratch_Arena &scratch, const Clifford::allocator_type &allocator)
+    {
+        std::optional<Clifford> clifford;
+
+        if (is_power_of_2(matrix.size()))
+        {
+            clifford = assume_valid
+                ? monomial_clifford_internal<true, true>(Monomial_Matrix_View {matrix}, matrix.size(), scratch, allocator)
+                : monomial_clifford_internal<false, true>(Monomial_Matrix_View {matrix}, matrix.size(), scratch, allocator);
+        }
+
+        if (!clifford)
+        {
+            throw std::invalid_argument("Matrix was not a Clifford");
+        }
+
+        return *std::move(clifford);
+    }
 }
 
 fst::Clifford fst::clifford_from_matrix(const std::vector<std::vector<std::complex<float>>> &matrix, const bool assume_valid)
 {
-    std::optional<Clifford> clifford = assume_valid 
-                                ? clifford_from_matrix_internal<true, true>(matrix)
-                                : clifford_from_matrix_internal<false, true>(matrix);
+    FST_TIME_SCOPE(clifford_from_matrix);
 
-    if (!clifford)
-    {
-        throw std::invalid_argument("Matrix was not a Clifford");
-    }
+    const Scratch_Scope scope(thread_scratch_arena());
+    return convert_dense_matrix(matrix, assume_valid, thread_scratch_arena(), {});
+}
 
-    return *std::move(clifford);
+fst::Clifford fst::clifford_from_matrix(const std::vector<std::vector<std::complex<float>>> &matrix, Scratch_Arena &arena, const bool assume_valid)
+{
+    FST_TIME_SCOPE(clifford_from_matrix);
+
+    return convert_dense_matrix(matrix, assume_valid, arena, &arena);
 }
 
-bool fst::is_clifford_matrix(const std::vector<std::vector<std::complex<float>>> &matrix )
+bool fst::is_clifford_matrix(const std::vector<std::vector<std::complex<float>>> &matrix)
 {
-    return clifford_from_matrix_internal<false, false>(matrix);
-}
\ No newline at end of file
+    return is_clifford_matrix(matrix, thread_scratch_arena());
+}
+
+bool fst::is_clifford_matrix(const std::vector<std::vector<std::complex<float>>> &matrix, Scratch_Arena &arena)
+{
+    FST_TIME_SCOPE(clifford_from_matrix);
+
+    const Scratch_Scope scope(arena);
+    return clifford_from_matrix_internal<false, false, float>(matrix, arena, &arena);
+}
+
+fst::Clifford fst::clifford_from_matrix(const std::vector<std::vector<std::complex<double>>> &matrix, const bool assume_valid)
+{
+    FST_TIME_SCOPE(clifford_from_matrix);
+
+    const Scratch_Scope scope(thread_scratch_arena());
+    return convert_dense_matrix(matrix, assume_valid, thread_scratch_arena(), {});
+}
+
+fst::Clifford fst::clifford_from_matrix(const std::vector<std::vector<std::complex<double>>> &matrix, Scratch_Arena &arena, const bool assume_valid)
+{
+    FST_TIME_SCOPE(clifford_from_matrix);
+
+    return convert_dense_matrix(matrix, assume_valid, arena, &arena);
+}
+
+bool fst::is_clifford_matrix(const std::vector<std::vector<std::complex<double>>> &matrix)
+{
+    return is_clifford_matrix(matrix, thread_scratch_arena());
+}
+
+bool fst::is_clifford_matrix(const std::vector<std::vector<std::complex<double>>> &matrix, Scratch_Arena &arena)
+{
+    FST_TIME_SCOPE(clifford_from_matrix);
+
+    const Scratch_Scope scope(arena);
+    return clifford_from_matrix_internal<false, false, double>(matrix, arena, &arena);
+}
+
+fst::Clifford fst::clifford_from_matrix(const Monomial_Matrix &matrix, const bool assume_valid)
+{
+    FST_TIME_SCOPE(clifford_from_matrix);
+
+    const Scratch_Scope scope(thread_scratch_arena());
+    return convert_monomial_matrix(matrix, assume_valid, thread_scratch_arena(), {});
+}
+
+fst::Clifford fst::clifford_from_matrix(const Monomial_Matrix &matrix, Scratch_Arena &arena, const bool assume_valid)
+{
+    FST_TIME_SCOPE(clifford_from_matrix);
+
+    return convert_monomial_matrix(matrix, assume_valid, arena, &arena);
+}
+
+bool fst::is_clifford_matrix(const Monomial_Matrix &matrix)
+{
+    return is_clifford_matrix(matrix, thread_scratch_arena());
+}
+
+bool fst::is_clifford_matrix(const Monomial_Matrix &matrix, Scratch_Arena &arena)
+{
+    FST_TIME_SCOPE(clifford_from_matrix);
+
+    const Scratch_Scope scope(arena);
+    return is_power_of_2(matrix.size()) && monomial_clifford_internal<false, false>(Monomial_Matrix_View {matrix}, matrix.size(), arena, &arena);
+}
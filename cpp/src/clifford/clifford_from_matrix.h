@@ -4,6 +4,8 @@
 #include <complex>
 
 #include "clifford.h"
+#include "pauli/monomial_matrix.h"
+#include "util/scratch_arena.h"
 
 namespace fst
 {
@@ -15,6 +17,32 @@ namespace fst
 
     /// Test wheter a matrix with complex entries corresponds to a clifford state.
     bool is_clifford_matrix(const std::vector<std::vector<std::complex<float>>> &matrix);
+
+    /// Convert a monomial matrix (e.g. of a circuit of X, CNOT, SWAP, S and CZ gates) into a clifford object, in
+    /// O(n 2^n) time (or O(n^2) when assuming valid). Matrices given densely with a single non-zero entry in their
+    /// first column also take this path.
+    Clifford clifford_from_matrix (const Monomial_Matrix &matrix, const bool assume_valid = false);
+
+    /// Test whether a monomial matrix corresponds to a clifford
+    bool is_clifford_matrix(const Monomial_Matrix &matrix);
+
+    /// The conversions above keep their temporaries (including the transpose of a dense matrix) in the thread's
+    /// scratch arena. These overloads instead allocate the temporaries and the returned Clifford in the given arena,
+    /// as for stabiliser_from_statevector. The Clifford is only valid until the arena is reset.
+    Clifford clifford_from_matrix (const std::vector<std::vector<std::complex<float>>> &matrix, Scratch_Arena &arena, const bool assume_valid = false);
+    Clifford clifford_from_matrix (const Monomial_Matrix &matrix, Scratch_Arena &arena, const bool assume_valid = false);
+
+    /// The tests rewind the arena when done, so leave it as they found it
+    bool is_clifford_matrix(const std::vector<std::vector<std::complex<float>>> &matrix, Scratch_Arena &arena);
+    bool is_clifford_matrix(const Monomial_Matrix &matrix, Scratch_Arena &arena);
+
+    /// The same conversions and tests for matrices with double precision entries, which are compared in double
+    /// precision (see amplitude_tolerance in util/phase.h). The global phase of the Clifford is stored in single
+    /// precision as usual.
+    Clifford clifford_from_matrix (const std::vector<std::vector<std::complex<double>>> &matrix, const bool assume_valid = false);
+    Clifford clifford_from_matrix (const std::vector<std::vector<std::complex<double>>> &matrix, Scratch_Arena &arena, const bool assume_valid = false);
+    bool is_clifford_matrix(const std::vector<std::vector<std::complex<double>>> &matrix);
+    bool is_clifford_matrix(const std::vector<std::vector<std::complex<double>>> &matrix, Scratch_Arena &arena);
 }
 
 #endif
\ No newline at end of file
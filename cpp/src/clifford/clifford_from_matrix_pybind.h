@@ -3,21 +3,52 @@
 
 #include <pybind11/pybind11.h>
 #include <pybind11/complex.h>
+#include <pybind11/numpy.h>
 #include <pybind11/stl.h>
 
+#include <stdexcept>
+
 #include "clifford_from_matrix.h"
 
 namespace py = pybind11;
 using namespace fst;
 
-// Eliminate copying by making types opaque, accept np arrays?
-
 namespace fst_pybind
 {
+    /// Copies the rows of a two dimensional numpy array of dtype complex128, keeping double precision
+    std::vector<std::vector<std::complex<double>>> double_matrix_rows(const py::array_t<std::complex<double>> &matrix)
+    {
+        if (matrix.ndim() != 2)
+        {
+            throw std::invalid_argument("The matrix must be two dimensional.");
+        }
+
+        const auto entries = matrix.unchecked<2>();
+        std::vector<std::vector<std::complex<double>>> rows(static_cast<std::size_t>(entries.shape(0)), std::vector<std::complex<double>>(static_cast<std::size_t>(entries.shape(1))));
+
+        for (py::ssize_t row = 0; row < entries.shape(0); row++)
+        {
+            for (py::ssize_t column = 0; column < entries.shape(1); column++)
+            {
+                rows[row][column] = entries(row, column);
+            }
+        }
+
+        return rows;
+    }
+
     void init_clifford_from_matrix(py::module_ &m)
     {
-        m.def("clifford_from_matrix", &clifford_from_matrix, py::arg("matrix"), py::arg("assume_valid") = false, "Converts a 2^n by 2^n matrix with complex entries into a Clifford object. Assuming valid is faster, but will result in undefined behaviour if the matrix is not in fact a valid Clifford operator");
-        m.def("is_clifford_matrix", &is_clifford_matrix, py::arg("matrix"), "Tests whether a matrix with complex entries corresponds to a Clifford");
+        // Arrays of dtype complex128 are compared in double precision, and come first as anything else matching
+        // them would be converted to complex64
+        m.def("clifford_from_matrix", [](const py::array_t<std::complex<double>> &matrix, const bool assume_valid) { return clifford_from_matrix(double_matrix_rows(matrix), assume_valid); },
+            py::arg("matrix").noconvert(), py::arg("assume_valid") = false, "Converts a numpy array of dtype complex128 of shape (2^n, 2^n) into a Clifford object, comparing the entries in double precision");
+        m.def("is_clifford_matrix", [](const py::array_t<std::complex<double>> &matrix) { return is_clifford_matrix(double_matrix_rows(matrix)); },
+            py::arg("matrix").noconvert(), "Tests whether a numpy array of dtype complex128 corresponds to a Clifford, comparing the entries in double precision");
+        m.def("clifford_from_matrix", py::overload_cast<const std::vector<std::vector<std::complex<float>>> &, const bool>(&clifford_from_matrix), py::arg("matrix"), py::arg("assume_valid") = false, "Converts a 2^n by 2^n matrix with complex entries into a Clifford object. Assuming valid is faster, but will result in undefined behaviour if the matrix is not in fact a valid Clifford operator");
+        m.def("clifford_from_matrix", py::overload_cast<const Monomial_Matrix &, const bool>(&clifford_from_matrix), py::arg("matrix"), py::arg("assume_valid") = false, "Converts a Monomial_Matrix (e.g. of a circuit of X, CNOT, SWAP, S and CZ gates) into a Clifford object, without forming the dense matrix");
+        m.def("is_clifford_matrix", py::overload_cast<const std::vector<std::vector<std::complex<float>>> &>(&is_clifford_matrix), py::arg("matrix"), "Tests whether a matrix with complex entries corresponds to a Clifford");
+        m.def("is_clifford_matrix", py::overload_cast<const Monomial_Matrix &>(&is_clifford_matrix), py::arg("matrix"), "Tests whether a Monomial_Matrix corresponds to a Clifford");
     }
 }
 
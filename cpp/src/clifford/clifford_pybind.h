@@ -3,9 +3,16 @@
 
 #include <pybind11/pybind11.h>
 #include <pybind11/complex.h>
+#include <pybind11/numpy.h>
 #include <pybind11/stl.h>
 
+#include <optional>
+#include <span>
+#include <stdexcept>
+
 #include "clifford.h"
+#include "pauli/packed_paulis_pybind.h"
+#include "serialisation/pickle_pybind.h"
 
 namespace py = pybind11;
 using namespace fst;
@@ -20,7 +27,50 @@ namespace fst_pybind
             .def_readwrite("x_conjugates", &Clifford::x_conjugates, "list[Pauli]")
             .def_readwrite("global_phase", &Clifford::global_phase, "complex")
             .def(py::init<const std::vector<Pauli>, const std::vector<Pauli>, const std::complex<float>>(), py::arg("z_conjugates"), py::arg("x_conjugates"), py::arg("global_phase") = 1.0f)
+            .def_static("from_numpy", [](const py::array &x2x, const py::array &x2z, const py::array &z2x, const py::array &z2z, const std::optional<py::array> &x_signs,
+                    const std::optional<py::array> &z_signs, const bool validate)
+                {
+                    const std::size_t number_qubits = number_rows(x2x);
+
+                    if (validate)
+                    {
+                        const Packed_Array packed_x2x = packed_array(x2x), packed_x2z = packed_array(x2z), packed_z2x = packed_array(z2x), packed_z2z = packed_array(z2z);
+
+                        if (!is_symplectic(number_qubits, packed_bytes(packed_x2x), packed_bytes(packed_x2z), packed_bytes(packed_z2x), packed_bytes(packed_z2z)))
+                        {
+                            throw std::invalid_argument("The tableau is not symplectic.");
+                        }
+                    }
+
+                    return Clifford(paulis_from_numpy(number_qubits, z2x, z2z, z_signs), paulis_from_numpy(number_qubits, x2x, x2z, x_signs));
+                },
+                py::arg("x2x"), py::arg("x2z"), py::arg("z2x"), py::arg("z2z"), py::arg("x_signs") = py::none(), py::arg("z_signs") = py::none(), py::arg("validate") = false,
+                "Returns the Clifford (with global phase 1) of the tableau in the format of stim's Tableau.from_numpy: row i of x2x and x2z has the x and z bits of UX_iU*, and likewise for z2x and z2z, with the signs of the conjugates in x_signs and z_signs. The arrays have dtype bool, or uint8 for bits packed as by numpy.packbits(bitorder = \"little\"), which are read in place when C-contiguous. With validate, throws unless the tableau is symplectic")
+            .def("to_numpy", [](const Clifford &clifford, const bool bit_packed)
+                {
+                    const py::tuple x_conjugates = paulis_to_numpy(clifford.x_conjugates, bit_packed);
+                    const py::tuple z_conjugates = paulis_to_numpy(clifford.z_conjugates, bit_packed);
+
+                    return py::make_tuple(x_conjugates[0], x_conjugates[1], z_conjugates[0], z_conjugates[1], x_conjugates[2], z_conjugates[2]);
+                },
+                py::arg("bit_packed") = false, "Returns the tableau of the Clifford as numpy arrays (x2x, x2z, z2x, z2z, x_signs, z_signs), in the format of stim's Tableau.to_numpy, dropping the global phase")
             .def("get_matrix", &Clifford::get_matrix, "Returns the matrix of the Clifford (with respect to the computational basis)")
+            .def("get_columns", [](const Clifford &clifford, const std::size_t first_column, const std::size_t number_columns)
+                {
+                    const std::size_t size = std::size_t(1) << clifford.number_qubits;
+                    py::array_t<std::complex<float>> columns({static_cast<py::ssize_t>(number_columns), static_cast<py::ssize_t>(size)});
+                    const std::span<std::complex<float>> buffer(columns.mutable_data(), static_cast<std::size_t>(columns.size()));
+
+                    py::gil_scoped_release release;
+                    clifford.get_columns(first_column, buffer);
+
+                    return columns;
+                },
+                py::arg("first_column"), py::arg("number_columns"), "Returns the columns first_column, ..., first_column + number_columns - 1 of the matrix as the rows of a numpy array of dtype complex64, found in parallel without the rest of the matrix")
+            .def("write_matrix", &Clifford::write_matrix, py::arg("path"), py::call_guard<py::gil_scoped_release>(), "Writes the matrix to the file as raw complex64 entries in column-major order, streaming the columns rather than holding the matrix")
+            .def("__eq__", &Clifford::operator==, py::arg("other"), "Returns whether the Cliffords have the same conjugates and (up to a small error) global phase")
+            .def("__hash__", [](const Clifford &clifford) { return std::hash<Clifford>{}(clifford); })
+            .def(get_pickle<Clifford>(&deserialise_clifford))
             .doc() = "The class used to represent a Clifford operator U. Represented by its action on the Pauli basis: z_conjugates[i] = UZ_iU*, x_conjugates[i] = UX_iU*";
     }
 }
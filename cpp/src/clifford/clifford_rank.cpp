@@ -0,0 +1,309 @@
+#include "clifford_rank.h"
+#include "util/f2_helper.h"
+
+#include <algorithm>
+#include <array>
+#include <optional>
+#include <stdexcept>
+#include <utility>
+
+namespace fst
+{
+    namespace
+    {
+        /// Returns rank * radix + digit, for radix and digit below 2^32
+        Clifford_Rank multiply_add(const Clifford_Rank &rank, const std::uint64_t radix, const std::uint64_t digit)
+        {
+            std::array<std::uint64_t, 4> limbs {rank.low & 0xffffffff, rank.low >> 32, rank.high & 0xffffffff, rank.high >> 32};
+            std::uint64_t carry = digit;
+
+            for (std::uint64_t &limb : limbs)
+            {
+                const std::uint64_t product = limb * radix + carry;
+                limb = product & 0xffffffff;
+                carry = product >> 32;
+            }
+
+            if (carry)
+            {
+                throw std::overflow_error("Clifford rank overflow.");
+            }
+
+            return {limbs[2] | (limbs[3] << 32), limbs[0] | (limbs[1] << 32)};
+        }
+
+        /// Divides the rank by radix (below 2^32) in place, returning the remainder
+        std::uint64_t divide(Clifford_Rank &rank, const std::uint64_t radix)
+        {
+            std::array<std::uint64_t, 4> limbs {rank.high >> 32, rank.high & 0xffffffff, rank.low >> 32, rank.low & 0xffffffff};
+            std::uint64_t remainder = 0;
+
+            for (std::uint64_t &limb : limbs)
+            {
+                const std::uint64_t dividend = (remainder << 32) | limb;
+                limb = dividend / radix;
+                remainder = dividend % radix;
+            }
+
+            rank = {(limbs[0] << 32) | limbs[1], (limbs[2] << 32) | limbs[3]};
+
+            return remainder;
+        }
+
+        std::size_t pivot_of(const std::size_t row)
+        {
+            return integral_log_2(row);
+        }
+
+        /// Paulis up to phase are stored as x_vector | z_vector << n
+        struct Symplectic_Space
+        {
+            std::size_t number_qubits;
+
+            std::size_t pack(const Pauli &pauli) const
+            {
+                return pauli.x_vector | (pauli.z_vector << number_qubits);
+            }
+
+            std::size_t x_part(const std::size_t vector) const
+            {
+                return vector & (integral_pow_2(number_qubits) - 1);
+            }
+
+            std::size_t z_part(const std::size_t vector) const
+            {
+                return vector >> number_qubits;
+            }
+
+            bool anticommute(const std::size_t first, const std::size_t second) const
+            {
+                return f2_dot_product(x_part(first), z_part(second)) ^ f2_dot_product(z_part(first), x_part(second));
+            }
+
+            /// Returns the row reduced basis (sorted by pivot) of the symplectic complement of the pairs
+            std::vector<std::size_t> complement_basis(const std::vector<std::size_t> &z_vectors, const std::vector<std::size_t> &x_vectors) const
+            {
+                std::vector<std::size_t> rows;
+
+                for (std::size_t t = 0; t < 2 * number_qubits; t++)
+                {
+                    // v -> v + sum_k <v, x_k> z_k + <v, z_k> x_k projects onto the complement
+                    std::size_t vector = integral_pow_2(t);
+
+                    for (std::size_t k = 0; k < z_vectors.size(); k++)
+                    {
+                        vector ^= z_vectors[k] * anticommute(integral_pow_2(t), x_vectors[k]);
+                        vector ^= x_vectors[k] * anticommute(integral_pow_2(t), z_vectors[k]);
+                    }
+
+                    for (const std::size_t row : rows)
+                    {
+                        if (bit_set_at(vector, pivot_of(row)))
+                        {
+                            vector ^= row;
+                        }
+                    }
+
+                    if (vector == 0)
+                    {
+                        continue;
+                    }
+
+                    for (std::size_t &row : rows)
+                    {
+                        if (bit_set_at(row, pivot_of(vector)))
+                        {
+                            row ^= vector;
+                        }
+                    }
+
+                    rows.push_back(vector);
+                }
+
+                std::sort(rows.begin(), rows.end());
+
+                return rows;
+            }
+        };
+
+        /// Returns the coordinates of a vector in the span of a row reduced basis, or nothing if it is not in the span
+        std::optional<std::size_t> coordinates_in(const std::vector<std::size_t> &basis, const std::size_t vector)
+        {
+            std::size_t coordinates = 0;
+            std::size_t combination = 0;
+
+            for (std::size_t j = 0; j < basis.size(); j++)
+            {
+                if (bit_set_at(vector, pivot_of(basis[j])))
+                {
+                    coordinates |= integral_pow_2(j);
+                    combination ^= basis[j];
+                }
+            }
+
+            if (combination != vector)
+            {
+                return std::nullopt;
+            }
+
+            return coordinates;
+        }
+
+        std::size_t combination_of(const std::vector<std::size_t> &basis, const std::size_t coordinates)
+        {
+            std::size_t vector = 0;
+
+            for (std::size_t j = 0; j < basis.size(); j++)
+            {
+                vector ^= basis[j] * bit_set_at(coordinates, j);
+            }
+
+            return vector;
+        }
+
+        /// The basis vectors anticommuting with z_vector, whose coordinates c have c.mask = 1 for X'
+        std::size_t anticommuting_mask(const Symplectic_Space &space, const std::vector<std::size_t> &basis, const std::size_t z_vector)
+        {
+            std::size_t mask = 0;
+
+            for (std::size_t j = 0; j < basis.size(); j++)
+            {
+                mask |= integral_pow_2(j) * space.anticommute(basis[j], z_vector);
+            }
+
+            return mask;
+        }
+
+        void check_number_qubits(const std::size_t number_qubits)
+        {
+            if (number_qubits > max_clifford_rank_qubits)
+            {
+                throw std::invalid_argument("Cliffords can only be ranked on at most 7 qubits.");
+            }
+        }
+    }
+
+    Clifford_Rank number_cliffords(const std::size_t number_qubits)
+    {
+        check_number_qubits(number_qubits);
+
+        Clifford_Rank order {0, 1};
+
+        for (std::size_t remaining = 1; remaining <= number_qubits; remaining++)
+        {
+            order = multiply_add(order, integral_pow_2(2 * remaining) - 1, 0);
+            order = multiply_add(order, integral_pow_2(2 * remaining - 1), 0);
+            order = multiply_add(order, 4, 0);
+        }
+
+        return order;
+    }
+
+    Clifford_Rank rank_clifford(const Clifford &clifford)
+    {
+        const std::size_t number_qubits = clifford.number_qubits;
+        check_number_qubits(number_qubits);
+
+        const Symplectic_Space space {number_qubits};
+
+        // (radix, digit) pairs, least significant first
+        std::vector<std::pair<std::uint64_t, std::uint64_t>> digits;
+        std::vector<std::size_t> z_vectors;
+        std::vector<std::size_t> x_vectors;
+
+        for (std::size_t i = 0; i < number_qubits; i++)
+        {
+            // The rank only records the sign bits, so would be the same for a conjugate and i times it
+            if (!clifford.z_conjugates[i].is_hermitian() || !clifford.x_conjugates[i].is_hermitian())
+            {
+                throw std::invalid_argument("The conjugates of a Clifford must be Hermitian.");
+            }
+
+            const std::vector<std::size_t> basis = space.complement_basis(z_vectors, x_vectors);
+            const std::size_t z_vector = space.pack(clifford.z_conjugates[i]);
+            const std::size_t x_vector = space.pack(clifford.x_conjugates[i]);
+
+            const std::optional<std::size_t> z_coordinates = coordinates_in(basis, z_vector);
+            const std::optional<std::size_t> x_coordinates = coordinates_in(basis, x_vector);
+
+            if (!z_coordinates || !x_coordinates || z_vector == 0 || !space.anticommute(z_vector, x_vector))
+            {
+                throw std::invalid_argument("The conjugates of the Clifford do not satisfy the Pauli commutation relations.");
+            }
+
+            // X' has c.mask = 1, so its coordinate at the lowest bit of the mask is determined by the others
+            const std::size_t mask = anticommuting_mask(space, basis, z_vector);
+            const std::size_t fixed_bit = mask & (~mask + 1);
+            const std::size_t x_digit = (*x_coordinates & (fixed_bit - 1)) | ((*x_coordinates >> 1) & ~(fixed_bit - 1));
+
+            digits.push_back({integral_pow_2(basis.size()) - 1, *z_coordinates - 1});
+            digits.push_back({integral_pow_2(basis.size() - 1), x_digit});
+
+            z_vectors.push_back(z_vector);
+            x_vectors.push_back(x_vector);
+        }
+
+        for (std::size_t i = 0; i < number_qubits; i++)
+        {
+            digits.push_back({2, clifford.z_conjugates[i].sign_bit});
+            digits.push_back({2, clifford.x_conjugates[i].sign_bit});
+        }
+
+        Clifford_Rank rank;
+
+        for (auto digit = digits.rbegin(); digit != digits.rend(); digit++)
+        {
+            rank = multiply_add(rank, digit->first, digit->second);
+        }
+
+        return rank;
+    }
+
+    Clifford unrank_clifford(const std::size_t number_qubits, Clifford_Rank rank)
+    {
+        check_number_qubits(number_qubits);
+
+        const Symplectic_Space space {number_qubits};
+        std::vector<std::size_t> z_vectors;
+        std::vector<std::size_t> x_vectors;
+
+        for (std::size_t i = 0; i < number_qubits; i++)
+        {
+            const std::vector<std::size_t> basis = space.complement_basis(z_vectors, x_vectors);
+
+            const std::size_t z_vector = combination_of(basis, divide(rank, integral_pow_2(basis.size()) - 1) + 1);
+
+            const std::size_t mask = anticommuting_mask(space, basis, z_vector);
+            const std::size_t fixed_bit = mask & (~mask + 1);
+            const std::size_t x_digit = divide(rank, integral_pow_2(basis.size() - 1));
+            std::size_t x_coordinates = (x_digit & (fixed_bit - 1)) | ((x_digit & ~(fixed_bit - 1)) << 1);
+            x_coordinates |= fixed_bit * (f2_dot_product(x_coordinates, mask) ^ 1);
+
+            z_vectors.push_back(z_vector);
+            x_vectors.push_back(combination_of(basis, x_coordinates));
+        }
+
+        std::vector<Pauli> z_conjugates;
+        std::vector<Pauli> x_conjugates;
+        z_conjugates.reserve(number_qubits);
+        x_conjugates.reserve(number_qubits);
+
+        for (std::size_t i = 0; i < number_qubits; i++)
+        {
+            const std::size_t z_x_part = space.x_part(z_vectors[i]);
+            const std::size_t z_z_part = space.z_part(z_vectors[i]);
+            z_conjugates.emplace_back(number_qubits, z_x_part, z_z_part, divide(rank, 2), f2_dot_product(z_x_part, z_z_part));
+
+            const std::size_t x_x_part = space.x_part(x_vectors[i]);
+            const std::size_t x_z_part = space.z_part(x_vectors[i]);
+            x_conjugates.emplace_back(number_qubits, x_x_part, x_z_part, divide(rank, 2), f2_dot_product(x_x_part, x_z_part));
+        }
+
+        if (rank != Clifford_Rank{})
+        {
+            throw std::invalid_argument("The rank is at least the number of Cliffords.");
+        }
+
+        return Clifford(z_conjugates, x_conjugates);
+    }
+}
@@ -0,0 +1,39 @@
+#ifndef _FAST_STABILISER_CLIFFORD_RANK_H
+#define _FAST_STABILISER_CLIFFORD_RANK_H
+
+#include "clifford.h"
+
+#include <compare>
+#include <cstdint>
+
+namespace fst
+{
+    /// The largest number of qubits for which the Clifford group (up to global phase) can be ranked into 128 bits
+    constexpr std::size_t max_clifford_rank_qubits = 7;
+
+    /// A 128 bit unsigned integer, high * 2^64 + low, used as the rank of a Clifford
+    struct Clifford_Rank
+    {
+        std::uint64_t high = 0;
+        std::uint64_t low = 0;
+
+        auto operator<=>(const Clifford_Rank &other) const = default;
+    };
+
+    /// Returns the order of the Clifford group on the given number of qubits, up to global phase, i.e. 4^n times the
+    /// order of the symplectic group Sp(2n, F_2)
+    Clifford_Rank number_cliffords(const std::size_t number_qubits);
+
+    /// Returns the rank of the Clifford (up to global phase), a unique integer in [0, number_cliffords(n)).
+    ///
+    /// The pairs (UZ_iU*, UX_iU*) are ranked in turn, by their coordinates in the (row reduced basis of the)
+    /// symplectic complement of the previous pairs, followed by the signs of the conjugates. Throws
+    /// std::invalid_argument for more than max_clifford_rank_qubits qubits, or if the conjugates are not Hermitian or
+    /// do not have the commutation relations of a Clifford.
+    Clifford_Rank rank_clifford(const Clifford &clifford);
+
+    /// The inverse of rank_clifford, returning the Clifford with the given rank and global phase 1
+    Clifford unrank_clifford(const std::size_t number_qubits, Clifford_Rank rank);
+}
+
+#endif
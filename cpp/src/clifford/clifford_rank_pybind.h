@@ -0,0 +1,78 @@
+#ifndef _FAST_STABILISER_CLIFFORD_RANK_PYBIND_H
+#define _FAST_STABILISER_CLIFFORD_RANK_PYBIND_H
+
+#include <pybind11/pybind11.h>
+#include <pybind11/numpy.h>
+#include <pybind11/stl.h>
+
+#include "clifford_rank.h"
+
+namespace py = pybind11;
+using namespace fst;
+
+namespace fst_pybind
+{
+    py::int_ rank_to_int(const Clifford_Rank &rank)
+    {
+        return (py::int_(rank.high) << py::int_(64)) | py::int_(rank.low);
+    }
+
+    Clifford_Rank rank_from_int(const py::int_ &rank)
+    {
+        if (rank < py::int_(0) || rank >= (py::int_(1) << py::int_(128)))
+        {
+            throw std::invalid_argument("The rank must be a non-negative integer below 2^128.");
+        }
+
+        return {(rank >> py::int_(64)).cast<std::uint64_t>(), (rank & py::int_(0xffffffffffffffff)).cast<std::uint64_t>()};
+    }
+
+    void init_clifford_rank(py::module_ &m)
+    {
+        m.attr("max_clifford_rank_qubits") = max_clifford_rank_qubits;
+
+        m.def("number_cliffords", [](const std::size_t number_qubits) { return rank_to_int(number_cliffords(number_qubits)); },
+            py::arg("number_qubits"), "Returns the order of the clifford group on the given number of qubits, up to global phase");
+        m.def("rank_clifford", [](const Clifford &clifford) { return rank_to_int(rank_clifford(clifford)); },
+            py::arg("clifford"), "Returns the rank of the clifford (up to global phase), a unique integer in [0, number_cliffords(n))");
+        m.def("unrank_clifford", [](const std::size_t number_qubits, const py::int_ &rank) { return unrank_clifford(number_qubits, rank_from_int(rank)); },
+            py::arg("number_qubits"), py::arg("rank"), "Returns the clifford with the given rank");
+
+        m.def("rank_cliffords", [](const std::vector<Clifford> &cliffords)
+            {
+                py::array_t<std::uint64_t> ranks({static_cast<py::ssize_t>(cliffords.size()), py::ssize_t(2)});
+                std::uint64_t *data = ranks.mutable_data();
+
+                for (std::size_t i = 0; i < cliffords.size(); i++)
+                {
+                    const Clifford_Rank rank = rank_clifford(cliffords[i]);
+                    data[2 * i] = rank.high;
+                    data[2 * i + 1] = rank.low;
+                }
+
+                return ranks;
+            },
+            py::arg("cliffords"), "Returns the ranks of a list of cliffords as a numpy array of dtype uint64 and shape (count, 2), each row holding the high and low 64 bits of a rank");
+
+        m.def("unrank_cliffords", [](const std::size_t number_qubits, py::array_t<std::uint64_t, py::array::c_style | py::array::forcecast> ranks)
+            {
+                if (ranks.ndim() != 2 || ranks.shape(1) != 2)
+                {
+                    throw std::invalid_argument("The ranks must have shape (count, 2).");
+                }
+
+                std::vector<Clifford> cliffords;
+                cliffords.reserve(ranks.shape(0));
+
+                for (py::ssize_t i = 0; i < ranks.shape(0); i++)
+                {
+                    cliffords.push_back(unrank_clifford(number_qubits, {ranks.at(i, 0), ranks.at(i, 1)}));
+                }
+
+                return cliffords;
+            },
+            py::arg("number_qubits"), py::arg("ranks"), "Returns the list of cliffords with the given ranks, given as a numpy array of shape (count, 2) as returned by rank_cliffords");
+    }
+}
+
+#endif
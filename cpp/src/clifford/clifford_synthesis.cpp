@@ -0,0 +1,250 @@
+#include "clifford_synthesis.h"
+#include "util/f2_helper.h"
+
+#include <bit>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace fst
+{
+    namespace
+    {
+        /// A Hermitian pauli (-1)^sign P_1 ... P_n, where P_q is I, X, Y or Z as the bits (x_q, z_q) are 00, 10, 11 or 01,
+        /// as in the rows of Tableau
+        struct Tableau_Row
+        {
+            std::size_t x_vector;
+            std::size_t z_vector;
+            bool sign;
+        };
+
+        Tableau_Row tableau_row(const Pauli &pauli)
+        {
+            if (!pauli.is_hermitian())
+            {
+                throw std::invalid_argument("The conjugates of a Clifford must be Hermitian.");
+            }
+
+            const bool sign = ((pauli.get_phase_exponent() - 2 * std::popcount(pauli.x_vector & pauli.z_vector)) & 7) == 4;
+            return {pauli.x_vector, pauli.z_vector, sign};
+        }
+
+        /// The conjugates of the X_i (the first n rows) and Z_i (the last n rows) under the gates applied so far, after the
+        /// Clifford, and those gates
+        struct Synthesis
+        {
+            std::size_t number_qubits;
+            std::vector<Tableau_Row> rows;
+            Circuit circuit;
+
+            Tableau_Row &x_row(const std::size_t qubit)
+            {
+                return rows[qubit];
+            }
+
+            Tableau_Row &z_row(const std::size_t qubit)
+            {
+                return rows[number_qubits + qubit];
+            }
+
+            /// Conjugates each row by the gate, with the updates of Aaronson & Gottesman
+            void apply(const Gate gate, const std::size_t first_qubit, const std::size_t second_qubit = 0)
+            {
+                const std::size_t a = integral_pow_2(first_qubit);
+                const std::size_t b = integral_pow_2(second_qubit);
+
+                for (Tableau_Row &row : rows)
+                {
+                    const bool x_a = row.x_vector & a;
+                    const bool z_a = row.z_vector & a;
+                    const bool x_b = row.x_vector & b;
+                    const bool z_b = row.z_vector & b;
+
+                    switch (gate)
+                    {
+                        case Gate::h:
+                            row.sign ^= x_a && z_a;
+                            row.x_vector ^= a * (x_a ^ z_a);
+                            row.z_vector ^= a * (x_a ^ z_a);
+                            break;
+                        case Gate::s:
+                            row.sign ^= x_a && z_a;
+                            row.z_vector ^= a * x_a;
+                            break;
+                        case Gate::s_dagger:
+                            row.sign ^= x_a && !z_a;
+                            row.z_vector ^= a * x_a;
+                            break;
+                        case Gate::x:
+                            row.sign ^= z_a;
+                            break;
+                        case Gate::z:
+                            row.sign ^= x_a;
+                            break;
+                        case Gate::cnot:
+                            row.sign ^= x_a && z_b && !(x_b ^ z_a);
+                            row.x_vector ^= b * x_a;
+                            row.z_vector ^= a * z_b;
+                            break;
+                        case Gate::cz:
+                            row.sign ^= x_a && x_b && (z_a ^ z_b);
+                            row.z_vector ^= a * x_b;
+                            row.z_vector ^= b * x_a;
+                            break;
+                        case Gate::swap:
+                            row.x_vector ^= (a | b) * (x_a ^ x_b);
+                            row.z_vector ^= (a | b) * (z_a ^ z_b);
+                            break;
+                        default:
+                            throw std::invalid_argument("Only the unitary gates H, S, S_DAG, X, Z, CNOT, CZ and SWAP are synthesised.");
+                    }
+                }
+
+                if (is_two_qubit_gate(gate))
+                {
+                    circuit.append(gate, first_qubit, second_qubit);
+                }
+                else
+                {
+                    circuit.append(gate, first_qubit);
+                }
+            }
+
+            /// Reduces the conjugate of X_i to +-X_i, assuming the rows of the previous qubits are already reduced, so
+            /// that it acts as the identity on them
+            void reduce_x_row(const std::size_t qubit)
+            {
+                const std::size_t later_qubits = (~std::size_t(0) << qubit) << 1;
+
+                if (!bit_set_at(x_row(qubit).x_vector, qubit))
+                {
+                    const std::size_t x_bits = x_row(qubit).x_vector & later_qubits;
+
+                    if (x_bits != 0)
+                    {
+                        apply(Gate::swap, qubit, std::countr_zero(x_bits));
+                    }
+                    else
+                    {
+                        // The row is not the identity, so it has a Z or Y on one of the remaining qubits
+                        const std::size_t other_qubit = std::countr_zero(x_row(qubit).z_vector >> qubit) + qubit;
+                        apply(Gate::h, other_qubit);
+
+                        if (other_qubit != qubit)
+                        {
+                            apply(Gate::swap, qubit, other_qubit);
+                        }
+                    }
+                }
+
+                for (std::size_t x_bits = x_row(qubit).x_vector & later_qubits; x_bits != 0; x_bits &= x_bits - 1)
+                {
+                    apply(Gate::cnot, qubit, std::countr_zero(x_bits));
+                }
+
+                for (std::size_t z_bits = x_row(qubit).z_vector & later_qubits; z_bits != 0; z_bits &= z_bits - 1)
+                {
+                    apply(Gate::cz, qubit, std::countr_zero(z_bits));
+                }
+
+                if (bit_set_at(x_row(qubit).z_vector, qubit))
+                {
+                    apply(Gate::s, qubit);
+                }
+            }
+
+            /// Reduces the conjugate of Z_i to +-Z_i, after reduce_x_row, with gates that fix X_i. The row anticommutes
+            /// with X_i and commutes with the rows of the previous qubits, so it has a Z or Y on qubit i and acts as the
+            /// identity on the previous qubits.
+            void reduce_z_row(const std::size_t qubit)
+            {
+                const std::size_t later_qubits = (~std::size_t(0) << qubit) << 1;
+
+                for (std::size_t x_bits = z_row(qubit).x_vector & later_qubits; x_bits != 0; x_bits &= x_bits - 1)
+                {
+                    const std::size_t other_qubit = std::countr_zero(x_bits);
+
+                    if (bit_set_at(z_row(qubit).z_vector, other_qubit))
+                    {
+                        apply(Gate::s, other_qubit);
+                    }
+
+                    apply(Gate::h, other_qubit);
+                }
+
+                for (std::size_t z_bits = z_row(qubit).z_vector & later_qubits; z_bits != 0; z_bits &= z_bits - 1)
+                {
+                    apply(Gate::cnot, std::countr_zero(z_bits), qubit);
+                }
+
+                // H S H fixes X and takes Y to Z
+                if (bit_set_at(z_row(qubit).x_vector, qubit))
+                {
+                    apply(Gate::h, qubit);
+                    apply(Gate::s, qubit);
+                    apply(Gate::h, qubit);
+                }
+            }
+        };
+
+        Gate inverse_gate(const Gate gate)
+        {
+            switch (gate)
+            {
+                case Gate::s: return Gate::s_dagger;
+                case Gate::s_dagger: return Gate::s;
+                default: return gate;
+            }
+        }
+    }
+
+    Circuit synthesise_circuit(const Clifford &clifford, const bool cancel_gates)
+    {
+        const std::size_t number_qubits = clifford.number_qubits;
+
+        Synthesis synthesis {number_qubits, {}, Circuit(number_qubits)};
+        synthesis.rows.reserve(2 * number_qubits);
+
+        for (const Pauli &pauli : clifford.x_conjugates)
+        {
+            synthesis.rows.push_back(tableau_row(pauli));
+        }
+
+        for (const Pauli &pauli : clifford.z_conjugates)
+        {
+            synthesis.rows.push_back(tableau_row(pauli));
+        }
+
+        for (std::size_t qubit = 0; qubit < number_qubits; qubit++)
+        {
+            synthesis.reduce_x_row(qubit);
+            synthesis.reduce_z_row(qubit);
+        }
+
+        // Z flips the sign of X and commutes with Z, and vice versa
+        for (std::size_t qubit = 0; qubit < number_qubits; qubit++)
+        {
+            if (synthesis.x_row(qubit).sign)
+            {
+                synthesis.apply(Gate::z, qubit);
+            }
+
+            if (synthesis.z_row(qubit).sign)
+            {
+                synthesis.apply(Gate::x, qubit);
+            }
+        }
+
+        // The gates G applied so far give G U = I up to phase, so U is their inverse
+        Circuit circuit(number_qubits);
+        circuit.operations.reserve(synthesis.circuit.operations.size());
+
+        for (auto operation = synthesis.circuit.operations.rbegin(); operation != synthesis.circuit.operations.rend(); operation++)
+        {
+            circuit.operations.push_back({inverse_gate(operation->gate), operation->first_qubit, operation->second_qubit, 0});
+        }
+
+        return cancel_gates ? cancel_inverse_gates(circuit) : circuit;
+    }
+}
@@ -0,0 +1,21 @@
+#ifndef _FAST_STABILISER_CLIFFORD_SYNTHESIS_H
+#define _FAST_STABILISER_CLIFFORD_SYNTHESIS_H
+
+#include "clifford.h"
+#include "simulation/circuit.h"
+
+namespace fst
+{
+    /// Returns a circuit of H, S, S_DAG, X, Z, CNOT, CZ and SWAP gates implementing the Clifford up to global phase,
+    /// in O(n^3) time, without its matrix.
+    ///
+    /// As in Aaronson & Gottesman, gates are applied to the tableau until it is the identity: for each qubit i in
+    /// turn, the conjugate of X_i is reduced to X_i (up to sign) by a swap, Hadamards and CNOT and CZ gates from
+    /// qubit i, and then that of Z_i to Z_i by gates fixing X_i. The signs are fixed by paulis, and the circuit is
+    /// the inverse of the gates applied. With cancel_gates, adjacent inverse gates are then removed by
+    /// cancel_inverse_gates, which mostly saves Hadamards and phase gates. The reduction of each qubit uses at most
+    /// 2(n - i - 1) two qubit gates.
+    Circuit synthesise_circuit(const Clifford &clifford, const bool cancel_gates = true);
+}
+
+#endif
@@ -0,0 +1,20 @@
+#ifndef _FAST_STABILISER_CLIFFORD_SYNTHESIS_PYBIND_H
+#define _FAST_STABILISER_CLIFFORD_SYNTHESIS_PYBIND_H
+
+#include <pybind11/pybind11.h>
+
+#include "clifford_synthesis.h"
+
+namespace py = pybind11;
+using namespace fst;
+
+namespace fst_pybind
+{
+    void init_clifford_synthesis(py::module_ &m)
+    {
+        m.def("synthesise_circuit", &synthesise_circuit, py::arg("clifford"), py::arg("cancel_gates") = true,
+            "Returns a Circuit of H, S, S_DAG, X, Z, CNOT, CZ and SWAP gates implementing the Clifford up to global phase, found from its tableau in O(n^3) time. With cancel_gates, adjacent inverse gates are removed");
+    }
+}
+
+#endif
@@ -0,0 +1,149 @@
+#ifndef _FAST_STABILISER_FIXED_CLIFFORD_H
+#define _FAST_STABILISER_FIXED_CLIFFORD_H
+
+#include "clifford.h"
+#include "pauli/pauli_kernels.h"
+#include "stabiliser_state/check_matrix.h"
+#include "stabiliser_state/fixed_stabiliser_state.h"
+#include "util/f2_helper.h"
+#include "util/fixed_size.h"
+#include "util/phase.h"
+#include "util/scratch_arena.h"
+#include "util/stats.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <complex>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace fst
+{
+    /// Multiplies the first column of a Clifford's matrix, built as the state vector of its z conjugates on a support of
+    /// dimension dim, by the phase giving its first non-zero entry the Clifford's global phase (as for states from
+    /// statevectors). Throws std::invalid_argument if there is no such entry a multiple of pi/4 away from the global
+    /// phase, which happens for a zero global phase.
+    inline void correct_first_column_phase(const std::span<std::complex<float>> first_col, const std::size_t dim, const std::complex<float> global_phase)
+    {
+        const auto first_non_zero_entry = std::ranges::find_if(first_col, [](const std::complex<float> entry) { return entry != .0f; });
+        const std::optional<Phase_Exponent> phase_exponent = first_non_zero_entry == first_col.end()
+            ? std::nullopt
+            : quarter_phase_exponent(*first_non_zero_entry * float(std::sqrt(integral_pow_2(dim))) / global_phase);
+
+        if (!phase_exponent.has_value())
+        {
+            throw std::invalid_argument("The first column of the Clifford has no entry with the phase of its global phase, which must be non-zero.");
+        }
+
+        const Phase_Exponent phase_correction = 8 - *phase_exponent;
+
+        for (std::complex<float> &entry : first_col)
+        {
+            entry = multiply_by_phase(entry, phase_correction);
+        }
+    }
+
+    /// A Clifford operator on a number of qubits N fixed at compile time, stored as its tableau like Clifford but
+    /// with the conjugates in std::arrays: z_conjugates[i] = UZ_iU*, x_conjugates[i] = UX_iU*
+    template <std::size_t N>
+    struct Fixed_Clifford
+    {
+        static_assert(N <= max_fixed_qubits, "Fixed size Cliffords are only instantiated for small N");
+
+        static constexpr std::size_t number_qubits = N;
+        static constexpr std::size_t matrix_size = integral_pow_2(N);
+
+        std::array<Pauli, N> z_conjugates {};
+        std::array<Pauli, N> x_conjugates {};
+
+        std::complex<float> global_phase = 1.0f;
+
+        Fixed_Clifford() = default;
+
+        /// Copies a Clifford on N qubits, throwing std::invalid_argument for any other number of qubits
+        explicit Fixed_Clifford(const Clifford &clifford)
+            : global_phase(clifford.global_phase)
+        {
+            if (clifford.number_qubits != N || clifford.z_conjugates.size() != N || clifford.x_conjugates.size() != N)
+            {
+                throw std::invalid_argument("The Clifford is on a different number of qubits.");
+            }
+
+            for (std::size_t i = 0; i < N; i++)
+            {
+                z_conjugates[i] = clifford.z_conjugates[i];
+                x_conjugates[i] = clifford.x_conjugates[i];
+            }
+        }
+
+        Clifford to_clifford(const Clifford::allocator_type &allocator = {}) const
+        {
+            return Clifford(z_conjugates, x_conjugates, global_phase, allocator);
+        }
+
+        /// Writes the columns of the matrix of the Clifford (with respect to the computational basis) one after another
+        /// into columns, visiting them in Gray code order so that each column is one Pauli away from the previous one.
+        /// The first column is found in the thread's scratch arena, so this does not allocate once the arena has grown.
+        void write_columns(const std::span<std::complex<float>, matrix_size * matrix_size> columns) const
+        {
+            const std::span<std::complex<float>, matrix_size> first_col = columns.template first<matrix_size>();
+
+            const Scratch_Scope scope(thread_scratch_arena());
+            Check_Matrix first_col_check_matrix(z_conjugates, false, &thread_scratch_arena());
+            Fixed_Stabiliser_State<N> state {Stabiliser_State(first_col_check_matrix, &thread_scratch_arena())};
+            state.global_phase = global_phase;
+            state.write_state_vector(first_col);
+
+            correct_first_column_phase(first_col, state.dim, global_phase);
+
+            std::size_t old_col_index = 0;
+            FST_COUNT(gray_code_steps, matrix_size - 1);
+
+            for (std::size_t i = 1; i < matrix_size; i++)
+            {
+                // Iterate through the Gray code
+                const std::size_t new_col_index = i ^ (i >> 1);
+                const Pauli &x_conjugate = x_conjugates[std::countr_zero(i)];
+
+                apply_pauli_action({x_conjugate.x_vector, x_conjugate.z_vector, x_conjugate.get_phase_exponent()},
+                    columns.data() + old_col_index * matrix_size, columns.data() + new_col_index * matrix_size, matrix_size);
+
+                old_col_index = new_col_index;
+            }
+        }
+
+        /// Returns the matrix of the Clifford (with respect to the computational basis). The columns are built in a
+        /// temporary on the heap (not the scratch arena) as large as the matrix, so Clifford::get_matrix only uses this
+        /// for small N.
+        std::vector<std::vector<std::complex<float>>> get_matrix() const
+        {
+            std::vector<std::complex<float>> columns(matrix_size * matrix_size);
+            FST_COUNT(bytes_allocated, 2 * matrix_size * matrix_size * sizeof(std::complex<float>));
+            write_columns(std::span<std::complex<float>, matrix_size * matrix_size>(columns));
+
+            std::vector<std::vector<std::complex<float>>> matrix(matrix_size, std::vector<std::complex<float>>(matrix_size));
+
+            for (std::size_t i = 0; i < matrix_size; i++)
+            {
+                for (std::size_t j = 0; j < matrix_size; j++)
+                {
+                    matrix[i][j] = columns[j * matrix_size + i];
+                }
+            }
+
+            return matrix;
+        }
+
+        bool operator==(const Fixed_Clifford &other) const
+        {
+            return z_conjugates == other.z_conjugates && x_conjugates == other.x_conjugates
+                && std::norm(global_phase - other.global_phase) < 0.001;
+        }
+    };
+}
+
+#endif
@@ -0,0 +1,63 @@
+#include "random_clifford.h"
+#include "pauli/random_pauli.h"
+
+namespace fst
+{
+    Clifford random_clifford(const std::size_t number_qubits, Random_Generator &generator)
+    {
+        auto [z_conjugates, x_conjugates] = random_symplectic_paulis(number_qubits, generator);
+        return Clifford(z_conjugates, x_conjugates);
+    }
+
+    std::vector<Clifford> random_cliffords(const std::size_t number_qubits, const std::size_t count, Random_Generator &generator)
+    {
+        std::vector<Clifford> cliffords;
+        cliffords.reserve(count);
+
+        for (std::size_t i = 0; i < count; i++)
+        {
+            cliffords.push_back(random_clifford(number_qubits, generator));
+        }
+
+        return cliffords;
+    }
+
+    void perturb_matrix(std::vector<std::vector<std::complex<float>>> &matrix, Random_Generator &generator)
+    {
+        const std::size_t size = matrix.size();
+        const std::size_t col_index = generator.random_below(size);
+
+        if (generator.random_bit())
+        {
+            for (std::vector<std::complex<float>> &row : matrix)
+            {
+                row[col_index] *= std::complex<float>(0, 1);
+            }
+
+            return;
+        }
+
+        std::complex<float> &entry = matrix[generator.random_below(size)][col_index];
+
+        if (entry == .0f)
+        {
+            entry = 1;
+        }
+        else if (generator.random_bit())
+        {
+            entry *= std::complex<float>(0, 1);
+        }
+        else
+        {
+            entry = 0;
+        }
+    }
+
+    std::vector<std::vector<std::complex<float>>> random_almost_clifford_matrix(const std::size_t number_qubits, Random_Generator &generator)
+    {
+        std::vector<std::vector<std::complex<float>>> matrix = random_clifford(number_qubits, generator).get_matrix();
+        perturb_matrix(matrix, generator);
+
+        return matrix;
+    }
+}
@@ -0,0 +1,28 @@
+#ifndef _FAST_STABILISER_RANDOM_CLIFFORD_H
+#define _FAST_STABILISER_RANDOM_CLIFFORD_H
+
+#include "clifford.h"
+#include "util/random.h"
+
+#include <complex>
+#include <vector>
+
+namespace fst
+{
+    /// Returns a uniformly random Clifford on the given number of qubits (up to global phase, which is 1), in
+    /// O(n^2) time for up to 64 qubits
+    Clifford random_clifford(const std::size_t number_qubits, Random_Generator &generator);
+
+    /// Returns count independent uniformly random Cliffords
+    std::vector<Clifford> random_cliffords(const std::size_t number_qubits, const std::size_t count, Random_Generator &generator);
+
+    /// Modifies a random entry of the matrix, or multiplies a random column by i (each with probability 1/2).
+    /// A non-zero entry is multiplied by i or set to zero, and a zero entry is set to one.
+    void perturb_matrix(std::vector<std::vector<std::complex<float>>> &matrix, Random_Generator &generator);
+
+    /// Returns the matrix of a uniformly random Clifford, perturbed by perturb_matrix. This is almost never a
+    /// Clifford, so is a hard case for is_clifford_matrix
+    std::vector<std::vector<std::complex<float>>> random_almost_clifford_matrix(const std::size_t number_qubits, Random_Generator &generator);
+}
+
+#endif
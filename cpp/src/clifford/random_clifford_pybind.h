@@ -0,0 +1,23 @@
+#ifndef _FAST_STABILISER_RANDOM_CLIFFORD_PYBIND_H
+#define _FAST_STABILISER_RANDOM_CLIFFORD_PYBIND_H
+
+#include <pybind11/pybind11.h>
+#include <pybind11/complex.h>
+#include <pybind11/stl.h>
+
+#include "random_clifford.h"
+
+namespace py = pybind11;
+using namespace fst;
+
+namespace fst_pybind
+{
+    void init_random_clifford(py::module_ &m)
+    {
+        m.def("random_clifford", &random_clifford, py::arg("number_qubits"), py::arg("generator"), "Returns a uniformly random clifford with global phase 1");
+        m.def("random_cliffords", &random_cliffords, py::arg("number_qubits"), py::arg("count"), py::arg("generator"), "Returns a list of count independent uniformly random cliffords");
+        m.def("random_almost_clifford_matrix", &random_almost_clifford_matrix, py::arg("number_qubits"), py::arg("generator"), "Returns the matrix of a uniformly random clifford with either a random entry modified or a random column multiplied by i");
+    }
+}
+
+#endif
@@ -0,0 +1,128 @@
+#include "monomial_matrix.h"
+
+#include <stdexcept>
+#include <utility>
+
+namespace fst
+{
+    Monomial_Matrix::Monomial_Matrix(std::vector<std::size_t> rows, std::vector<std::complex<float>> entries)
+        : rows(std::move(rows)), entries(std::move(entries))
+    {
+        if (this->rows.size() != this->entries.size())
+        {
+            throw std::invalid_argument("A monomial matrix needs exactly one entry per column");
+        }
+
+        std::vector<bool> row_used(this->rows.size(), false);
+
+        for (const std::size_t row : this->rows)
+        {
+            if (row >= this->rows.size() || row_used[row])
+            {
+                throw std::invalid_argument("The rows of a monomial matrix must be a permutation of its columns");
+            }
+
+            row_used[row] = true;
+        }
+    }
+
+    std::size_t Monomial_Matrix::size() const
+    {
+        return rows.size();
+    }
+
+    std::complex<float> Monomial_Matrix::at(const std::size_t row, const std::size_t column) const
+    {
+        return rows.at(column) == row ? entries[column] : 0;
+    }
+
+    std::vector<std::complex<float>> Monomial_Matrix::multiply_vector(const std::vector<std::complex<float>> &vector) const
+    {
+        if (vector.size() != size())
+        {
+            throw std::invalid_argument("Invalid vector dimension for matrix-vector multiplication");
+        }
+
+        std::vector<std::complex<float>> result(size());
+
+        for (std::size_t column = 0; column < size(); column++)
+        {
+            result[rows[column]] = entries[column] * vector[column];
+        }
+
+        return result;
+    }
+
+    Monomial_Matrix Monomial_Matrix::operator*(const Monomial_Matrix &other) const
+    {
+        if (other.size() != size())
+        {
+            throw std::invalid_argument("Monomial matrices have different sizes");
+        }
+
+        Monomial_Matrix product;
+        product.rows.resize(size());
+        product.entries.resize(size());
+
+        // Column col of the product is this matrix applied to column col of other, a multiple of a basis vector
+        for (std::size_t column = 0; column < size(); column++)
+        {
+            const std::size_t middle_index = other.rows[column];
+            product.rows[column] = rows[middle_index];
+            product.entries[column] = entries[middle_index] * other.entries[column];
+        }
+
+        return product;
+    }
+
+    Monomial_Matrix Monomial_Matrix::adjoint() const
+    {
+        Monomial_Matrix result;
+        result.rows.resize(size());
+        result.entries.resize(size());
+
+        for (std::size_t column = 0; column < size(); column++)
+        {
+            result.rows[rows[column]] = column;
+            result.entries[rows[column]] = std::conj(entries[column]);
+        }
+
+        return result;
+    }
+
+    std::vector<std::vector<std::complex<float>>> Monomial_Matrix::get_matrix() const
+    {
+        std::vector<std::vector<std::complex<float>>> matrix(size(), std::vector<std::complex<float>>(size(), 0));
+
+        for (std::size_t column = 0; column < size(); column++)
+        {
+            matrix[rows[column]][column] = entries[column];
+        }
+
+        return matrix;
+    }
+
+    Csr_Matrix Monomial_Matrix::get_csr_matrix() const
+    {
+        Csr_Matrix csr_matrix;
+        csr_matrix.number_rows = size();
+        csr_matrix.number_columns = size();
+        csr_matrix.row_offsets.resize(size() + 1);
+        csr_matrix.column_indices.resize(size());
+        csr_matrix.values.resize(size());
+
+        // Each row has a single entry, so row r is stored at index r
+        for (std::size_t column = 0; column < size(); column++)
+        {
+            csr_matrix.column_indices[rows[column]] = column;
+            csr_matrix.values[rows[column]] = entries[column];
+        }
+
+        for (std::size_t row = 0; row <= size(); row++)
+        {
+            csr_matrix.row_offsets[row] = row;
+        }
+
+        return csr_matrix;
+    }
+}
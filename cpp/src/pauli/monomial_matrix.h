@@ -0,0 +1,61 @@
+#ifndef _FAST_STABILISER_MONOMIAL_MATRIX_H
+#define _FAST_STABILISER_MONOMIAL_MATRIX_H
+
+#include <complex>
+#include <cstddef>
+#include <vector>
+
+namespace fst
+{
+    /// A matrix in compressed sparse row format: the non-zero entries of row r are values[k] in column
+    /// column_indices[k], for row_offsets[r] <= k < row_offsets[r+1]. This matches the layout of scipy.sparse.csr_matrix.
+    struct Csr_Matrix
+    {
+        std::size_t number_rows = 0;
+        std::size_t number_columns = 0;
+        std::vector<std::size_t> row_offsets;
+        std::vector<std::size_t> column_indices;
+        std::vector<std::complex<float>> values;
+    };
+
+    /// The class used to represent a square monomial matrix (a permutation matrix with phases), i.e. a matrix with
+    /// exactly one non-zero entry in each row and column. This is stored column by column, as the row and value of
+    /// the non-zero entry of each column, so takes O(2^n) memory rather than O(4^n) for an operator on n qubits.
+    /// For example, a Pauli maps column col to row col ^ x_vector.
+    struct Monomial_Matrix
+    {
+        /// rows[col] is the row of the non-zero entry in column col
+        std::vector<std::size_t> rows;
+
+        /// entries[col] is the value of the non-zero entry in column col
+        std::vector<std::complex<float>> entries;
+
+        Monomial_Matrix() = default;
+        Monomial_Matrix(std::vector<std::size_t> rows, std::vector<std::complex<float>> entries);
+
+        /// The number of rows (and columns) of the matrix
+        std::size_t size() const;
+
+        /// Returns the entry of the matrix at the given row and column
+        std::complex<float> at(const std::size_t row, const std::size_t column) const;
+
+        /// Given a vector x, returns Mx
+        std::vector<std::complex<float>> multiply_vector(const std::vector<std::complex<float>> &vector) const;
+
+        /// Returns the product of this matrix (on the left) with another monomial matrix of the same size
+        Monomial_Matrix operator*(const Monomial_Matrix &other) const;
+
+        /// Returns the conjugate transpose of the matrix. For unitary monomial matrices, this is the inverse
+        Monomial_Matrix adjoint() const;
+
+        /// Returns the dense matrix, indexed by row then column
+        std::vector<std::vector<std::complex<float>>> get_matrix() const;
+
+        /// Returns the matrix in compressed sparse row format
+        Csr_Matrix get_csr_matrix() const;
+
+        bool operator==(const Monomial_Matrix &other) const = default;
+    };
+}
+
+#endif
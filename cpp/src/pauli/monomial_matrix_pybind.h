@@ -0,0 +1,79 @@
+#ifndef _FAST_STABILISER_MONOMIAL_MATRIX_PYBIND_H
+#define _FAST_STABILISER_MONOMIAL_MATRIX_PYBIND_H
+
+#include <pybind11/pybind11.h>
+#include <pybind11/complex.h>
+#include <pybind11/numpy.h>
+#include <pybind11/stl.h>
+
+#include <algorithm>
+#include <cstdint>
+
+#include "monomial_matrix.h"
+
+namespace py = pybind11;
+using namespace fst;
+
+namespace fst_pybind
+{
+    template <typename Result, typename T>
+    py::array_t<Result> to_numpy_array(const std::vector<T> &vector)
+    {
+        py::array_t<Result> array(static_cast<py::ssize_t>(vector.size()));
+        Result *data = array.mutable_data();
+
+        for (std::size_t i = 0; i < vector.size(); i++)
+        {
+            data[i] = static_cast<Result>(vector[i]);
+        }
+
+        return array;
+    }
+
+    /// Returns the (data, indices, indptr) arrays of the matrix in compressed sparse row format, as used by scipy
+    py::tuple get_csr_arrays(const Monomial_Matrix &matrix)
+    {
+        const Csr_Matrix csr_matrix = matrix.get_csr_matrix();
+
+        return py::make_tuple(to_numpy_array<std::complex<float>>(csr_matrix.values),
+            to_numpy_array<std::int64_t>(csr_matrix.column_indices), to_numpy_array<std::int64_t>(csr_matrix.row_offsets));
+    }
+
+    void init_monomial_matrix(py::module_ &m)
+    {
+        py::class_<Monomial_Matrix>(m, "Monomial_Matrix")
+            .def(py::init<std::vector<std::size_t>, std::vector<std::complex<float>>>(), py::arg("rows"), py::arg("entries"))
+            .def_property_readonly("rows", [](const Monomial_Matrix &matrix) { return to_numpy_array<std::uint64_t>(matrix.rows); }, "numpy.ndarray\t\tThe row of the non-zero entry of each column")
+            .def_property_readonly("entries", [](const Monomial_Matrix &matrix) { return to_numpy_array<std::complex<float>>(matrix.entries); }, "numpy.ndarray\t\tThe value of the non-zero entry of each column")
+            .def("size", &Monomial_Matrix::size, "Returns the number of rows (and columns) of the matrix")
+            .def("at", &Monomial_Matrix::at, py::arg("row"), py::arg("column"), "Returns the entry of the matrix at the given row and column")
+            .def("multiply_vector", &Monomial_Matrix::multiply_vector, py::arg("vector"), "Given a vector x, returns Mx")
+            .def("adjoint", &Monomial_Matrix::adjoint, "Returns the conjugate transpose of the matrix")
+            .def("get_matrix", &Monomial_Matrix::get_matrix, "Returns the dense matrix (with respect to the computational basis)")
+            .def("to_dense", [](const Monomial_Matrix &matrix)
+                {
+                    const py::ssize_t size = static_cast<py::ssize_t>(matrix.size());
+                    py::array_t<std::complex<float>> dense({size, size});
+                    std::fill_n(dense.mutable_data(), dense.size(), std::complex<float>(0));
+                    auto entries = dense.mutable_unchecked<2>();
+
+                    for (std::size_t column = 0; column < matrix.size(); column++)
+                    {
+                        entries(static_cast<py::ssize_t>(matrix.rows[column]), static_cast<py::ssize_t>(column)) = matrix.entries[column];
+                    }
+
+                    return dense;
+                }, "Returns the dense matrix as a 2D numpy array of dtype complex64")
+            .def("get_csr_arrays", &get_csr_arrays, "Returns the (data, indices, indptr) arrays of the matrix in compressed sparse row format")
+            .def("to_csr", [](const Monomial_Matrix &matrix)
+                {
+                    const py::object csr_matrix = py::module_::import("scipy.sparse").attr("csr_matrix");
+                    return csr_matrix(get_csr_arrays(matrix), py::make_tuple(matrix.size(), matrix.size()));
+                }, "Returns the matrix as a scipy.sparse.csr_matrix (requires scipy)")
+            .def("__matmul__", &Monomial_Matrix::operator*, py::arg("other"))
+            .def("__eq__", &Monomial_Matrix::operator==, py::arg("other"))
+            .doc() = "The class used to represent a square monomial matrix (a permutation matrix with phases), storing the row and value of the single non-zero entry of each column";
+    }
+}
+
+#endif
@@ -0,0 +1,163 @@
+#include "packed_paulis.h"
+#include "util/bit_kernels.h"
+#include "util/parallel.h"
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstring>
+#include <stdexcept>
+
+namespace fst
+{
+    static_assert(std::endian::native == std::endian::little, "The packed bytes are copied into little-endian words");
+
+    namespace
+    {
+        /// Copies the packed row of number_bits bits into the words, clearing the padding bits
+        void read_row(std::span<const std::uint8_t> bytes, const std::size_t number_bits, std::uint64_t *words)
+        {
+            const std::size_t number_words = (number_bits + 63) / 64;
+
+            std::fill_n(words, number_words, 0);
+            std::memcpy(words, bytes.data(), bytes.size());
+
+            if (number_bits % 64 != 0)
+            {
+                words[number_words - 1] &= (std::uint64_t(1) << (number_bits % 64)) - 1;
+            }
+        }
+
+        void check_size(std::span<const std::uint8_t> bytes, const std::size_t size)
+        {
+            if (bytes.size() != size)
+            {
+                throw std::invalid_argument("The packed arrays must have a row of packed_row_bytes(number_qubits) bytes for each pauli, and a bit for each sign.");
+            }
+        }
+    }
+
+    std::size_t packed_row_bytes(const std::size_t number_bits)
+    {
+        return (number_bits + 7) / 8;
+    }
+
+    std::vector<Pauli> unpack_paulis(const std::size_t number_qubits, std::span<const std::uint8_t> x_bits, std::span<const std::uint8_t> z_bits,
+        std::span<const std::uint8_t> signs)
+    {
+        if (number_qubits > 64)
+        {
+            throw std::invalid_argument("Paulis have at most 64 qubits.");
+        }
+
+        const std::size_t row_bytes = packed_row_bytes(number_qubits);
+        const std::size_t number_paulis = row_bytes == 0 ? 0 : x_bits.size() / row_bytes;
+
+        check_size(x_bits, number_paulis * row_bytes);
+        check_size(z_bits, number_paulis * row_bytes);
+        check_size(signs, packed_row_bytes(number_paulis));
+
+        std::vector<Pauli> paulis;
+        paulis.reserve(number_paulis);
+
+        for (std::size_t i = 0; i < number_paulis; i++)
+        {
+            std::uint64_t x_vector = 0;
+            std::uint64_t z_vector = 0;
+            read_row(x_bits.subspan(i * row_bytes, row_bytes), number_qubits, &x_vector);
+            read_row(z_bits.subspan(i * row_bytes, row_bytes), number_qubits, &z_vector);
+
+            // Y = iXZ, so the phase of the pauli is (-1)^sign i^(number of Ys)
+            Pauli pauli(number_qubits, x_vector, z_vector, 0, 0);
+            pauli.set_phase_exponent(4 * ((signs[i / 8] >> (i % 8)) & 1) + 2 * std::popcount(x_vector & z_vector));
+            paulis.push_back(pauli);
+        }
+
+        return paulis;
+    }
+
+    void pack_paulis(std::span<const Pauli> paulis, std::span<std::uint8_t> x_bits, std::span<std::uint8_t> z_bits, std::span<std::uint8_t> signs)
+    {
+        const std::size_t number_qubits = paulis.empty() ? 0 : paulis.front().number_qubits;
+        const std::size_t row_bytes = packed_row_bytes(number_qubits);
+
+        check_size(x_bits, paulis.size() * row_bytes);
+        check_size(z_bits, paulis.size() * row_bytes);
+        check_size(signs, packed_row_bytes(paulis.size()));
+
+        std::fill(signs.begin(), signs.end(), 0);
+
+        for (std::size_t i = 0; i < paulis.size(); i++)
+        {
+            const Pauli &pauli = paulis[i];
+
+            if (pauli.number_qubits != number_qubits || !pauli.is_hermitian())
+            {
+                throw std::invalid_argument("The paulis must be Hermitian and on the same number of qubits.");
+            }
+
+            const std::uint64_t x_vector = pauli.x_vector;
+            const std::uint64_t z_vector = pauli.z_vector;
+            std::memcpy(x_bits.data() + i * row_bytes, &x_vector, row_bytes);
+            std::memcpy(z_bits.data() + i * row_bytes, &z_vector, row_bytes);
+
+            const bool sign = ((pauli.get_phase_exponent() - 2 * std::popcount(x_vector & z_vector)) & 7) == 4;
+            signs[i / 8] |= std::uint8_t(sign << (i % 8));
+        }
+    }
+
+    bool is_symplectic(const std::size_t number_qubits, std::span<const std::uint8_t> x2x, std::span<const std::uint8_t> x2z,
+        std::span<const std::uint8_t> z2x, std::span<const std::uint8_t> z2z)
+    {
+        const std::size_t row_bytes = packed_row_bytes(number_qubits);
+        const std::size_t row_words = (number_qubits + 63) / 64;
+
+        for (std::span<const std::uint8_t> bits : {x2x, x2z, z2x, z2z})
+        {
+            check_size(bits, number_qubits * row_bytes);
+        }
+
+        // Rows i and n + i are the images of X_i and Z_i, which are the only pairs of rows that anticommute
+        std::vector<std::uint64_t> x_rows(2 * number_qubits * row_words);
+        std::vector<std::uint64_t> z_rows(2 * number_qubits * row_words);
+
+        for (std::size_t i = 0; i < number_qubits; i++)
+        {
+            read_row(x2x.subspan(i * row_bytes, row_bytes), number_qubits, x_rows.data() + i * row_words);
+            read_row(x2z.subspan(i * row_bytes, row_bytes), number_qubits, z_rows.data() + i * row_words);
+            read_row(z2x.subspan(i * row_bytes, row_bytes), number_qubits, x_rows.data() + (number_qubits + i) * row_words);
+            read_row(z2z.subspan(i * row_bytes, row_bytes), number_qubits, z_rows.data() + (number_qubits + i) * row_words);
+        }
+
+        std::atomic<bool> symplectic = true;
+
+        const auto check_row = [&](const std::size_t row)
+        {
+            for (std::size_t other_row = 0; other_row < row && symplectic.load(std::memory_order_relaxed); other_row++)
+            {
+                const std::uint64_t product = and_popcount(x_rows.data() + row * row_words, z_rows.data() + other_row * row_words, row_words)
+                    + and_popcount(z_rows.data() + row * row_words, x_rows.data() + other_row * row_words, row_words);
+
+                if ((product & 1) != (row == other_row + number_qubits))
+                {
+                    symplectic.store(false, std::memory_order_relaxed);
+                }
+            }
+        };
+
+        // Row r is checked against the r rows before it, so pairing rows r and 2n - 1 - r balances the threads, and
+        // each grain has about 2^16 word operations
+        const std::size_t grain_size = std::max<std::size_t>(1, (std::size_t(1) << 16) / (2 * number_qubits * row_words + 1));
+
+        parallel_for(number_qubits, grain_size, [&](const std::size_t begin, const std::size_t end)
+            {
+                for (std::size_t row = begin; row < end; row++)
+                {
+                    check_row(row);
+                    check_row(2 * number_qubits - 1 - row);
+                }
+            });
+
+        return symplectic;
+    }
+}
@@ -0,0 +1,41 @@
+#ifndef _FAST_STABILISER_PACKED_PAULIS_H
+#define _FAST_STABILISER_PACKED_PAULIS_H
+
+#include "pauli.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace fst
+{
+    /// Paulis are packed in the layout of stim's Tableau.to_numpy(bit_packed = True), i.e. of numpy.packbits with
+    /// bitorder = "little". The x bits of m paulis on n qubits are m rows of packed_row_bytes(n) bytes, with qubit q
+    /// of pauli i in bit q % 8 of byte i * packed_row_bytes(n) + q / 8, and likewise for the z bits. The sign of
+    /// pauli i is bit i % 8 of byte i / 8 of the signs. As in stim, a packed pauli is (-1)^sign times the tensor
+    /// product of the I, X, Z and Y = iXZ given by its x and z bits, so is Hermitian.
+
+    /// The number of bytes holding a row of the given number of bits
+    std::size_t packed_row_bytes(const std::size_t number_bits);
+
+    /// Reads the packed paulis on n qubits, as many as there are rows of x bits. The padding bits of the rows are
+    /// ignored. Throws if the arrays have the wrong sizes or there are more than 64 qubits.
+    std::vector<Pauli> unpack_paulis(const std::size_t number_qubits, std::span<const std::uint8_t> x_bits, std::span<const std::uint8_t> z_bits,
+        std::span<const std::uint8_t> signs);
+
+    /// Packs the paulis into the arrays, which must have the sizes above, with the padding bits zero. Throws if a
+    /// pauli is not Hermitian or the arrays have the wrong sizes.
+    void pack_paulis(std::span<const Pauli> paulis, std::span<std::uint8_t> x_bits, std::span<std::uint8_t> z_bits, std::span<std::uint8_t> signs);
+
+    /// Whether the packed tableau on n qubits is symplectic, i.e. the images of the X_i (with their x and z bits in
+    /// row i of x2x and x2z, as in stim) and of the Z_i (in z2x and z2z) have the commutation relations of the X_i
+    /// and Z_i. For the 2n x 2n matrix M over F_2 with these images as its rows, this is M Omega M^T = Omega. The rows
+    /// are copied into words, and each pair of rows takes O(n / 64) word operations with and_popcount, so this takes
+    /// O(n^3 / 64) time for any number of qubits, spread over number_threads() threads. Throws if the arrays have the
+    /// wrong sizes.
+    bool is_symplectic(const std::size_t number_qubits, std::span<const std::uint8_t> x2x, std::span<const std::uint8_t> x2z,
+        std::span<const std::uint8_t> z2x, std::span<const std::uint8_t> z2z);
+}
+
+#endif
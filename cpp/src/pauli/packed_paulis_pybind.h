@@ -0,0 +1,123 @@
+#ifndef _FAST_STABILISER_PACKED_PAULIS_PYBIND_H
+#define _FAST_STABILISER_PACKED_PAULIS_PYBIND_H
+
+#include <pybind11/pybind11.h>
+#include <pybind11/numpy.h>
+#include <pybind11/stl.h>
+
+#include <algorithm>
+#include <optional>
+#include <span>
+#include <stdexcept>
+
+#include "packed_paulis.h"
+
+namespace py = pybind11;
+using namespace fst;
+
+namespace fst_pybind
+{
+    using Packed_Array = py::array_t<std::uint8_t, py::array::c_style>;
+
+    /// Returns the bits, given as a numpy array of dtype bool or already packed as uint8, packed along their last
+    /// axis. C-contiguous uint8 arrays are used in place, through the buffer protocol, rather than copied.
+    Packed_Array packed_array(const py::array &bits)
+    {
+        if (bits.dtype().is(py::dtype::of<bool>()))
+        {
+            return Packed_Array::ensure(py::module_::import("numpy").attr("packbits")(bits, py::arg("axis") = -1, py::arg("bitorder") = "little"));
+        }
+
+        Packed_Array packed = Packed_Array::ensure(bits);
+
+        if (!packed || !bits.dtype().is(py::dtype::of<std::uint8_t>()))
+        {
+            throw std::invalid_argument("The bits must be a numpy array of dtype bool, or of dtype uint8 for packed bits.");
+        }
+
+        return packed;
+    }
+
+    /// The packed signs, which are all zero if None
+    Packed_Array packed_signs(const std::optional<py::array> &signs, const std::size_t number_paulis)
+    {
+        if (signs)
+        {
+            return packed_array(*signs);
+        }
+
+        Packed_Array zeros(static_cast<py::ssize_t>(packed_row_bytes(number_paulis)));
+        std::fill_n(zeros.mutable_data(), zeros.size(), 0);
+
+        return zeros;
+    }
+
+    std::span<const std::uint8_t> packed_bytes(const Packed_Array &packed)
+    {
+        return std::span(packed.data(), static_cast<std::size_t>(packed.size()));
+    }
+
+    /// The number of rows of the bits, as given to packed_array
+    std::size_t number_rows(const py::array &bits)
+    {
+        return bits.ndim() == 0 ? 0 : static_cast<std::size_t>(bits.shape(0));
+    }
+
+    /// Packs the paulis into numpy arrays (x_bits, z_bits, signs), unpacking them again to dtype bool unless bit_packed
+    py::tuple paulis_to_numpy(std::span<const Pauli> paulis, const bool bit_packed)
+    {
+        const std::size_t number_qubits = paulis.empty() ? 0 : paulis.front().number_qubits;
+        const py::ssize_t rows = static_cast<py::ssize_t>(paulis.size());
+        const py::ssize_t row_bytes = static_cast<py::ssize_t>(packed_row_bytes(number_qubits));
+
+        Packed_Array x_bits({rows, row_bytes});
+        Packed_Array z_bits({rows, row_bytes});
+        Packed_Array signs(static_cast<py::ssize_t>(packed_row_bytes(paulis.size())));
+
+        pack_paulis(paulis, std::span(x_bits.mutable_data(), static_cast<std::size_t>(x_bits.size())),
+            std::span(z_bits.mutable_data(), static_cast<std::size_t>(z_bits.size())), std::span(signs.mutable_data(), static_cast<std::size_t>(signs.size())));
+
+        if (bit_packed)
+        {
+            return py::make_tuple(x_bits, z_bits, signs);
+        }
+
+        const py::object unpackbits = py::module_::import("numpy").attr("unpackbits");
+        const auto unpack = [&](const Packed_Array &packed, const std::size_t count)
+        {
+            return unpackbits(packed, py::arg("axis") = -1, py::arg("count") = count, py::arg("bitorder") = "little").attr("astype")(py::dtype::of<bool>());
+        };
+
+        return py::make_tuple(unpack(x_bits, number_qubits), unpack(z_bits, number_qubits), unpack(signs, paulis.size()));
+    }
+
+    std::vector<Pauli> paulis_from_numpy(const std::size_t number_qubits, const py::array &x_bits, const py::array &z_bits, const std::optional<py::array> &signs)
+    {
+        const Packed_Array packed_x_bits = packed_array(x_bits);
+        const Packed_Array packed_z_bits = packed_array(z_bits);
+        const Packed_Array packed_sign_bits = packed_signs(signs, number_rows(x_bits));
+
+        return unpack_paulis(number_qubits, packed_bytes(packed_x_bits), packed_bytes(packed_z_bits), packed_bytes(packed_sign_bits));
+    }
+
+    void init_packed_paulis(py::module_ &m)
+    {
+        m.def("paulis_to_numpy", [](const std::vector<Pauli> &paulis, const bool bit_packed) { return paulis_to_numpy(paulis, bit_packed); },
+            py::arg("paulis"), py::arg("bit_packed") = false,
+            "Returns numpy arrays (x_bits, z_bits, signs) of the Hermitian Paulis, with a row of bits for each Pauli, as in stim: a Pauli is (-1)^sign times the product of the I, X, Z and Y given by its bits. With bit_packed, the bits are packed along the last axis as by numpy.packbits(bitorder = \"little\"), and otherwise have dtype bool");
+        m.def("paulis_from_numpy", &paulis_from_numpy, py::arg("number_qubits"), py::arg("x_bits"), py::arg("z_bits"), py::arg("signs") = py::none(),
+            "Returns the list of Paulis from numpy arrays in the format of paulis_to_numpy, either of dtype bool or packed as uint8. Packed C-contiguous arrays are read in place");
+        m.def("is_symplectic", [](const py::array &x2x, const py::array &x2z, const py::array &z2x, const py::array &z2z)
+            {
+                const std::size_t number_qubits = number_rows(x2x);
+                const Packed_Array packed_x2x = packed_array(x2x), packed_x2z = packed_array(x2z), packed_z2x = packed_array(z2x), packed_z2z = packed_array(z2z);
+
+                py::gil_scoped_release release;
+                return is_symplectic(number_qubits, packed_bytes(packed_x2x), packed_bytes(packed_x2z), packed_bytes(packed_z2x), packed_bytes(packed_z2z));
+            },
+            py::arg("x2x"), py::arg("x2z"), py::arg("z2x"), py::arg("z2z"),
+            "Returns whether the tableau in the format of stim's Tableau.to_numpy, on any number of qubits, is symplectic: the images of the X_i and Z_i have the commutation relations of the X_i and Z_i. This takes O(n^3 / 64) time");
+    }
+}
+
+#endif
@@ -1,5 +1,10 @@
 #include "pauli.h"
+#include "pauli_kernels.h"
 #include "util/f2_helper.h"
+#include "util/hash.h"
+#include "util/phase.h"
+
+#include <stdexcept>
 
 namespace fst
 {
@@ -9,7 +14,23 @@ namespace fst
 
     std::complex<float> Pauli::get_phase() const
     {
-        return {f_min1_pow(sign_bit) * float_not(imag_bit), -f_min1_pow(sign_bit) * static_cast<float>(imag_bit)};
+        return phase_from_exponent(get_phase_exponent());
+    }
+
+    Phase_Exponent Pauli::get_phase_exponent() const
+    {
+        return (4 * sign_bit + 6 * imag_bit) & 7;
+    }
+
+    void Pauli::set_phase_exponent(const Phase_Exponent exponent)
+    {
+        if (exponent & 1)
+        {
+            throw std::invalid_argument("The phase of a Pauli must be a power of i");
+        }
+
+        imag_bit = (exponent >> 1) & 1;
+        sign_bit = ((exponent - 6 * imag_bit) >> 2) & 1;
     }
 
     bool Pauli::is_hermitian() const
@@ -32,34 +53,60 @@ namespace fst
         const std::size_t size = integral_pow_2(number_qubits);
         std::vector<std::vector<std::complex<float>>> matrix(size, std::vector<std::complex<float>>(size, 0));
 
-        std::complex<float> phase = get_phase(); 
+        const Phase_Exponent phase_exponent = get_phase_exponent();
 
         for (size_t col_index = 0; col_index < size; col_index++)
         {
             matrix[col_index ^ x_vector][col_index] =
-                phase * sign_f2_dot_product(col_index, z_vector);
+                phase_from_exponent(phase_exponent + 4 * f2_dot_product(col_index, z_vector));
         }
 
         return matrix;
     }
 
-    std::vector<std::complex<float>> Pauli::multiply_vector(const std::vector<std::complex<float>> &vector) const
+    Monomial_Matrix Pauli::get_monomial_matrix() const
+    {
+        const std::size_t size = integral_pow_2(number_qubits);
+        Monomial_Matrix matrix;
+        matrix.rows.resize(size);
+        matrix.entries.resize(size);
+
+        const Phase_Exponent phase_exponent = get_phase_exponent();
+
+        for (std::size_t col_index = 0; col_index < size; col_index++)
+        {
+            matrix.rows[col_index] = col_index ^ x_vector;
+            matrix.entries[col_index] = phase_from_exponent(phase_exponent + 4 * f2_dot_product(col_index, z_vector));
+        }
+
+        return matrix;
+    }
+
+    template <std::floating_point Real>
+    std::vector<std::complex<Real>> Pauli::multiply_vector(const std::vector<std::complex<Real>> &vector) const
     {
         if (integral_pow_2(number_qubits) != vector.size())
         {
             throw std::invalid_argument("Invalid vector dimension for pauli-vector multiplication");
         }
         
-        const size_t size = vector.size();
-        std::vector<std::complex<float>> result(size, 0);
-        std::complex<float> phase = get_phase();
+        std::vector<std::complex<Real>> result(vector.size(), 0);
+        apply_pauli_action({x_vector, z_vector, get_phase_exponent()}, vector.data(), result.data(), vector.size());
+
+        return result;
+    }
+
+    template std::vector<std::complex<float>> Pauli::multiply_vector<float>(const std::vector<std::complex<float>> &vector) const;
+    template std::vector<std::complex<double>> Pauli::multiply_vector<double>(const std::vector<std::complex<double>> &vector) const;
 
-        for (size_t index = 0; index < size; index++)
+    void Pauli::apply_in_place(std::span<std::complex<float>> vector) const
+    {
+        if (integral_pow_2(number_qubits) != vector.size())
         {
-            result[index ^ x_vector] = phase * sign_f2_dot_product(index, z_vector) * vector[index];
+            throw std::invalid_argument("Invalid vector dimension for pauli-vector multiplication");
         }
 
-        return result;
+        apply_pauli_action_in_place({x_vector, z_vector, get_phase_exponent()}, vector.data(), vector.size());
     }
 
     void Pauli::multiply_by_pauli_on_right(const Pauli &other_pauli)
@@ -84,20 +131,45 @@ namespace fst
             throw std::invalid_argument("Invalid vector dimension");
         }
         
-        std::complex<float> phase = get_phase();
+        return is_fixed_by_pauli_action({x_vector, z_vector, get_phase_exponent() + 4 * eig_sign}, vector.data(), vector.size());
+    }
 
-        const std::size_t size = integral_pow_2(number_qubits);
-        const std::complex<float> vector_phase = f_min1_pow(eig_sign) * phase;
+    Pauli tensor(const Pauli &first, const Pauli &second)
+    {
+        const std::size_t number_qubits = first.number_qubits + second.number_qubits;
 
-        for (size_t index = 0; index < size; index++)
+        if (number_qubits > 64)
         {
-            std::complex<float> expected_phase = vector_phase * sign_f2_dot_product(index, z_vector) * vector[index];
-            if (vector[index ^ x_vector] != expected_phase)
-            {
-                return false;
-            }
+            throw std::invalid_argument("The tensor product must have at most 64 qubits.");
         }
 
-        return true;
+        Pauli product(number_qubits, (first.x_vector << second.number_qubits) | second.x_vector, (first.z_vector << second.number_qubits) | second.z_vector, 0, 0);
+        product.set_phase_exponent((first.get_phase_exponent() + second.get_phase_exponent()) & 7);
+
+        return product;
     }
-}
\ No newline at end of file
+
+    Pauli permute_qubits(const Pauli &pauli, std::span<const std::size_t> permutation)
+    {
+        if (!is_bit_permutation(permutation, pauli.number_qubits))
+        {
+            throw std::invalid_argument("The permutation must be a permutation of the qubits.");
+        }
+
+        Pauli permuted = pauli;
+        permuted.x_vector = permute_bits(pauli.x_vector, permutation);
+        permuted.z_vector = permute_bits(pauli.z_vector, permutation);
+
+        return permuted;
+    }
+}
+
+std::size_t std::hash<fst::Pauli>::operator()(const fst::Pauli &pauli) const noexcept
+{
+    std::size_t seed = pauli.number_qubits;
+    fst::hash_combine(seed, pauli.x_vector);
+    fst::hash_combine(seed, pauli.z_vector);
+    fst::hash_combine(seed, pauli.get_phase_exponent());
+
+    return seed;
+}
@@ -1,7 +1,13 @@
 #ifndef _FAST_STABILISER_PAULI_H
 #define _FAST_STABILISER_PAULI_H
 
+#include "monomial_matrix.h"
+#include "util/phase.h"
+
 #include <complex>
+#include <concepts>
+#include <functional>
+#include <span>
 #include <vector>
 
 //TODO: make sign_bit and imag_bit bools for memory efficiency. Update f2_dot_product etc. to also return bools
@@ -39,8 +45,16 @@ namespace fst
         /// Returns the matrix of the Pauli (with respect to the computational basis)
         std::vector<std::vector<std::complex<float>>> get_matrix() const;
 
-        /// Given a vector x on the same number of qubits as the Pauli P, return Px
-        std::vector<std::complex<float>> multiply_vector(const std::vector<std::complex<float>> &vector) const;
+        /// Returns the matrix of the Pauli as a monomial matrix, storing only the 2^n non-zero entries
+        Monomial_Matrix get_monomial_matrix() const;
+
+        /// Given a vector x on the same number of qubits as the Pauli P, return Px. Instantiated for float and double
+        /// amplitudes, and exact in either, as the entries of P are powers of i.
+        template <std::floating_point Real = float>
+        std::vector<std::complex<Real>> multiply_vector(const std::vector<std::complex<Real>> &vector) const;
+
+        /// Given a vector x on the same number of qubits as the Pauli P, sets x to Px without allocating
+        void apply_in_place(std::span<std::complex<float>> vector) const;
 
         /// Given another pauli Q, multiply this Pauli on the right by Q
         /// Note, the current instance is set to the result.
@@ -49,8 +63,28 @@ namespace fst
         /// Gets the current phase of the pauli: (-1)^(sign_bit) * (-i)^(imag_bit)
         std::complex<float> get_phase() const;
 
+        /// Gets the current phase of the pauli as an exponent k (mod 8), where the phase is e^(i pi k/4)
+        Phase_Exponent get_phase_exponent() const;
+
+        /// Sets the phase of the pauli to e^(i pi k/4), where k = exponent must be even
+        void set_phase_exponent(const Phase_Exponent exponent);
+
         bool operator==(const Pauli &other) const = default;
     };
+
+    /// Returns the tensor product P (x) Q, as for np.kron: the qubits of Q come first, followed by those of P.
+    /// Throws if the product has more than 64 qubits.
+    Pauli tensor(const Pauli &first, const Pauli &second);
+
+    /// Returns the pauli acting on qubit permutation[q] as the given one acts on qubit q. Throws unless the
+    /// permutation is a permutation of the qubits.
+    Pauli permute_qubits(const Pauli &pauli, std::span<const std::size_t> permutation);
 }
 
+template <>
+struct std::hash<fst::Pauli>
+{
+    std::size_t operator()(const fst::Pauli &pauli) const noexcept;
+};
+
 #endif
\ No newline at end of file
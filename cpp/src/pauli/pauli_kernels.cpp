@@ -0,0 +1,530 @@
+#include "pauli_kernels.h"
+#include "util/cpu_features.h"
+#include "util/f2_helper.h"
+
+#include <array>
+#include <cstdint>
+
+#ifdef FST_X86
+#include <immintrin.h>
+#endif
+
+namespace fst
+{
+    /// Splitting each index into a block of block_size amplitudes and a position within that block, the sign
+    /// (-1)^(index . z_vector) is the product of a sign depending only on the block and a fixed pattern within
+    /// every block. Similarly, index ^ x_vector moves each block to another block, and permutes within it by a
+    /// fixed permutation. The pattern is given per float, treating the complex amplitudes as pairs of floats.
+    template <std::size_t block_size>
+    struct Block_Pattern
+    {
+        /// Float j of an output block is float permutation[j] of the input block. This includes the swap
+        /// of real and imaginary parts when the phase is +/- i
+        std::array<std::uint32_t, 2 * block_size> permutation;
+
+        /// The sign bits to flip in each float of an output block, when the input block has even parity with z
+        std::array<std::uint32_t, 2 * block_size> sign_mask;
+
+        /// The parts of x_vector and z_vector acting on the block indices
+        std::size_t x_high;
+        std::size_t z_high;
+    };
+
+    template <std::size_t block_size>
+    static Block_Pattern<block_size> get_block_pattern(const Pauli_Action &action)
+    {
+        Block_Pattern<block_size> pattern;
+
+        const std::size_t x_low = action.x_vector & (block_size - 1);
+        const std::size_t z_low = action.z_vector & (block_size - 1);
+        pattern.x_high = action.x_vector ^ x_low;
+        pattern.z_high = action.z_vector ^ z_low;
+
+        const Phase_Exponent phase_exponent = action.phase_exponent & 7;
+        const std::uint32_t imag_part = (phase_exponent >> 1) & 1;
+
+        for (std::uint32_t j = 0; j < 2 * block_size; j++)
+        {
+            const std::uint32_t imag_float = j & 1;
+            const std::size_t input_position = (j >> 1) ^ x_low;
+            pattern.permutation[j] = static_cast<std::uint32_t>(2 * input_position) + (imag_float ^ imag_part);
+
+            // i(a + ib) = -b + ia, and -i(a + ib) = b - ia
+            const bool negate_for_phase = (phase_exponent == 4) || (phase_exponent == 2 && !imag_float) || (phase_exponent == 6 && imag_float);
+            const bool negate = negate_for_phase ^ bool(f2_dot_product(input_position, z_low));
+            pattern.sign_mask[j] = negate ? 0x80000000u : 0;
+        }
+
+        return pattern;
+    }
+
+    /// Returns the number-th integer with the given bit (a power of 2) unset
+    static constexpr std::size_t insert_zero_bit(const std::size_t number, const std::size_t bit)
+    {
+        const std::size_t low_bits = number & (bit - 1);
+        return ((number ^ low_bits) << 1) | low_bits;
+    }
+
+    /// The leading bit of x_vector, used to pick the smaller index of each pair {index, index ^ x_vector}
+    static std::size_t leading_bit_of(const std::size_t x_vector)
+    {
+        return x_vector ? integral_pow_2(static_cast<std::size_t>(integral_log_2(x_vector))) : 0;
+    }
+
+    std::size_t pauli_rotation_work_size(const Pauli_Action &action, const std::size_t size)
+    {
+        return action.x_vector ? size / 2 : size;
+    }
+
+    template <typename Real>
+    static void apply_pauli_action_generic(const Pauli_Action &action, const std::complex<Real> *input, std::complex<Real> *output, const std::size_t size)
+    {
+        for (std::size_t index = 0; index < size; index++)
+        {
+            output[index ^ action.x_vector] = multiply_by_phase(input[index], action.phase_exponent + 4 * f2_dot_product(index, action.z_vector));
+        }
+    }
+
+    template <typename Real>
+    static void apply_pauli_action_in_place_generic(const Pauli_Action &action, std::complex<Real> *vector, const std::size_t size)
+    {
+        if (action.x_vector == 0)
+        {
+            for (std::size_t index = 0; index < size; index++)
+            {
+                vector[index] = multiply_by_phase(vector[index], action.phase_exponent + 4 * f2_dot_product(index, action.z_vector));
+            }
+
+            return;
+        }
+
+        // Swap each pair {index, index ^ x_vector} once, from the member with the leading bit of x_vector unset
+        const std::size_t leading_bit = integral_pow_2(static_cast<std::size_t>(integral_log_2(action.x_vector)));
+
+        for (std::size_t index = 0; index < size; index++)
+        {
+            if (index & leading_bit)
+            {
+                continue;
+            }
+
+            const std::size_t partner = index ^ action.x_vector;
+            const std::complex<Real> amplitude = vector[index];
+
+            vector[index] = multiply_by_phase(vector[partner], action.phase_exponent + 4 * f2_dot_product(partner, action.z_vector));
+            vector[partner] = multiply_by_phase(amplitude, action.phase_exponent + 4 * f2_dot_product(index, action.z_vector));
+        }
+    }
+
+    template <typename Real>
+    static bool is_fixed_by_pauli_action_generic(const Pauli_Action &action, const std::complex<Real> *vector, const std::size_t size)
+    {
+        for (std::size_t index = 0; index < size; index++)
+        {
+            if (vector[index ^ action.x_vector] != multiply_by_phase(vector[index], action.phase_exponent + 4 * f2_dot_product(index, action.z_vector)))
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    void apply_pauli_action_scalar(const Pauli_Action &action, const std::complex<float> *input, std::complex<float> *output, const std::size_t size)
+    {
+        apply_pauli_action_generic(action, input, output, size);
+    }
+
+    void apply_pauli_action_in_place_scalar(const Pauli_Action &action, std::complex<float> *vector, const std::size_t size)
+    {
+        apply_pauli_action_in_place_generic(action, vector, size);
+    }
+
+    bool is_fixed_by_pauli_action_scalar(const Pauli_Action &action, const std::complex<float> *vector, const std::size_t size)
+    {
+        return is_fixed_by_pauli_action_generic(action, vector, size);
+    }
+
+    void apply_pauli_rotation_action_scalar(const Pauli_Action &action, const float cos_half_angle, const float sin_half_angle, std::complex<float> *vector, const std::size_t, const std::size_t begin, const std::size_t end)
+    {
+        // -i sin(angle/2) P is the action of P with its phase multiplied by w^6 = -i, scaled by sin(angle/2)
+        const Phase_Exponent phase_exponent = action.phase_exponent + 6;
+
+        if (action.x_vector == 0)
+        {
+            for (std::size_t index = begin; index < end; index++)
+            {
+                const std::complex<float> amplitude = vector[index];
+                vector[index] = cos_half_angle * amplitude + sin_half_angle * multiply_by_phase(amplitude, phase_exponent + 4 * f2_dot_product(index, action.z_vector));
+            }
+
+            return;
+        }
+
+        const std::size_t leading_bit = leading_bit_of(action.x_vector);
+
+        for (std::size_t item = begin; item < end; item++)
+        {
+            const std::size_t index = insert_zero_bit(item, leading_bit);
+            const std::size_t partner = index ^ action.x_vector;
+
+            const std::complex<float> amplitude = vector[index];
+            const std::complex<float> partner_amplitude = vector[partner];
+
+            vector[index] = cos_half_angle * amplitude + sin_half_angle * multiply_by_phase(partner_amplitude, phase_exponent + 4 * f2_dot_product(partner, action.z_vector));
+            vector[partner] = cos_half_angle * partner_amplitude + sin_half_angle * multiply_by_phase(amplitude, phase_exponent + 4 * f2_dot_product(index, action.z_vector));
+        }
+    }
+
+#ifdef FST_X86
+    FST_TARGET_AVX2 static inline __m256 transform_block_avx2(const __m256 block, const __m256i permutation, const __m256 sign_mask)
+    {
+        return _mm256_xor_ps(_mm256_permutevar8x32_ps(block, permutation), sign_mask);
+    }
+
+    /// The kernels use complex<float> being laid out as two floats, as guaranteed by the standard
+    FST_TARGET_AVX2 void apply_pauli_action_avx2(const Pauli_Action &action, const std::complex<float> *input, std::complex<float> *output, const std::size_t size)
+    {
+        constexpr std::size_t block_size = 4;
+        const Block_Pattern<block_size> pattern = get_block_pattern<block_size>(action);
+
+        const __m256i permutation = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(pattern.permutation.data()));
+        const __m256 even_sign_mask = _mm256_loadu_ps(reinterpret_cast<const float *>(pattern.sign_mask.data()));
+        const __m256 sign_masks[2] = {even_sign_mask, _mm256_xor_ps(even_sign_mask, _mm256_set1_ps(-0.0f))};
+
+        const float *input_floats = reinterpret_cast<const float *>(input);
+        float *output_floats = reinterpret_cast<float *>(output);
+
+        for (std::size_t base = 0; base < size; base += block_size)
+        {
+            const __m256 block = _mm256_loadu_ps(input_floats + 2 * base);
+            const __m256 sign_mask = sign_masks[f2_dot_product(base, pattern.z_high)];
+            _mm256_storeu_ps(output_floats + 2 * (base ^ pattern.x_high), transform_block_avx2(block, permutation, sign_mask));
+        }
+    }
+
+    FST_TARGET_AVX2 void apply_pauli_action_in_place_avx2(const Pauli_Action &action, std::complex<float> *vector, const std::size_t size)
+    {
+        constexpr std::size_t block_size = 4;
+        const Block_Pattern<block_size> pattern = get_block_pattern<block_size>(action);
+
+        const __m256i permutation = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(pattern.permutation.data()));
+        const __m256 even_sign_mask = _mm256_loadu_ps(reinterpret_cast<const float *>(pattern.sign_mask.data()));
+        const __m256 sign_masks[2] = {even_sign_mask, _mm256_xor_ps(even_sign_mask, _mm256_set1_ps(-0.0f))};
+
+        float *floats = reinterpret_cast<float *>(vector);
+
+        if (pattern.x_high == 0)
+        {
+            for (std::size_t base = 0; base < size; base += block_size)
+            {
+                const __m256 block = _mm256_loadu_ps(floats + 2 * base);
+                _mm256_storeu_ps(floats + 2 * base, transform_block_avx2(block, permutation, sign_masks[f2_dot_product(base, pattern.z_high)]));
+            }
+
+            return;
+        }
+
+        const std::size_t leading_bit = integral_pow_2(static_cast<std::size_t>(integral_log_2(pattern.x_high)));
+
+        for (std::size_t base = 0; base < size; base += block_size)
+        {
+            if (base & leading_bit)
+            {
+                continue;
+            }
+
+            const std::size_t partner = base ^ pattern.x_high;
+            const __m256 block = _mm256_loadu_ps(floats + 2 * base);
+            const __m256 partner_block = _mm256_loadu_ps(floats + 2 * partner);
+
+            _mm256_storeu_ps(floats + 2 * partner, transform_block_avx2(block, permutation, sign_masks[f2_dot_product(base, pattern.z_high)]));
+            _mm256_storeu_ps(floats + 2 * base, transform_block_avx2(partner_block, permutation, sign_masks[f2_dot_product(partner, pattern.z_high)]));
+        }
+    }
+
+    FST_TARGET_AVX2 bool is_fixed_by_pauli_action_avx2(const Pauli_Action &action, const std::complex<float> *vector, const std::size_t size)
+    {
+        constexpr std::size_t block_size = 4;
+        const Block_Pattern<block_size> pattern = get_block_pattern<block_size>(action);
+
+        const __m256i permutation = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(pattern.permutation.data()));
+        const __m256 even_sign_mask = _mm256_loadu_ps(reinterpret_cast<const float *>(pattern.sign_mask.data()));
+        const __m256 sign_masks[2] = {even_sign_mask, _mm256_xor_ps(even_sign_mask, _mm256_set1_ps(-0.0f))};
+
+        const float *floats = reinterpret_cast<const float *>(vector);
+
+        for (std::size_t base = 0; base < size; base += block_size)
+        {
+            const __m256 block = _mm256_loadu_ps(floats + 2 * base);
+            const __m256 expected = transform_block_avx2(block, permutation, sign_masks[f2_dot_product(base, pattern.z_high)]);
+            const __m256 actual = _mm256_loadu_ps(floats + 2 * (base ^ pattern.x_high));
+
+            if (_mm256_movemask_ps(_mm256_cmp_ps(expected, actual, _CMP_EQ_OQ)) != 0xff)
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    FST_TARGET_AVX2 void apply_pauli_rotation_action_avx2(const Pauli_Action &action, const float cos_half_angle, const float sin_half_angle, std::complex<float> *vector, const std::size_t, const std::size_t begin, const std::size_t end)
+    {
+        constexpr std::size_t block_size = 4;
+        const Block_Pattern<block_size> pattern = get_block_pattern<block_size>({action.x_vector, action.z_vector, action.phase_exponent + 6});
+
+        const __m256i permutation = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(pattern.permutation.data()));
+        const __m256 even_sign_mask = _mm256_loadu_ps(reinterpret_cast<const float *>(pattern.sign_mask.data()));
+        const __m256 sign_masks[2] = {even_sign_mask, _mm256_xor_ps(even_sign_mask, _mm256_set1_ps(-0.0f))};
+
+        const __m256 cosines = _mm256_set1_ps(cos_half_angle);
+        const __m256 sines = _mm256_set1_ps(sin_half_angle);
+
+        float *floats = reinterpret_cast<float *>(vector);
+
+        if (pattern.x_high == 0)
+        {
+            // Each block is mapped to itself. If x_vector is non-zero, the work items are pairs within the blocks
+            const std::size_t scale = action.x_vector ? 2 : 1;
+
+            for (std::size_t base = scale * begin; base < scale * end; base += block_size)
+            {
+                const __m256 block = _mm256_loadu_ps(floats + 2 * base);
+                const __m256 rotated = transform_block_avx2(block, permutation, sign_masks[f2_dot_product(base, pattern.z_high)]);
+                _mm256_storeu_ps(floats + 2 * base, _mm256_add_ps(_mm256_mul_ps(cosines, block), _mm256_mul_ps(sines, rotated)));
+            }
+
+            return;
+        }
+
+        const std::size_t leading_bit = leading_bit_of(pattern.x_high);
+
+        for (std::size_t item = begin; item < end; item += block_size)
+        {
+            const std::size_t base = insert_zero_bit(item, leading_bit);
+            const std::size_t partner = base ^ pattern.x_high;
+
+            const __m256 block = _mm256_loadu_ps(floats + 2 * base);
+            const __m256 partner_block = _mm256_loadu_ps(floats + 2 * partner);
+            const __m256 rotated_block = transform_block_avx2(block, permutation, sign_masks[f2_dot_product(base, pattern.z_high)]);
+            const __m256 rotated_partner = transform_block_avx2(partner_block, permutation, sign_masks[f2_dot_product(partner, pattern.z_high)]);
+
+            _mm256_storeu_ps(floats + 2 * base, _mm256_add_ps(_mm256_mul_ps(cosines, block), _mm256_mul_ps(sines, rotated_partner)));
+            _mm256_storeu_ps(floats + 2 * partner, _mm256_add_ps(_mm256_mul_ps(cosines, partner_block), _mm256_mul_ps(sines, rotated_block)));
+        }
+    }
+
+    FST_TARGET_AVX512 static inline __m512 transform_block_avx512(const __m512 block, const __m512i permutation, const __m512i sign_mask)
+    {
+        // The unmasked permutexvar leaves its pass-through source undefined, which GCC warns about
+        const __m512i permuted = _mm512_castps_si512(_mm512_mask_permutexvar_ps(block, 0xffff, permutation, block));
+        return _mm512_castsi512_ps(_mm512_xor_si512(permuted, sign_mask));
+    }
+
+    FST_TARGET_AVX512 void apply_pauli_action_avx512(const Pauli_Action &action, const std::complex<float> *input, std::complex<float> *output, const std::size_t size)
+    {
+        constexpr std::size_t block_size = 8;
+        const Block_Pattern<block_size> pattern = get_block_pattern<block_size>(action);
+
+        const __m512i permutation = _mm512_loadu_si512(pattern.permutation.data());
+        const __m512i even_sign_mask = _mm512_loadu_si512(pattern.sign_mask.data());
+        const __m512i sign_masks[2] = {even_sign_mask, _mm512_xor_si512(even_sign_mask, _mm512_set1_epi32(static_cast<int>(0x80000000u)))};
+
+        const float *input_floats = reinterpret_cast<const float *>(input);
+        float *output_floats = reinterpret_cast<float *>(output);
+
+        for (std::size_t base = 0; base < size; base += block_size)
+        {
+            const __m512 block = _mm512_loadu_ps(input_floats + 2 * base);
+            const __m512i sign_mask = sign_masks[f2_dot_product(base, pattern.z_high)];
+            _mm512_storeu_ps(output_floats + 2 * (base ^ pattern.x_high), transform_block_avx512(block, permutation, sign_mask));
+        }
+    }
+
+    FST_TARGET_AVX512 void apply_pauli_action_in_place_avx512(const Pauli_Action &action, std::complex<float> *vector, const std::size_t size)
+    {
+        constexpr std::size_t block_size = 8;
+        const Block_Pattern<block_size> pattern = get_block_pattern<block_size>(action);
+
+        const __m512i permutation = _mm512_loadu_si512(pattern.permutation.data());
+        const __m512i even_sign_mask = _mm512_loadu_si512(pattern.sign_mask.data());
+        const __m512i sign_masks[2] = {even_sign_mask, _mm512_xor_si512(even_sign_mask, _mm512_set1_epi32(static_cast<int>(0x80000000u)))};
+
+        float *floats = reinterpret_cast<float *>(vector);
+
+        if (pattern.x_high == 0)
+        {
+            for (std::size_t base = 0; base < size; base += block_size)
+            {
+                const __m512 block = _mm512_loadu_ps(floats + 2 * base);
+                _mm512_storeu_ps(floats + 2 * base, transform_block_avx512(block, permutation, sign_masks[f2_dot_product(base, pattern.z_high)]));
+            }
+
+            return;
+        }
+
+        const std::size_t leading_bit = integral_pow_2(static_cast<std::size_t>(integral_log_2(pattern.x_high)));
+
+        for (std::size_t base = 0; base < size; base += block_size)
+        {
+            if (base & leading_bit)
+            {
+                continue;
+            }
+
+            const std::size_t partner = base ^ pattern.x_high;
+            const __m512 block = _mm512_loadu_ps(floats + 2 * base);
+            const __m512 partner_block = _mm512_loadu_ps(floats + 2 * partner);
+
+            _mm512_storeu_ps(floats + 2 * partner, transform_block_avx512(block, permutation, sign_masks[f2_dot_product(base, pattern.z_high)]));
+            _mm512_storeu_ps(floats + 2 * base, transform_block_avx512(partner_block, permutation, sign_masks[f2_dot_product(partner, pattern.z_high)]));
+        }
+    }
+
+    FST_TARGET_AVX512 bool is_fixed_by_pauli_action_avx512(const Pauli_Action &action, const std::complex<float> *vector, const std::size_t size)
+    {
+        constexpr std::size_t block_size = 8;
+        const Block_Pattern<block_size> pattern = get_block_pattern<block_size>(action);
+
+        const __m512i permutation = _mm512_loadu_si512(pattern.permutation.data());
+        const __m512i even_sign_mask = _mm512_loadu_si512(pattern.sign_mask.data());
+        const __m512i sign_masks[2] = {even_sign_mask, _mm512_xor_si512(even_sign_mask, _mm512_set1_epi32(static_cast<int>(0x80000000u)))};
+
+        const float *floats = reinterpret_cast<const float *>(vector);
+
+        for (std::size_t base = 0; base < size; base += block_size)
+        {
+            const __m512 block = _mm512_loadu_ps(floats + 2 * base);
+            const __m512 expected = transform_block_avx512(block, permutation, sign_masks[f2_dot_product(base, pattern.z_high)]);
+            const __m512 actual = _mm512_loadu_ps(floats + 2 * (base ^ pattern.x_high));
+
+            if (_mm512_cmp_ps_mask(expected, actual, _CMP_EQ_OQ) != 0xffff)
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+    FST_TARGET_AVX512 void apply_pauli_rotation_action_avx512(const Pauli_Action &action, const float cos_half_angle, const float sin_half_angle, std::complex<float> *vector, const std::size_t, const std::size_t begin, const std::size_t end)
+    {
+        constexpr std::size_t block_size = 8;
+        const Block_Pattern<block_size> pattern = get_block_pattern<block_size>({action.x_vector, action.z_vector, action.phase_exponent + 6});
+
+        const __m512i permutation = _mm512_loadu_si512(pattern.permutation.data());
+        const __m512i even_sign_mask = _mm512_loadu_si512(pattern.sign_mask.data());
+        const __m512i sign_masks[2] = {even_sign_mask, _mm512_xor_si512(even_sign_mask, _mm512_set1_epi32(static_cast<int>(0x80000000u)))};
+
+        const __m512 cosines = _mm512_set1_ps(cos_half_angle);
+        const __m512 sines = _mm512_set1_ps(sin_half_angle);
+
+        float *floats = reinterpret_cast<float *>(vector);
+
+        if (pattern.x_high == 0)
+        {
+            const std::size_t scale = action.x_vector ? 2 : 1;
+
+            for (std::size_t base = scale * begin; base < scale * end; base += block_size)
+            {
+                const __m512 block = _mm512_loadu_ps(floats + 2 * base);
+                const __m512 rotated = transform_block_avx512(block, permutation, sign_masks[f2_dot_product(base, pattern.z_high)]);
+                _mm512_storeu_ps(floats + 2 * base, _mm512_fmadd_ps(cosines, block, _mm512_mul_ps(sines, rotated)));
+            }
+
+            return;
+        }
+
+        const std::size_t leading_bit = leading_bit_of(pattern.x_high);
+
+        for (std::size_t item = begin; item < end; item += block_size)
+        {
+            const std::size_t base = insert_zero_bit(item, leading_bit);
+            const std::size_t partner = base ^ pattern.x_high;
+
+            const __m512 block = _mm512_loadu_ps(floats + 2 * base);
+            const __m512 partner_block = _mm512_loadu_ps(floats + 2 * partner);
+            const __m512 rotated_block = transform_block_avx512(block, permutation, sign_masks[f2_dot_product(base, pattern.z_high)]);
+            const __m512 rotated_partner = transform_block_avx512(partner_block, permutation, sign_masks[f2_dot_product(partner, pattern.z_high)]);
+
+            _mm512_storeu_ps(floats + 2 * base, _mm512_fmadd_ps(cosines, block, _mm512_mul_ps(sines, rotated_partner)));
+            _mm512_storeu_ps(floats + 2 * partner, _mm512_fmadd_ps(cosines, partner_block, _mm512_mul_ps(sines, rotated_block)));
+        }
+    }
+#endif
+
+    namespace
+    {
+        /// The kernels of one variant, which are only used for vectors of at least the given sizes
+        struct Pauli_Kernels
+        {
+            decltype(&apply_pauli_action_scalar) apply;
+            decltype(&apply_pauli_action_in_place_scalar) apply_in_place;
+            decltype(&is_fixed_by_pauli_action_scalar) is_fixed;
+            decltype(&apply_pauli_rotation_action_scalar) apply_rotation;
+
+            std::size_t minimum_size = 0;
+            std::size_t minimum_rotation_size = 0;
+        };
+
+        constexpr Pauli_Kernels scalar_kernels {apply_pauli_action_scalar, apply_pauli_action_in_place_scalar, is_fixed_by_pauli_action_scalar, apply_pauli_rotation_action_scalar};
+
+        /// The kernels of each Kernel_Variant. There are no POPCNT specific Pauli kernels, as they only need parities.
+        constexpr std::array<Pauli_Kernels, 4> pauli_kernel_table {
+            scalar_kernels,
+            scalar_kernels,
+#ifdef FST_X86
+            Pauli_Kernels {apply_pauli_action_avx2, apply_pauli_action_in_place_avx2, is_fixed_by_pauli_action_avx2, apply_pauli_rotation_action_avx2, 4, 8},
+            Pauli_Kernels {apply_pauli_action_avx512, apply_pauli_action_in_place_avx512, is_fixed_by_pauli_action_avx512, apply_pauli_rotation_action_avx512, 8, 16}
+#else
+            scalar_kernels,
+            scalar_kernels
+#endif
+        };
+
+        /// The kernels to use for vectors of the given size, falling back to the scalar kernels for small vectors
+        const Pauli_Kernels &pauli_kernels(const std::size_t size)
+        {
+            const Pauli_Kernels &kernels = pauli_kernel_table[static_cast<std::size_t>(active_kernel_variant())];
+            return size >= kernels.minimum_size ? kernels : scalar_kernels;
+        }
+    }
+
+    void apply_pauli_action(const Pauli_Action &action, const std::complex<float> *input, std::complex<float> *output, const std::size_t size)
+    {
+        pauli_kernels(size).apply(action, input, output, size);
+    }
+
+    void apply_pauli_action_in_place(const Pauli_Action &action, std::complex<float> *vector, const std::size_t size)
+    {
+        pauli_kernels(size).apply_in_place(action, vector, size);
+    }
+
+    bool is_fixed_by_pauli_action(const Pauli_Action &action, const std::complex<float> *vector, const std::size_t size)
+    {
+        return pauli_kernels(size).is_fixed(action, vector, size);
+    }
+
+    void apply_pauli_action(const Pauli_Action &action, const std::complex<double> *input, std::complex<double> *output, const std::size_t size)
+    {
+        apply_pauli_action_generic(action, input, output, size);
+    }
+
+    void apply_pauli_action_in_place(const Pauli_Action &action, std::complex<double> *vector, const std::size_t size)
+    {
+        apply_pauli_action_in_place_generic(action, vector, size);
+    }
+
+    bool is_fixed_by_pauli_action(const Pauli_Action &action, const std::complex<double> *vector, const std::size_t size)
+    {
+        return is_fixed_by_pauli_action_generic(action, vector, size);
+    }
+
+    void apply_pauli_rotation_action(const Pauli_Action &action, const float cos_half_angle, const float sin_half_angle, std::complex<float> *vector, const std::size_t size, const std::size_t begin, const std::size_t end)
+    {
+        const Pauli_Kernels &kernels = pauli_kernel_table[static_cast<std::size_t>(active_kernel_variant())];
+        const Pauli_Kernels &rotation_kernels = size >= kernels.minimum_rotation_size ? kernels : scalar_kernels;
+
+        rotation_kernels.apply_rotation(action, cos_half_angle, sin_half_angle, vector, size, begin, end);
+    }
+}
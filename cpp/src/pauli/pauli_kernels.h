@@ -0,0 +1,66 @@
+#ifndef _FAST_STABILISER_PAULI_KERNELS_H
+#define _FAST_STABILISER_PAULI_KERNELS_H
+
+#include "util/phase.h"
+
+#include <complex>
+#include <cstddef>
+
+namespace fst
+{
+    /// The action of a Pauli on a statevector v of size 2^n:
+    /// (Pv)[index ^ x_vector] = w^(phase_exponent) * (-1)^(index . z_vector) * v[index], where w = e^(i pi/4).
+    /// The phase exponent must be even.
+    struct Pauli_Action
+    {
+        std::size_t x_vector = 0;
+        std::size_t z_vector = 0;
+        Phase_Exponent phase_exponent = 0;
+    };
+
+    /// Sets output = P input, where input and output do not overlap and have the given size (a power of 2).
+    /// Dispatches to the kernels of the active Kernel_Variant (see util/cpu_features.h).
+    void apply_pauli_action(const Pauli_Action &action, const std::complex<float> *input, std::complex<float> *output, const std::size_t size);
+
+    /// Sets vector = P vector
+    void apply_pauli_action_in_place(const Pauli_Action &action, std::complex<float> *vector, const std::size_t size);
+
+    /// Checks whether P vector = vector exactly
+    bool is_fixed_by_pauli_action(const Pauli_Action &action, const std::complex<float> *vector, const std::size_t size);
+
+    /// The same for double precision amplitudes. These always use the scalar kernels, which only permute and negate
+    /// the real and imaginary parts, so are as exact as for single precision.
+    void apply_pauli_action(const Pauli_Action &action, const std::complex<double> *input, std::complex<double> *output, const std::size_t size);
+    void apply_pauli_action_in_place(const Pauli_Action &action, std::complex<double> *vector, const std::size_t size);
+    bool is_fixed_by_pauli_action(const Pauli_Action &action, const std::complex<double> *vector, const std::size_t size);
+
+    /// For a Hermitian P, applies the rotation exp(-i angle P/2) = cos(angle/2) - i sin(angle/2) P to the vector, given
+    /// cos(angle/2) and sin(angle/2). This pairs amplitudes index and index ^ x_vector, so is split into work items: the
+    /// pairs ordered by their smaller index, or the single amplitudes if x_vector = 0. Only the work items in
+    /// [begin, end) are updated, so disjoint ranges can be processed in parallel. begin and end must be multiples of 8,
+    /// unless end is the total number of work items, given by pauli_rotation_work_size.
+    void apply_pauli_rotation_action(const Pauli_Action &action, const float cos_half_angle, const float sin_half_angle, std::complex<float> *vector, const std::size_t size, const std::size_t begin, const std::size_t end);
+
+    /// The number of work items of a rotation, see apply_pauli_rotation_action
+    std::size_t pauli_rotation_work_size(const Pauli_Action &action, const std::size_t size);
+
+    /// The individual kernels, processing one amplitude at a time, or blocks of 4 (AVX2) or 8 (AVX-512)
+    /// amplitudes. The vectorised kernels require size to be at least the block size (twice the block size for
+    /// rotations), and must only be called on CPUs supporting the instructions.
+    void apply_pauli_action_scalar(const Pauli_Action &action, const std::complex<float> *input, std::complex<float> *output, const std::size_t size);
+    void apply_pauli_action_in_place_scalar(const Pauli_Action &action, std::complex<float> *vector, const std::size_t size);
+    bool is_fixed_by_pauli_action_scalar(const Pauli_Action &action, const std::complex<float> *vector, const std::size_t size);
+    void apply_pauli_rotation_action_scalar(const Pauli_Action &action, const float cos_half_angle, const float sin_half_angle, std::complex<float> *vector, const std::size_t size, const std::size_t begin, const std::size_t end);
+
+    void apply_pauli_action_avx2(const Pauli_Action &action, const std::complex<float> *input, std::complex<float> *output, const std::size_t size);
+    void apply_pauli_action_in_place_avx2(const Pauli_Action &action, std::complex<float> *vector, const std::size_t size);
+    bool is_fixed_by_pauli_action_avx2(const Pauli_Action &action, const std::complex<float> *vector, const std::size_t size);
+    void apply_pauli_rotation_action_avx2(const Pauli_Action &action, const float cos_half_angle, const float sin_half_angle, std::complex<float> *vector, const std::size_t size, const std::size_t begin, const std::size_t end);
+
+    void apply_pauli_action_avx512(const Pauli_Action &action, const std::complex<float> *input, std::complex<float> *output, const std::size_t size);
+    void apply_pauli_action_in_place_avx512(const Pauli_Action &action, std::complex<float> *vector, const std::size_t size);
+    bool is_fixed_by_pauli_action_avx512(const Pauli_Action &action, const std::complex<float> *vector, const std::size_t size);
+    void apply_pauli_rotation_action_avx512(const Pauli_Action &action, const float cos_half_angle, const float sin_half_angle, std::complex<float> *vector, const std::size_t size, const std::size_t begin, const std::size_t end);
+}
+
+#endif
@@ -3,9 +3,11 @@
 
 #include <pybind11/pybind11.h>
 #include <pybind11/complex.h>
+#include <pybind11/numpy.h>
 #include <pybind11/stl.h>
 
 #include "pauli.h"
+#include "serialisation/pickle_pybind.h"
 
 namespace py = pybind11;
 using namespace fst;
@@ -28,10 +30,26 @@ namespace fst_pybind
             .def("anticommutes_with", &Pauli::anticommutes_with, py::arg("other_pauli"), "Given another Pauli, used to check whether it anticommutes with this Pauli")
             .def("has_eigenstate", &Pauli::has_eigenstate, py::arg("vector"), py::arg("eig_sign"), "Given a statevector x on the same number of qubits as the Pauli P, checks whether or not Px = (-1)^(eig_sign) x, i.e. whether x is an eigenstate of P with eigenvalue (-1)^(eig_sign)")
             .def("get_matrix", &Pauli::get_matrix, "Returns the matrix of the Pauli (with respect to the computational basis)")
-            .def("multiply_vector", &Pauli::multiply_vector, py::arg("vector"), "Given a vector x on the same number of qubits as the Pauli P, returns Px")
+            .def("get_monomial_matrix", &Pauli::get_monomial_matrix, "Returns the matrix of the Pauli as a Monomial_Matrix, storing only its 2^n non-zero entries")
+            .def("multiply_vector", [](const Pauli &pauli, const py::array_t<std::complex<double>, py::array::c_style> &vector)
+                { return pauli.multiply_vector(std::vector<std::complex<double>>(vector.data(), vector.data() + vector.size())); },
+                py::arg("vector").noconvert(), "Given a numpy array x of dtype complex128 on the same number of qubits as the Pauli P, returns Px in double precision")
+            .def("multiply_vector", &Pauli::multiply_vector<float>, py::arg("vector"), "Given a vector x on the same number of qubits as the Pauli P, returns Px")
+            .def("apply_in_place", [](const Pauli &pauli, py::array_t<std::complex<float>, py::array::c_style> vector)
+                { pauli.apply_in_place(std::span(vector.mutable_data(), static_cast<std::size_t>(vector.size()))); },
+                py::arg("vector"), "Given a contiguous numpy array x of dtype complex64 on the same number of qubits as the Pauli P, sets x to Px in place")
             .def("multiply_by_pauli_on_right", &Pauli::multiply_by_pauli_on_right, py::arg("other_pauli"), "Given another pauli Q, multiplies this Pauli on the right by Q. Note, the current instance is set to the result")
             .def("get_phase", &Pauli::get_phase, "Gets the current phase of the pauli: (-1)^(sign_bit) * (-i)^(imag_bit)")
+            .def("get_phase_exponent", &Pauli::get_phase_exponent, "Gets the phase of the pauli as an exponent k mod 8, so that the phase is e^(i pi k/4)")
+            .def("set_phase_exponent", &Pauli::set_phase_exponent, py::arg("exponent"), "Sets the phase of the pauli to e^(i pi k/4) for an even exponent k, i.e. a power of i")
+            .def("__eq__", &Pauli::operator==, py::arg("other"))
+            .def("__hash__", [](const Pauli &pauli) { return std::hash<Pauli>{}(pauli); })
+            .def(get_pickle<Pauli>(&deserialise_pauli))
             .doc() = "The class used to represent a Pauli operator. A Pauli is (-1)^(sign_bit) * (-i)^(imag_bit) * X^(x_vector) * Z^(z_vector). The phase of the Pauli is (-1)^(sign_bit) * (-i)^(imag_bit)";
+
+        m.def("tensor", py::overload_cast<const Pauli &, const Pauli &>(&tensor), py::arg("first"), py::arg("second"), "Returns the tensor product of the paulis, as for np.kron: the qubits of the second come first, followed by those of the first");
+        m.def("permute_qubits", [](const Pauli &pauli, const std::vector<std::size_t> &permutation) { return permute_qubits(pauli, permutation); },
+            py::arg("pauli"), py::arg("permutation"), "Returns the pauli acting on qubit permutation[q] as the given one acts on qubit q");
     }
 }
 
@@ -0,0 +1,98 @@
+#include "pauli_rotation.h"
+#include "pauli_kernels.h"
+#include "util/f2_helper.h"
+#include "util/parallel.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace fst
+{
+    /// The number of amplitudes in a tile of the batched rotations, 32 KiB so that a tile stays in the L1 or L2 cache
+    static constexpr std::size_t tile_size = 1 << 12;
+
+    /// The smallest number of work items given to a thread
+    static constexpr std::size_t grain_size = 1 << 15;
+
+    static void check_rotation(const std::size_t vector_size, const Pauli &pauli)
+    {
+        if (integral_pow_2(pauli.number_qubits) != vector_size)
+        {
+            throw std::invalid_argument("Invalid vector dimension for pauli rotation");
+        }
+
+        if (!pauli.is_hermitian())
+        {
+            throw std::invalid_argument("Pauli rotations require a Hermitian pauli");
+        }
+    }
+
+    void apply_pauli_rotation(std::span<std::complex<float>> vector, const Pauli &pauli, const float angle)
+    {
+        check_rotation(vector.size(), pauli);
+
+        const Pauli_Action action {pauli.x_vector, pauli.z_vector, pauli.get_phase_exponent()};
+        const float cos_half_angle = std::cos(angle / 2);
+        const float sin_half_angle = std::sin(angle / 2);
+
+        parallel_for(pauli_rotation_work_size(action, vector.size()), grain_size, [&](const std::size_t begin, const std::size_t end)
+        {
+            apply_pauli_rotation_action(action, cos_half_angle, sin_half_angle, vector.data(), vector.size(), begin, end);
+        });
+    }
+
+    void apply_pauli_rotations(std::span<std::complex<float>> vector, std::span<const Pauli_Rotation> rotations)
+    {
+        for (const Pauli_Rotation &rotation : rotations)
+        {
+            check_rotation(vector.size(), rotation.pauli);
+        }
+
+        const std::size_t size = vector.size();
+        const std::size_t tile = std::min(tile_size, size);
+
+        std::size_t first = 0;
+
+        while (first < rotations.size())
+        {
+            if (rotations[first].pauli.x_vector >= tile)
+            {
+                apply_pauli_rotation(vector, rotations[first].pauli, rotations[first].angle);
+                first++;
+                continue;
+            }
+
+            std::size_t last = first;
+            std::vector<std::pair<float, float>> half_angles;
+
+            while (last < rotations.size() && rotations[last].pauli.x_vector < tile)
+            {
+                half_angles.emplace_back(std::cos(rotations[last].angle / 2), std::sin(rotations[last].angle / 2));
+                last++;
+            }
+
+            // Restricted to the tile at offset, the Pauli acts by its low bits, up to the sign (-1)^(offset . z_vector)
+            parallel_for(size / tile, std::max<std::size_t>(1, grain_size / tile), [&](const std::size_t begin, const std::size_t end)
+            {
+                for (std::size_t tile_index = begin; tile_index < end; tile_index++)
+                {
+                    const std::size_t offset = tile_index * tile;
+
+                    for (std::size_t i = first; i < last; i++)
+                    {
+                        const Pauli &pauli = rotations[i].pauli;
+                        const Pauli_Action action {pauli.x_vector, pauli.z_vector & (tile - 1), pauli.get_phase_exponent() + 4 * f2_dot_product(offset, pauli.z_vector)};
+                        const auto [cos_half_angle, sin_half_angle] = half_angles[i - first];
+
+                        apply_pauli_rotation_action(action, cos_half_angle, sin_half_angle, vector.data() + offset, tile, 0, pauli_rotation_work_size(action, tile));
+                    }
+                }
+            });
+
+            first = last;
+        }
+    }
+}
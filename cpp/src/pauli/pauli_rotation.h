@@ -0,0 +1,29 @@
+#ifndef _FAST_STABILISER_PAULI_ROTATION_H
+#define _FAST_STABILISER_PAULI_ROTATION_H
+
+#include "pauli.h"
+
+#include <complex>
+#include <span>
+
+namespace fst
+{
+    /// The rotation exp(-i angle P/2) = cos(angle/2) I - i sin(angle/2) P about a Hermitian Pauli P
+    struct Pauli_Rotation
+    {
+        Pauli pauli;
+        float angle = 0;
+    };
+
+    /// Given a statevector x on the same number of qubits as the Hermitian Pauli P, sets x to exp(-i angle P/2) x.
+    /// Each pair of amplitudes index, index ^ x_vector is updated together in a single pass over the vector, so the
+    /// matrix of P is never formed. Large vectors are split between threads.
+    void apply_pauli_rotation(std::span<std::complex<float>> vector, const Pauli &pauli, const float angle);
+
+    /// Applies the rotations to the statevector in order. Consecutive rotations whose x_vector only acts on the
+    /// lowest qubits are applied one cache-sized tile of the vector at a time, so that the vector is only read
+    /// from memory once for all of them.
+    void apply_pauli_rotations(std::span<std::complex<float>> vector, std::span<const Pauli_Rotation> rotations);
+}
+
+#endif
@@ -0,0 +1,40 @@
+#ifndef _FAST_STABILISER_PAULI_ROTATION_PYBIND_H
+#define _FAST_STABILISER_PAULI_ROTATION_PYBIND_H
+
+#include <pybind11/pybind11.h>
+#include <pybind11/complex.h>
+#include <pybind11/numpy.h>
+#include <pybind11/stl.h>
+
+#include "pauli_rotation.h"
+
+namespace py = pybind11;
+using namespace fst;
+
+namespace fst_pybind
+{
+    void init_pauli_rotation(py::module_ &m)
+    {
+        m.def("apply_pauli_rotation", [](py::array_t<std::complex<float>, py::array::c_style> vector, const Pauli &pauli, const float angle)
+            { apply_pauli_rotation(std::span(vector.mutable_data(), static_cast<std::size_t>(vector.size())), pauli, angle); },
+            py::arg("vector"), py::arg("pauli"), py::arg("angle"),
+            "Given a contiguous numpy array x of dtype complex64 on the same number of qubits as the Hermitian Pauli P, sets x to exp(-i angle P/2) x in place");
+
+        m.def("apply_pauli_rotations", [](py::array_t<std::complex<float>, py::array::c_style> vector, const std::vector<std::pair<Pauli, float>> &rotations)
+            {
+                std::vector<Pauli_Rotation> pauli_rotations;
+                pauli_rotations.reserve(rotations.size());
+
+                for (const auto &[pauli, angle] : rotations)
+                {
+                    pauli_rotations.push_back({pauli, angle});
+                }
+
+                apply_pauli_rotations(std::span(vector.mutable_data(), static_cast<std::size_t>(vector.size())), pauli_rotations);
+            },
+            py::arg("vector"), py::arg("rotations"),
+            "Given a contiguous numpy array x of dtype complex64 and a list of (pauli, angle) pairs, applies the rotations exp(-i angle P/2) to x in place, in order");
+    }
+}
+
+#endif
@@ -0,0 +1,120 @@
+#include "random_pauli.h"
+#include "util/f2_helper.h"
+
+namespace fst
+{
+    namespace
+    {
+        /// A Pauli up to phase, as a vector in F_2^(2n)
+        struct Symplectic_Vector
+        {
+            std::size_t x_vector = 0;
+            std::size_t z_vector = 0;
+
+            bool anticommutes_with(const Symplectic_Vector &other) const
+            {
+                return f2_dot_product(x_vector, other.z_vector) ^ f2_dot_product(z_vector, other.x_vector);
+            }
+
+            void operator^=(const Symplectic_Vector &other)
+            {
+                x_vector ^= other.x_vector;
+                z_vector ^= other.z_vector;
+            }
+
+            bool is_zero() const
+            {
+                return x_vector == 0 && z_vector == 0;
+            }
+        };
+
+        /// Returns a uniformly random vector in the symplectic complement of the span of the pairs
+        Symplectic_Vector random_complement_vector(const std::size_t number_qubits, const std::vector<Symplectic_Vector> &z_vectors, const std::vector<Symplectic_Vector> &x_vectors, Random_Generator &generator)
+        {
+            Symplectic_Vector vector {generator.random_bits(number_qubits), generator.random_bits(number_qubits)};
+            const Symplectic_Vector original = vector;
+
+            // The projection v -> v + sum_k <v, x_k> z_k + <v, z_k> x_k is onto the complement, and is uniform on
+            // it when v is uniform
+            for (std::size_t k = 0; k < z_vectors.size(); k++)
+            {
+                if (original.anticommutes_with(x_vectors[k]))
+                {
+                    vector ^= z_vectors[k];
+                }
+
+                if (original.anticommutes_with(z_vectors[k]))
+                {
+                    vector ^= x_vectors[k];
+                }
+            }
+
+            return vector;
+        }
+
+        void check_number_qubits(const std::size_t number_qubits)
+        {
+            if (number_qubits > 64)
+            {
+                throw std::invalid_argument("Only random objects on at most 64 qubits can be generated.");
+            }
+        }
+
+        Pauli hermitian_pauli_with_random_sign(const std::size_t number_qubits, const Symplectic_Vector &vector, Random_Generator &generator)
+        {
+            return Pauli(number_qubits, vector.x_vector, vector.z_vector, generator.random_bit(), f2_dot_product(vector.x_vector, vector.z_vector));
+        }
+    }
+
+    Pauli random_pauli(const std::size_t number_qubits, Random_Generator &generator)
+    {
+        check_number_qubits(number_qubits);
+
+        const Symplectic_Vector vector {generator.random_bits(number_qubits), generator.random_bits(number_qubits)};
+        return hermitian_pauli_with_random_sign(number_qubits, vector, generator);
+    }
+
+    std::pair<std::vector<Pauli>, std::vector<Pauli>> random_symplectic_paulis(const std::size_t number_qubits, Random_Generator &generator)
+    {
+        check_number_qubits(number_qubits);
+
+        std::vector<Symplectic_Vector> z_vectors;
+        std::vector<Symplectic_Vector> x_vectors;
+        z_vectors.reserve(number_qubits);
+        x_vectors.reserve(number_qubits);
+
+        for (std::size_t i = 0; i < number_qubits; i++)
+        {
+            Symplectic_Vector z_vector;
+
+            do
+            {
+                z_vector = random_complement_vector(number_qubits, z_vectors, x_vectors, generator);
+            }
+            while (z_vector.is_zero());
+
+            Symplectic_Vector x_vector;
+
+            do
+            {
+                x_vector = random_complement_vector(number_qubits, z_vectors, x_vectors, generator);
+            }
+            while (!x_vector.anticommutes_with(z_vector));
+
+            z_vectors.push_back(z_vector);
+            x_vectors.push_back(x_vector);
+        }
+
+        std::pair<std::vector<Pauli>, std::vector<Pauli>> paulis;
+        paulis.first.reserve(number_qubits);
+        paulis.second.reserve(number_qubits);
+
+        for (std::size_t i = 0; i < number_qubits; i++)
+        {
+            paulis.first.push_back(hermitian_pauli_with_random_sign(number_qubits, z_vectors[i], generator));
+            paulis.second.push_back(hermitian_pauli_with_random_sign(number_qubits, x_vectors[i], generator));
+        }
+
+        return paulis;
+    }
+}
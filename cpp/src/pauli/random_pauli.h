@@ -0,0 +1,27 @@
+#ifndef _FAST_STABILISER_RANDOM_PAULI_H
+#define _FAST_STABILISER_RANDOM_PAULI_H
+
+#include "pauli.h"
+#include "util/random.h"
+
+#include <utility>
+#include <vector>
+
+namespace fst
+{
+    /// Returns a uniformly random Hermitian Pauli on the given number of qubits (including the identity), with a
+    /// uniformly random sign. This and the random generators built on it throw for more than 64 qubits.
+    Pauli random_pauli(const std::size_t number_qubits, Random_Generator &generator);
+
+    /// Returns uniformly random Hermitian Paulis (Z'_i, X'_i) with the same commutation relations as (Z_i, X_i),
+    /// i.e. the images of the Z_i and X_i under a uniformly random Clifford. Each Pauli has a uniformly random sign.
+    ///
+    /// The pairs are built one at a time. Z'_i is a random non-zero vector projected onto the symplectic complement
+    /// of the previous pairs, and X'_i is a random vector in that complement which anticommutes with Z'_i. Each step
+    /// has a constant expected number of attempts and costs O(n) word operations per previous pair, so the total
+    /// cost is O(n^2) for up to 64 qubits. This is the sequential sampling of the symplectic group, as in
+    /// Koenig & Smolin.
+    std::pair<std::vector<Pauli>, std::vector<Pauli>> random_symplectic_paulis(const std::size_t number_qubits, Random_Generator &generator);
+}
+
+#endif
@@ -0,0 +1,21 @@
+#ifndef _FAST_STABILISER_RANDOM_PAULI_PYBIND_H
+#define _FAST_STABILISER_RANDOM_PAULI_PYBIND_H
+
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+
+#include "random_pauli.h"
+
+namespace py = pybind11;
+using namespace fst;
+
+namespace fst_pybind
+{
+    void init_random_pauli(py::module_ &m)
+    {
+        m.def("random_pauli", &random_pauli, py::arg("number_qubits"), py::arg("generator"), "Returns a uniformly random Hermitian pauli with a uniformly random sign");
+        m.def("random_symplectic_paulis", &random_symplectic_paulis, py::arg("number_qubits"), py::arg("generator"), "Returns lists of Hermitian paulis (Z'_i) and (X'_i), the images of the Z_i and X_i under a uniformly random clifford");
+    }
+}
+
+#endif
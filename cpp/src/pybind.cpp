@@ -1,31 +1,85 @@
 #include <pybind11/pybind11.h>
 
+#include "util/random_pybind.h"
+#include "util/cpu_features_pybind.h"
+#include "util/stats_pybind.h"
+#include "pauli/monomial_matrix_pybind.h"
 #include "pauli/pauli_pybind.h"
+#include "pauli/pauli_rotation_pybind.h"
+#include "pauli/random_pauli_pybind.h"
+#include "pauli/packed_paulis_pybind.h"
 #include "stabiliser_state/check_matrix_pybind.h"
 #include "stabiliser_state/stabiliser_state_pybind.h"
 #include "stabiliser_state/stabiliser_state_from_statevector_pybind.h"
+#include "stabiliser_state/random_stabiliser_state_pybind.h"
+#include "stabiliser_state/stabiliser_state_rank_pybind.h"
+#include "stabiliser_state/composition_pybind.h"
 #include "clifford/clifford_pybind.h"
 #include "clifford/clifford_from_matrix_pybind.h"
+#include "clifford/random_clifford_pybind.h"
+#include "clifford/clifford_rank_pybind.h"
+#include "clifford/clifford_composition_pybind.h"
+#include "clifford/clifford_synthesis_pybind.h"
+#include "simulation/circuit_pybind.h"
+#include "simulation/tableau_pybind.h"
+#include "simulation/frame_sampler_pybind.h"
+#include "serialisation/serialisation_pybind.h"
 
 namespace py = pybind11;
 using namespace fst;
 
 namespace fst_pybind {
 
+    void init_random(py::module_ &);
+    void init_cpu_features(py::module_ &);
+    void init_stats(py::module_ &);
+    void init_monomial_matrix(py::module_ &);
     void init_pauli(py::module_ &);
+    void init_pauli_rotation(py::module_ &);
+    void init_random_pauli(py::module_ &);
+    void init_packed_paulis(py::module_ &);
     void init_check_matrix(py::module_ &);
     void init_stabiliser_state(py::module_ &);
     void init_stabiliser_state_from_statevector(py::module_ &);
+    void init_random_stabiliser_state(py::module_ &);
+    void init_stabiliser_state_rank(py::module_ &);
+    void init_composition(py::module_ &);
     void init_clifford(py::module_ &);
     void init_clifford_from_matrix(py::module_ &);
+    void init_random_clifford(py::module_ &);
+    void init_clifford_rank(py::module_ &);
+    void init_clifford_composition(py::module_ &);
+    void init_clifford_synthesis(py::module_ &);
+    void init_circuit(py::module_ &);
+    void init_tableau(py::module_ &);
+    void init_frame_sampler(py::module_ &);
+    void init_serialisation(py::module_ &);
     
     PYBIND11_MODULE(_stab_tools, m)
     {
+        init_random(m);
+        init_cpu_features(m);
+        init_stats(m);
+        init_monomial_matrix(m);
         init_pauli(m);
+        init_pauli_rotation(m);
+        init_random_pauli(m);
+        init_packed_paulis(m);
         init_check_matrix(m);
         init_stabiliser_state(m);
         init_stabiliser_state_from_statevector(m);
+        init_random_stabiliser_state(m);
+        init_stabiliser_state_rank(m);
+        init_composition(m);
         init_clifford(m);
         init_clifford_from_matrix(m);
+        init_random_clifford(m);
+        init_clifford_rank(m);
+        init_clifford_composition(m);
+        init_clifford_synthesis(m);
+        init_circuit(m);
+        init_tableau(m);
+        init_frame_sampler(m);
+        init_serialisation(m);
     }
 }
\ No newline at end of file
@@ -0,0 +1,34 @@
+#ifndef _FAST_STABILISER_PICKLE_PYBIND_H
+#define _FAST_STABILISER_PICKLE_PYBIND_H
+
+#include <pybind11/pybind11.h>
+
+#include <span>
+#include <string_view>
+
+#include "serialisation.h"
+
+namespace py = pybind11;
+using namespace fst;
+
+namespace fst_pybind
+{
+    /// Pickles objects as bytes in the binary format, with deserialise the matching deserialise_ function
+    template <typename T, typename Deserialise>
+    auto get_pickle(Deserialise deserialise)
+    {
+        return py::pickle(
+            [](const T &object)
+            {
+                const std::vector<std::byte> bytes = serialise(object);
+                return py::bytes(reinterpret_cast<const char *>(bytes.data()), bytes.size());
+            },
+            [deserialise](const py::bytes &bytes)
+            {
+                const std::string_view data(bytes);
+                return deserialise(std::as_bytes(std::span(data.data(), data.size())));
+            });
+    }
+}
+
+#endif
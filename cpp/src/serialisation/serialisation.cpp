@@ -0,0 +1,521 @@
+#include "serialisation.h"
+#include "util/f2_helper.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <stdexcept>
+
+namespace fst
+{
+    static_assert(std::endian::native == std::endian::little, "The binary format is little-endian");
+    static_assert(sizeof(Batch_Header) == 24);
+
+    namespace
+    {
+        std::uint8_t get_word_bytes(const std::size_t number_qubits)
+        {
+            return static_cast<std::uint8_t>(number_qubits <= 8 ? 1 : number_qubits <= 16 ? 2 : number_qubits <= 32 ? 4 : 8);
+        }
+
+        std::size_t align(const std::size_t offset)
+        {
+            return (offset + batch_alignment - 1) / batch_alignment * batch_alignment;
+        }
+
+        /// The (name, bytes per item, items per object, is complex) of the columns of each type
+        struct Column_Format
+        {
+            const char *name;
+            bool is_word;
+            bool per_qubit;
+            std::size_t item_bytes = 0;
+            bool is_complex = false;
+        };
+
+        std::vector<Column_Format> get_column_formats(const Serialised_Type type)
+        {
+            switch (type)
+            {
+                case Serialised_Type::pauli:
+                    return {{"x", true, false}, {"z", true, false}, {"phase", false, false, 1}};
+                case Serialised_Type::check_matrix:
+                    return {{"x", true, true}, {"z", true, true}, {"signs", true, false}, {"imags", true, false}};
+                case Serialised_Type::stabiliser_state:
+                    return {{"dim", false, false, 1}, {"shift", true, false}, {"basis", true, true}, {"real_linear_part", true, false},
+                        {"imaginary_part", true, false}, {"quadratic_form", true, true}, {"global_phase", false, false, 8, true}};
+                case Serialised_Type::clifford:
+                    return {{"z_conjugates_x", true, true}, {"z_conjugates_z", true, true}, {"x_conjugates_x", true, true},
+                        {"x_conjugates_z", true, true}, {"z_conjugates_signs", true, false}, {"z_conjugates_imags", true, false},
+                        {"x_conjugates_signs", true, false}, {"x_conjugates_imags", true, false}, {"global_phase", false, false, 8, true}};
+            }
+
+            throw std::invalid_argument("Unknown serialised type.");
+        }
+
+        /// Writes the header and columns of a batch into a zero-initialised buffer
+        class Batch_Writer
+        {
+            public:
+            Batch_Writer(const Serialised_Type type, const std::size_t number_qubits, const std::size_t count)
+                : columns(get_batch_columns(type, number_qubits, count))
+            {
+                bytes.resize(columns.back().offset);
+
+                Batch_Header header;
+                header.type = type;
+                header.word_bytes = get_word_bytes(number_qubits);
+                header.number_qubits = static_cast<std::uint32_t>(number_qubits);
+                header.count = count;
+                std::memcpy(bytes.data(), &header, sizeof(header));
+            }
+
+            void write_word(const std::size_t column_index, const std::size_t object_index, const std::size_t item_index, const std::uint64_t value)
+            {
+                const Batch_Column &column = columns[column_index];
+                std::memcpy(bytes.data() + column.offset + (object_index * column.items_per_object + item_index) * column.item_bytes, &value, column.item_bytes);
+            }
+
+            void write_complex(const std::size_t column_index, const std::size_t object_index, const std::complex<float> value)
+            {
+                std::memcpy(bytes.data() + columns[column_index].offset + object_index * sizeof(value), &value, sizeof(value));
+            }
+
+            std::vector<std::byte> bytes;
+
+            private:
+            std::vector<Batch_Column> columns;
+        };
+
+        template <typename T>
+        std::size_t get_number_qubits(std::span<const T> objects)
+        {
+            const std::size_t number_qubits = objects.empty() ? 0 : objects.front().number_qubits;
+
+            for (const T &object : objects)
+            {
+                if (object.number_qubits != number_qubits)
+                {
+                    throw std::invalid_argument("The objects in a batch must all be on the same number of qubits.");
+                }
+            }
+
+            return number_qubits;
+        }
+
+        void check_mask_size(std::span<const Pauli> paulis)
+        {
+            if (paulis.size() > 64)
+            {
+                throw std::invalid_argument("At most 64 paulis can be packed into a mask.");
+            }
+        }
+
+        /// Returns the mask with i-th bit the sign (or imaginary) bit of the i-th pauli
+        std::uint64_t get_sign_mask(std::span<const Pauli> paulis)
+        {
+            check_mask_size(paulis);
+
+            std::uint64_t mask = 0;
+
+            for (std::size_t i = 0; i < paulis.size(); i++)
+            {
+                mask |= std::uint64_t(paulis[i].sign_bit) << i;
+            }
+
+            return mask;
+        }
+
+        std::uint64_t get_imag_mask(std::span<const Pauli> paulis)
+        {
+            check_mask_size(paulis);
+
+            std::uint64_t mask = 0;
+
+            for (std::size_t i = 0; i < paulis.size(); i++)
+            {
+                mask |= std::uint64_t(paulis[i].imag_bit) << i;
+            }
+
+            return mask;
+        }
+    }
+
+    std::vector<Batch_Column> get_batch_columns(const Serialised_Type type, const std::size_t number_qubits, const std::size_t count)
+    {
+        if (number_qubits > 64)
+        {
+            throw std::invalid_argument("Only objects on at most 64 qubits can be serialised.");
+        }
+
+        const std::size_t word_bytes = get_word_bytes(number_qubits);
+
+        std::vector<Batch_Column> columns;
+        std::size_t offset = batch_alignment;
+
+        for (const Column_Format &format : get_column_formats(type))
+        {
+            Batch_Column column {format.name, offset, format.is_word ? word_bytes : format.item_bytes, format.per_qubit ? number_qubits : 1, format.is_complex};
+            offset = align(offset + count * column.items_per_object * column.item_bytes);
+            columns.push_back(std::move(column));
+        }
+
+        columns.push_back({"end", offset, 0, 0});
+
+        return columns;
+    }
+
+    std::vector<std::byte> write_batch(std::span<const Pauli> paulis)
+    {
+        Batch_Writer writer(Serialised_Type::pauli, get_number_qubits(paulis), paulis.size());
+
+        for (std::size_t i = 0; i < paulis.size(); i++)
+        {
+            writer.write_word(0, i, 0, paulis[i].x_vector);
+            writer.write_word(1, i, 0, paulis[i].z_vector);
+            writer.write_word(2, i, 0, paulis[i].sign_bit | (paulis[i].imag_bit << 1));
+        }
+
+        return std::move(writer.bytes);
+    }
+
+    std::vector<std::byte> write_batch(std::span<const Check_Matrix> check_matrices)
+    {
+        const std::size_t number_qubits = get_number_qubits(check_matrices);
+        Batch_Writer writer(Serialised_Type::check_matrix, number_qubits, check_matrices.size());
+
+        for (std::size_t i = 0; i < check_matrices.size(); i++)
+        {
+            const std::pmr::vector<Pauli> &paulis = check_matrices[i].get_paulis();
+
+            if (paulis.size() != number_qubits)
+            {
+                throw std::invalid_argument("Only check matrices with one generator per qubit can be serialised.");
+            }
+
+            for (std::size_t j = 0; j < paulis.size(); j++)
+            {
+                writer.write_word(0, i, j, paulis[j].x_vector);
+                writer.write_word(1, i, j, paulis[j].z_vector);
+            }
+
+            writer.write_word(2, i, 0, get_sign_mask(paulis));
+            writer.write_word(3, i, 0, get_imag_mask(paulis));
+        }
+
+        return std::move(writer.bytes);
+    }
+
+    std::vector<std::byte> write_batch(std::span<const Stabiliser_State> states)
+    {
+        Batch_Writer writer(Serialised_Type::stabiliser_state, get_number_qubits(states), states.size());
+
+        for (std::size_t i = 0; i < states.size(); i++)
+        {
+            const Stabiliser_State &state = states[i];
+
+            writer.write_word(0, i, 0, state.dim);
+            writer.write_word(1, i, 0, state.shift);
+            writer.write_word(3, i, 0, state.real_linear_part);
+            writer.write_word(4, i, 0, state.imaginary_part);
+            writer.write_complex(6, i, state.global_phase);
+
+            for (std::size_t j = 0; j < state.dim; j++)
+            {
+                writer.write_word(2, i, j, state.basis_vectors[j]);
+
+                std::uint64_t quadratic_row = 0;
+
+                for (std::size_t k = 0; k < state.dim; k++)
+                {
+                    if (k != j && state.quadratic_form.at(integral_pow_2(j) | integral_pow_2(k)))
+                    {
+                        quadratic_row |= std::uint64_t(1) << k;
+                    }
+                }
+
+                writer.write_word(5, i, j, quadratic_row);
+            }
+        }
+
+        return std::move(writer.bytes);
+    }
+
+    std::vector<std::byte> write_batch(std::span<const Clifford> cliffords)
+    {
+        Batch_Writer writer(Serialised_Type::clifford, get_number_qubits(cliffords), cliffords.size());
+
+        for (std::size_t i = 0; i < cliffords.size(); i++)
+        {
+            const Clifford &clifford = cliffords[i];
+
+            for (std::size_t j = 0; j < clifford.number_qubits; j++)
+            {
+                writer.write_word(0, i, j, clifford.z_conjugates[j].x_vector);
+                writer.write_word(1, i, j, clifford.z_conjugates[j].z_vector);
+                writer.write_word(2, i, j, clifford.x_conjugates[j].x_vector);
+                writer.write_word(3, i, j, clifford.x_conjugates[j].z_vector);
+            }
+
+            writer.write_word(4, i, 0, get_sign_mask(clifford.z_conjugates));
+            writer.write_word(5, i, 0, get_imag_mask(clifford.z_conjugates));
+            writer.write_word(6, i, 0, get_sign_mask(clifford.x_conjugates));
+            writer.write_word(7, i, 0, get_imag_mask(clifford.x_conjugates));
+            writer.write_complex(8, i, clifford.global_phase);
+        }
+
+        return std::move(writer.bytes);
+    }
+
+    Batch_View::Batch_View(std::span<const std::byte> data)
+        : data(data)
+    {
+        if (data.size() < batch_alignment)
+        {
+            throw std::invalid_argument("The batch is too short to hold a header.");
+        }
+
+        std::memcpy(&batch_header, data.data(), sizeof(batch_header));
+
+        if (batch_header.magic != Batch_Header().magic)
+        {
+            throw std::invalid_argument("The data is not a batch of stabiliser objects.");
+        }
+
+        if (batch_header.version != serialisation_version)
+        {
+            throw std::invalid_argument("Unsupported batch format version " + std::to_string(batch_header.version) + ".");
+        }
+
+        if (batch_header.type < Serialised_Type::pauli || batch_header.type > Serialised_Type::clifford
+            || batch_header.number_qubits > 64 || batch_header.word_bytes != get_word_bytes(batch_header.number_qubits)
+            || batch_header.count > data.size())
+        {
+            throw std::invalid_argument("The batch header is corrupt.");
+        }
+
+        batch_columns = get_batch_columns(batch_header.type, batch_header.number_qubits, batch_header.count);
+
+        if (data.size() < batch_columns.back().offset)
+        {
+            throw std::invalid_argument("The batch is truncated.");
+        }
+
+        batch_columns.pop_back();
+    }
+
+    const Batch_Header &Batch_View::header() const
+    {
+        return batch_header;
+    }
+
+    Serialised_Type Batch_View::type() const
+    {
+        return batch_header.type;
+    }
+
+    std::size_t Batch_View::number_qubits() const
+    {
+        return batch_header.number_qubits;
+    }
+
+    std::size_t Batch_View::size() const
+    {
+        return batch_header.count;
+    }
+
+    const std::vector<Batch_Column> &Batch_View::columns() const
+    {
+        return batch_columns;
+    }
+
+    std::span<const std::byte> Batch_View::column(const std::string &name) const
+    {
+        for (const Batch_Column &column : batch_columns)
+        {
+            if (column.name == name)
+            {
+                return data.subspan(column.offset, batch_header.count * column.items_per_object * column.item_bytes);
+            }
+        }
+
+        throw std::invalid_argument("The batch has no column " + name + ".");
+    }
+
+    std::uint64_t Batch_View::read_word(const std::size_t column_index, const std::size_t object_index, const std::size_t item_index) const
+    {
+        const Batch_Column &column = batch_columns[column_index];
+        std::uint64_t value = 0;
+        std::memcpy(&value, data.data() + column.offset + (object_index * column.items_per_object + item_index) * column.item_bytes, column.item_bytes);
+
+        return value;
+    }
+
+    std::complex<float> Batch_View::read_complex(const std::size_t column_index, const std::size_t object_index) const
+    {
+        std::complex<float> value;
+        std::memcpy(&value, data.data() + batch_columns[column_index].offset + object_index * sizeof(value), sizeof(value));
+
+        return value;
+    }
+
+    void Batch_View::check_type(const Serialised_Type type) const
+    {
+        if (batch_header.type != type)
+        {
+            throw std::invalid_argument("The batch holds a different type of object.");
+        }
+    }
+
+    void Batch_View::check_index(const std::size_t index) const
+    {
+        if (index >= size())
+        {
+            throw std::out_of_range("The batch index is out of range.");
+        }
+    }
+
+    Pauli Batch_View::get_pauli(const std::size_t index) const
+    {
+        check_type(Serialised_Type::pauli);
+        check_index(index);
+
+        const std::uint64_t phase = read_word(2, index);
+
+        return Pauli(number_qubits(), read_word(0, index), read_word(1, index), phase & 1, (phase >> 1) & 1);
+    }
+
+    Check_Matrix Batch_View::get_check_matrix(const std::size_t index) const
+    {
+        check_type(Serialised_Type::check_matrix);
+        check_index(index);
+
+        const std::uint64_t signs = read_word(2, index);
+        const std::uint64_t imags = read_word(3, index);
+
+        std::vector<Pauli> paulis;
+        paulis.reserve(number_qubits());
+
+        for (std::size_t j = 0; j < number_qubits(); j++)
+        {
+            paulis.emplace_back(number_qubits(), read_word(0, index, j), read_word(1, index, j), bit_set_at(signs, j), bit_set_at(imags, j));
+        }
+
+        return Check_Matrix(paulis);
+    }
+
+    Stabiliser_State Batch_View::get_stabiliser_state(const std::size_t index) const
+    {
+        check_type(Serialised_Type::stabiliser_state);
+        check_index(index);
+
+        const std::size_t dim = read_word(0, index);
+
+        if (dim > number_qubits())
+        {
+            throw std::invalid_argument("The batch holds a stabiliser state of invalid dimension.");
+        }
+
+        Stabiliser_State state(number_qubits(), dim);
+        state.shift = read_word(1, index);
+        state.real_linear_part = read_word(3, index);
+        state.imaginary_part = read_word(4, index);
+        state.global_phase = read_complex(6, index);
+
+        state.basis_vectors.reserve(dim);
+        state.quadratic_form[0] = 0;
+
+        for (std::size_t j = 0; j < dim; j++)
+        {
+            state.basis_vectors.push_back(read_word(2, index, j));
+
+            const std::uint64_t quadratic_row = read_word(5, index, j);
+
+            for (std::size_t k = j + 1; k < dim; k++)
+            {
+                state.quadratic_form[integral_pow_2(j) | integral_pow_2(k)] = bit_set_at(quadratic_row, k);
+            }
+        }
+
+        return state;
+    }
+
+    Clifford Batch_View::get_clifford(const std::size_t index) const
+    {
+        check_type(Serialised_Type::clifford);
+        check_index(index);
+
+        const std::uint64_t z_signs = read_word(4, index);
+        const std::uint64_t z_imags = read_word(5, index);
+        const std::uint64_t x_signs = read_word(6, index);
+        const std::uint64_t x_imags = read_word(7, index);
+
+        std::vector<Pauli> z_conjugates;
+        std::vector<Pauli> x_conjugates;
+        z_conjugates.reserve(number_qubits());
+        x_conjugates.reserve(number_qubits());
+
+        for (std::size_t j = 0; j < number_qubits(); j++)
+        {
+            z_conjugates.emplace_back(number_qubits(), read_word(0, index, j), read_word(1, index, j), bit_set_at(z_signs, j), bit_set_at(z_imags, j));
+            x_conjugates.emplace_back(number_qubits(), read_word(2, index, j), read_word(3, index, j), bit_set_at(x_signs, j), bit_set_at(x_imags, j));
+        }
+
+        return Clifford(z_conjugates, x_conjugates, read_complex(8, index));
+    }
+
+    std::vector<std::byte> serialise(const Pauli &pauli)
+    {
+        return write_batch(std::span(&pauli, 1));
+    }
+
+    std::vector<std::byte> serialise(const Check_Matrix &check_matrix)
+    {
+        return write_batch(std::span(&check_matrix, 1));
+    }
+
+    std::vector<std::byte> serialise(const Stabiliser_State &state)
+    {
+        return write_batch(std::span(&state, 1));
+    }
+
+    std::vector<std::byte> serialise(const Clifford &clifford)
+    {
+        return write_batch(std::span(&clifford, 1));
+    }
+
+    namespace
+    {
+        Batch_View single_object_view(std::span<const std::byte> data)
+        {
+            Batch_View view(data);
+
+            if (view.size() != 1)
+            {
+                throw std::invalid_argument("The data does not hold a single object.");
+            }
+
+            return view;
+        }
+    }
+
+    Pauli deserialise_pauli(std::span<const std::byte> data)
+    {
+        return single_object_view(data).get_pauli(0);
+    }
+
+    Check_Matrix deserialise_check_matrix(std::span<const std::byte> data)
+    {
+        return single_object_view(data).get_check_matrix(0);
+    }
+
+    Stabiliser_State deserialise_stabiliser_state(std::span<const std::byte> data)
+    {
+        return single_object_view(data).get_stabiliser_state(0);
+    }
+
+    Clifford deserialise_clifford(std::span<const std::byte> data)
+    {
+        return single_object_view(data).get_clifford(0);
+    }
+}
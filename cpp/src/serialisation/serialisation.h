@@ -0,0 +1,118 @@
+#ifndef _FAST_STABILISER_SERIALISATION_H
+#define _FAST_STABILISER_SERIALISATION_H
+
+#include "pauli/pauli.h"
+#include "stabiliser_state/check_matrix.h"
+#include "stabiliser_state/stabiliser_state.h"
+#include "clifford/clifford.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace fst
+{
+    /// Batches of objects on the same number of qubits are stored in a versioned binary format:
+    ///
+    /// - A 64 byte header, starting with a Batch_Header.
+    /// - One column per field of the objects, each aligned to 64 bytes. Each column holds the field for all the
+    ///   objects contiguously, so it can be viewed in place as an array (e.g. by NumPy).
+    ///
+    /// F_2 vectors (and masks of sign and imaginary bits) are packed into words of word_bytes bytes, the smallest
+    /// of 1, 2, 4 and 8 that fits number_qubits bits. Global phases are stored as complex floats. All values are
+    /// little-endian. A single object is stored as a batch of one.
+    constexpr std::uint16_t serialisation_version = 1;
+    constexpr std::size_t batch_alignment = 64;
+
+    enum class Serialised_Type : std::uint8_t
+    {
+        pauli = 1,
+        check_matrix = 2,
+        stabiliser_state = 3,
+        clifford = 4
+    };
+
+    struct Batch_Header
+    {
+        std::array<char, 4> magic {'F', 'S', 'T', 'B'};
+        std::uint16_t version = serialisation_version;
+        Serialised_Type type = Serialised_Type::pauli;
+        std::uint8_t word_bytes = 1;
+        std::uint32_t number_qubits = 0;
+        std::uint32_t reserved = 0;
+        std::uint64_t count = 0;
+    };
+
+    /// A column of a batch. There are items_per_object items of item_bytes bytes for each object, stored at
+    /// offset + (object_index * items_per_object + item_index) * item_bytes.
+    struct Batch_Column
+    {
+        std::string name;
+        std::size_t offset = 0;
+        std::size_t item_bytes = 0;
+        std::size_t items_per_object = 1;
+        bool is_complex = false;
+    };
+
+    /// Returns the columns of a batch of the given type, and (as the offset of a final column) its total size
+    std::vector<Batch_Column> get_batch_columns(const Serialised_Type type, const std::size_t number_qubits, const std::size_t count);
+
+    /// Return a batch of the objects, which must all be on the same number of qubits. Check matrices must have exactly
+    /// one generator per qubit.
+    std::vector<std::byte> write_batch(std::span<const Pauli> paulis);
+    std::vector<std::byte> write_batch(std::span<const Check_Matrix> check_matrices);
+    std::vector<std::byte> write_batch(std::span<const Stabiliser_State> states);
+    std::vector<std::byte> write_batch(std::span<const Clifford> cliffords);
+
+    /// A read-only view of a batch in memory (e.g. a Mapped_File), reading objects from the columns in place. The
+    /// memory must outlive the view.
+    class Batch_View
+    {
+        public:
+        /// Checks the header and size of the batch, throwing std::invalid_argument if they are not valid
+        explicit Batch_View(std::span<const std::byte> data);
+
+        const Batch_Header &header() const;
+        Serialised_Type type() const;
+        std::size_t number_qubits() const;
+        std::size_t size() const;
+
+        const std::vector<Batch_Column> &columns() const;
+
+        /// Returns the bytes of the column with the given name, throwing std::invalid_argument if there is none
+        std::span<const std::byte> column(const std::string &name) const;
+
+        /// Return the object at the given index, throwing std::invalid_argument if the batch holds another type and
+        /// std::out_of_range unless the index is less than size()
+        Pauli get_pauli(const std::size_t index) const;
+        Check_Matrix get_check_matrix(const std::size_t index) const;
+        Stabiliser_State get_stabiliser_state(const std::size_t index) const;
+        Clifford get_clifford(const std::size_t index) const;
+
+        private:
+        std::span<const std::byte> data;
+        Batch_Header batch_header;
+        std::vector<Batch_Column> batch_columns;
+
+        std::uint64_t read_word(const std::size_t column_index, const std::size_t object_index, const std::size_t item_index = 0) const;
+        std::complex<float> read_complex(const std::size_t column_index, const std::size_t object_index) const;
+        void check_type(const Serialised_Type type) const;
+        void check_index(const std::size_t index) const;
+    };
+
+    /// Return the single object stored as a batch of one (with the same restrictions as write_batch)
+    std::vector<std::byte> serialise(const Pauli &pauli);
+    std::vector<std::byte> serialise(const Check_Matrix &check_matrix);
+    std::vector<std::byte> serialise(const Stabiliser_State &state);
+    std::vector<std::byte> serialise(const Clifford &clifford);
+
+    Pauli deserialise_pauli(std::span<const std::byte> data);
+    Check_Matrix deserialise_check_matrix(std::span<const std::byte> data);
+    Stabiliser_State deserialise_stabiliser_state(std::span<const std::byte> data);
+    Clifford deserialise_clifford(std::span<const std::byte> data);
+}
+
+#endif
@@ -0,0 +1,188 @@
+#ifndef _FAST_STABILISER_SERIALISATION_PYBIND_H
+#define _FAST_STABILISER_SERIALISATION_PYBIND_H
+
+#include <pybind11/pybind11.h>
+#include <pybind11/complex.h>
+#include <pybind11/numpy.h>
+#include <pybind11/stl.h>
+
+#include <cstring>
+#include <memory>
+
+#include "serialisation.h"
+#include "util/mapped_file.h"
+
+namespace py = pybind11;
+using namespace fst;
+
+namespace fst_pybind
+{
+    /// A batch together with the memory it views: either a mapped file or the buffer of a Python object (such as
+    /// bytes, a NumPy array or a numpy.memmap), which is kept alive by the batch
+    struct Python_Batch
+    {
+        std::shared_ptr<Mapped_File> file;
+        std::shared_ptr<py::buffer_info> buffer;
+        Batch_View view;
+
+        static Python_Batch open(const std::string &path)
+        {
+            auto file = std::make_shared<Mapped_File>(path);
+            Batch_View view(file->data());
+
+            return {std::move(file), nullptr, std::move(view)};
+        }
+
+        static Python_Batch from_buffer(const py::buffer &object)
+        {
+            auto buffer = std::make_shared<py::buffer_info>(object.request());
+            py::ssize_t expected_stride = buffer->itemsize;
+
+            for (py::ssize_t axis = buffer->ndim - 1; axis >= 0; axis--)
+            {
+                if (buffer->strides[axis] != expected_stride)
+                {
+                    throw std::invalid_argument("The buffer of a batch must be contiguous.");
+                }
+
+                expected_stride *= buffer->shape[axis];
+            }
+
+            Batch_View view(std::span(static_cast<const std::byte *>(buffer->ptr), static_cast<std::size_t>(buffer->size * buffer->itemsize)));
+
+            return {nullptr, std::move(buffer), std::move(view)};
+        }
+
+        py::object get_object(const std::size_t index) const
+        {
+            switch (view.type())
+            {
+                case Serialised_Type::pauli: return py::cast(view.get_pauli(index));
+                case Serialised_Type::check_matrix: return py::cast(view.get_check_matrix(index));
+                case Serialised_Type::stabiliser_state: return py::cast(view.get_stabiliser_state(index));
+                case Serialised_Type::clifford: return py::cast(view.get_clifford(index));
+            }
+
+            return py::none();
+        }
+    };
+
+    inline std::string get_type_name(const Serialised_Type type)
+    {
+        switch (type)
+        {
+            case Serialised_Type::pauli: return "Pauli";
+            case Serialised_Type::check_matrix: return "Check_Matrix";
+            case Serialised_Type::stabiliser_state: return "Stabiliser_State";
+            case Serialised_Type::clifford: return "Clifford";
+        }
+
+        return "";
+    }
+
+    /// Returns a read-only NumPy view of the column, keeping the batch alive
+    py::array get_column_array(const py::object &batch_object, const Batch_Column &column)
+    {
+        const Python_Batch &batch = batch_object.cast<const Python_Batch &>();
+
+        py::dtype dtype = column.is_complex ? py::dtype::of<std::complex<float>>()
+            : column.item_bytes == 1 ? py::dtype::of<std::uint8_t>()
+            : column.item_bytes == 2 ? py::dtype::of<std::uint16_t>()
+            : column.item_bytes == 4 ? py::dtype::of<std::uint32_t>()
+            : py::dtype::of<std::uint64_t>();
+
+        std::vector<py::ssize_t> shape {static_cast<py::ssize_t>(batch.view.size())};
+
+        if (column.items_per_object != 1)
+        {
+            shape.push_back(static_cast<py::ssize_t>(column.items_per_object));
+        }
+
+        py::array array(dtype, shape, batch.view.column(column.name).data(), batch_object);
+        array.attr("setflags")(py::arg("write") = false);
+
+        return array;
+    }
+
+    template <typename T>
+    py::array_t<std::uint8_t> write_batch_array(const std::vector<T> &objects)
+    {
+        const std::vector<std::byte> bytes = write_batch(std::span<const T>(objects));
+
+        py::array_t<std::uint8_t> array(static_cast<py::ssize_t>(bytes.size()));
+        std::memcpy(array.mutable_data(), bytes.data(), bytes.size());
+
+        return array;
+    }
+
+    template <typename T>
+    void save_batch(const std::string &path, const std::vector<T> &objects)
+    {
+        write_file(path, write_batch(std::span<const T>(objects)));
+    }
+
+    void init_serialisation(py::module_ &m)
+    {
+        const char *write_batch_doc = "Returns a batch of the objects (which must all have the same type and number of qubits) in the binary format, as a NumPy array of dtype uint8";
+        m.def("write_batch", &write_batch_array<Pauli>, py::arg("objects"), write_batch_doc);
+        m.def("write_batch", &write_batch_array<Check_Matrix>, py::arg("objects"), write_batch_doc);
+        m.def("write_batch", &write_batch_array<Stabiliser_State>, py::arg("objects"), write_batch_doc);
+        m.def("write_batch", &write_batch_array<Clifford>, py::arg("objects"), write_batch_doc);
+
+        const char *save_batch_doc = "Writes a batch of the objects (which must all have the same type and number of qubits) in the binary format to the file at the given path";
+        m.def("save_batch", &save_batch<Pauli>, py::arg("path"), py::arg("objects"), save_batch_doc);
+        m.def("save_batch", &save_batch<Check_Matrix>, py::arg("path"), py::arg("objects"), save_batch_doc);
+        m.def("save_batch", &save_batch<Stabiliser_State>, py::arg("path"), py::arg("objects"), save_batch_doc);
+        m.def("save_batch", &save_batch<Clifford>, py::arg("path"), py::arg("objects"), save_batch_doc);
+
+        py::class_<Python_Batch>(m, "Batch")
+            .def(py::init(&Python_Batch::from_buffer), py::arg("buffer"), "Views a batch in the binary format held by a contiguous buffer, e.g. bytes, a NumPy array or a numpy.memmap, without copying it")
+            .def_static("open", &Python_Batch::open, py::arg("path"), "Memory maps the batch file at the given path, so objects and columns are read in place")
+            .def_property_readonly("type", [](const Python_Batch &batch) { return get_type_name(batch.view.type()); }, "str\t\tThe name of the class of the objects")
+            .def_property_readonly("number_qubits", [](const Python_Batch &batch) { return batch.view.number_qubits(); }, "int\t\tThe number of qubits of the objects")
+            .def("__len__", [](const Python_Batch &batch) { return batch.view.size(); })
+            .def("__getitem__", [](const Python_Batch &batch, py::ssize_t index)
+                {
+                    // Indices past the end are rejected by the view, as std::out_of_range becomes IndexError
+                    if (index < 0)
+                    {
+                        index += static_cast<py::ssize_t>(batch.view.size());
+                    }
+
+                    if (index < 0)
+                    {
+                        throw py::index_error("Batch index out of range");
+                    }
+
+                    return batch.get_object(static_cast<std::size_t>(index));
+                },
+                py::arg("index"))
+            .def("to_list", [](const Python_Batch &batch)
+                {
+                    py::list objects;
+
+                    for (std::size_t i = 0; i < batch.view.size(); i++)
+                    {
+                        objects.append(batch.get_object(i));
+                    }
+
+                    return objects;
+                },
+                "Returns the list of all the objects in the batch")
+            .def("columns", [](const py::object &self)
+                {
+                    py::dict columns;
+
+                    for (const Batch_Column &column : self.cast<const Python_Batch &>().view.columns())
+                    {
+                        columns[py::str(column.name)] = get_column_array(self, column);
+                    }
+
+                    return columns;
+                },
+                "Returns a dict from the names of the columns to read-only NumPy views of them, of shape (count,) or (count, number_qubits). F_2 vectors are packed into unsigned integers, and signs and imaginary bits into masks with i-th bit that of the i-th pauli")
+            .doc() = "A read-only batch of objects of the same type and number of qubits in the binary format, read in place from a buffer or a memory mapped file";
+    }
+}
+
+#endif
@@ -0,0 +1,299 @@
+#include "circuit.h"
+
+#include "util/f2_helper.h"
+
+#include <array>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+namespace fst
+{
+	namespace
+	{
+		constexpr std::array<Gate, 16> gates {
+			Gate::h, Gate::s, Gate::s_dagger, Gate::x, Gate::y, Gate::z, Gate::cnot, Gate::cz, Gate::swap, Gate::measure, Gate::reset,
+			Gate::x_error, Gate::y_error, Gate::z_error, Gate::depolarise1, Gate::depolarise2
+		};
+
+		/// Whether the second operation undoes the first
+		bool is_inverse(const Operation &first, const Operation &second)
+		{
+			const bool same_qubits = first.first_qubit == second.first_qubit && first.second_qubit == second.second_qubit;
+			const bool swapped_qubits = first.first_qubit == second.second_qubit && first.second_qubit == second.first_qubit;
+
+			switch (first.gate)
+			{
+				case Gate::h:
+				case Gate::x:
+				case Gate::y:
+				case Gate::z:
+				case Gate::cnot:
+					return second.gate == first.gate && same_qubits;
+				case Gate::cz:
+				case Gate::swap:
+					return second.gate == first.gate && (same_qubits || swapped_qubits);
+				case Gate::s:
+					return second.gate == Gate::s_dagger && same_qubits;
+				case Gate::s_dagger:
+					return second.gate == Gate::s && same_qubits;
+				default:
+					return false;
+			}
+		}
+
+		/// Calls function(index) for each index below size with the bits of set_mask set and those of clear_mask clear
+		template <typename Function>
+		void for_each_index(const std::size_t size, const std::size_t set_mask, const std::size_t clear_mask, Function &&function)
+		{
+			for (std::size_t index = 0; index < size; index++)
+			{
+				if ((index & (set_mask | clear_mask)) == set_mask)
+				{
+					function(index);
+				}
+			}
+		}
+	}
+
+	std::string_view gate_name(const Gate gate)
+	{
+		switch (gate)
+		{
+			case Gate::h: return "H";
+			case Gate::s: return "S";
+			case Gate::s_dagger: return "S_DAG";
+			case Gate::x: return "X";
+			case Gate::y: return "Y";
+			case Gate::z: return "Z";
+			case Gate::cnot: return "CNOT";
+			case Gate::cz: return "CZ";
+			case Gate::swap: return "SWAP";
+			case Gate::measure: return "M";
+			case Gate::reset: return "R";
+			case Gate::x_error: return "X_ERROR";
+			case Gate::y_error: return "Y_ERROR";
+			case Gate::z_error: return "Z_ERROR";
+			case Gate::depolarise1: return "DEPOLARIZE1";
+			case Gate::depolarise2: return "DEPOLARIZE2";
+		}
+
+		throw std::invalid_argument("Unknown gate.");
+	}
+
+	std::optional<Gate> gate_from_name(const std::string_view name)
+	{
+		for (const Gate gate : gates)
+		{
+			if (gate_name(gate) == name)
+			{
+				return gate;
+			}
+		}
+
+		return std::nullopt;
+	}
+
+	bool is_two_qubit_gate(const Gate gate)
+	{
+		return gate == Gate::cnot || gate == Gate::cz || gate == Gate::swap || gate == Gate::depolarise2;
+	}
+
+	bool is_noise_channel(const Gate gate)
+	{
+		return gate == Gate::x_error || gate == Gate::y_error || gate == Gate::z_error || gate == Gate::depolarise1 || gate == Gate::depolarise2;
+	}
+
+	Circuit::Circuit(const std::size_t number_qubits)
+		: number_qubits(number_qubits)
+	{
+	}
+
+	void Circuit::append(const Gate gate, std::span<const std::size_t> targets, const float probability)
+	{
+		if (!(probability >= 0 && probability <= 1) || (probability != 0 && !is_noise_channel(gate)))
+		{
+			throw std::invalid_argument("The probability must be in [0, 1], and can only be given for noise channels.");
+		}
+
+		const std::size_t begin = operations.size();
+
+		if (!is_two_qubit_gate(gate))
+		{
+			for (const std::size_t qubit : targets)
+			{
+				append(gate, qubit);
+			}
+		}
+		else
+		{
+			if (targets.size() % 2 != 0)
+			{
+				throw std::invalid_argument("The two qubit gate " + std::string(gate_name(gate)) + " needs an even number of targets.");
+			}
+
+			for (std::size_t i = 0; i < targets.size(); i += 2)
+			{
+				append(gate, targets[i], targets[i + 1]);
+			}
+		}
+
+		for (std::size_t i = begin; i < operations.size(); i++)
+		{
+			operations[i].probability = probability;
+		}
+	}
+
+	void Circuit::append(const Gate gate, const std::size_t qubit)
+	{
+		if (is_two_qubit_gate(gate))
+		{
+			throw std::invalid_argument("The two qubit gate " + std::string(gate_name(gate)) + " needs two targets.");
+		}
+
+		if (qubit >= number_qubits)
+		{
+			throw std::invalid_argument("The target of the gate must be less than the number of qubits.");
+		}
+
+		operations.push_back({gate, static_cast<std::uint32_t>(qubit), 0, 0});
+		number_measurements += gate == Gate::measure;
+	}
+
+	void Circuit::append(const Gate gate, const std::size_t first_qubit, const std::size_t second_qubit)
+	{
+		if (!is_two_qubit_gate(gate))
+		{
+			throw std::invalid_argument("The single qubit gate " + std::string(gate_name(gate)) + " needs one target.");
+		}
+
+		if (first_qubit >= number_qubits || second_qubit >= number_qubits || first_qubit == second_qubit)
+		{
+			throw std::invalid_argument("The targets of the gate must be distinct and less than the number of qubits.");
+		}
+
+		operations.push_back({gate, static_cast<std::uint32_t>(first_qubit), static_cast<std::uint32_t>(second_qubit), 0});
+	}
+
+	Circuit cancel_inverse_gates(const Circuit &circuit)
+	{
+		std::vector<Operation> operations;
+		std::vector<bool> removed;
+		operations.reserve(circuit.operations.size());
+		removed.reserve(circuit.operations.size());
+
+		// The indices of the remaining operations on each qubit, most recent last
+		std::vector<std::vector<std::size_t>> qubit_operations(circuit.number_qubits);
+
+		for (const Operation &operation : circuit.operations)
+		{
+			std::vector<std::size_t> &first_operations = qubit_operations[operation.first_qubit];
+			const bool two_qubit_gate = is_two_qubit_gate(operation.gate);
+
+			if (!first_operations.empty() && is_inverse(operations[first_operations.back()], operation))
+			{
+				const std::size_t previous = first_operations.back();
+				std::vector<std::size_t> &second_operations = qubit_operations[operation.second_qubit];
+
+				if (!two_qubit_gate || (!second_operations.empty() && second_operations.back() == previous))
+				{
+					removed[previous] = true;
+					first_operations.pop_back();
+
+					if (two_qubit_gate)
+					{
+						second_operations.pop_back();
+					}
+
+					continue;
+				}
+			}
+
+			first_operations.push_back(operations.size());
+
+			if (two_qubit_gate)
+			{
+				qubit_operations[operation.second_qubit].push_back(operations.size());
+			}
+
+			operations.push_back(operation);
+			removed.push_back(false);
+		}
+
+		Circuit cancelled(circuit.number_qubits);
+		cancelled.number_measurements = circuit.number_measurements;
+
+		for (std::size_t i = 0; i < operations.size(); i++)
+		{
+			if (!removed[i])
+			{
+				cancelled.operations.push_back(operations[i]);
+			}
+		}
+
+		return cancelled;
+	}
+
+	void apply_circuit(const Circuit &circuit, std::span<std::complex<float>> statevector)
+	{
+		if (circuit.number_qubits >= 64 || statevector.size() != integral_pow_2(circuit.number_qubits))
+		{
+			throw std::invalid_argument("The state vector must have length 2^n for the n qubits of the circuit.");
+		}
+
+		constexpr std::complex<float> i(0, 1);
+		const float root_half = float(std::sqrt(0.5));
+		const std::size_t size = statevector.size();
+
+		for (const Operation &operation : circuit.operations)
+		{
+			const std::size_t first = integral_pow_2(std::size_t(operation.first_qubit));
+			const std::size_t second = integral_pow_2(std::size_t(operation.second_qubit));
+
+			switch (operation.gate)
+			{
+				case Gate::h:
+					for_each_index(size, 0, first, [&](const std::size_t index)
+						{
+							const std::complex<float> zero = statevector[index];
+							const std::complex<float> one = statevector[index | first];
+							statevector[index] = root_half * (zero + one);
+							statevector[index | first] = root_half * (zero - one);
+						});
+					break;
+				case Gate::s:
+					for_each_index(size, first, 0, [&](const std::size_t index) { statevector[index] *= i; });
+					break;
+				case Gate::s_dagger:
+					for_each_index(size, first, 0, [&](const std::size_t index) { statevector[index] *= -i; });
+					break;
+				case Gate::x:
+					for_each_index(size, 0, first, [&](const std::size_t index) { std::swap(statevector[index], statevector[index | first]); });
+					break;
+				case Gate::y:
+					for_each_index(size, 0, first, [&](const std::size_t index)
+						{
+							const std::complex<float> zero = statevector[index];
+							statevector[index] = -i * statevector[index | first];
+							statevector[index | first] = i * zero;
+						});
+					break;
+				case Gate::z:
+					for_each_index(size, first, 0, [&](const std::size_t index) { statevector[index] = -statevector[index]; });
+					break;
+				case Gate::cnot:
+					for_each_index(size, first, second, [&](const std::size_t index) { std::swap(statevector[index], statevector[index | second]); });
+					break;
+				case Gate::cz:
+					for_each_index(size, first | second, 0, [&](const std::size_t index) { statevector[index] = -statevector[index]; });
+					break;
+				case Gate::swap:
+					for_each_index(size, first, second, [&](const std::size_t index) { std::swap(statevector[index], statevector[index ^ first ^ second]); });
+					break;
+				default:
+					throw std::invalid_argument("Only the unitary gates of a circuit can be applied to a state vector.");
+			}
+		}
+	}
+}
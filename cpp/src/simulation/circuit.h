@@ -0,0 +1,91 @@
+#ifndef _FAST_STABILISER_CIRCUIT_H
+#define _FAST_STABILISER_CIRCUIT_H
+
+#include <complex>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <vector>
+
+namespace fst
+{
+	/// The operations of a Clifford circuit. Measurements and resets are in the computational basis. The noise
+	/// channels apply X, Y or Z with the probability of the operation, or (for depolarising noise) a uniformly random
+	/// non-identity pauli on one or two qubits.
+	enum class Gate : std::uint8_t
+	{
+		h,
+		s,
+		s_dagger,
+		x,
+		y,
+		z,
+		cnot,
+		cz,
+		swap,
+		measure,
+		reset,
+		x_error,
+		y_error,
+		z_error,
+		depolarise1,
+		depolarise2
+	};
+
+	/// The names of the gates are those used by stim: H, S, S_DAG, X, Y, Z, CNOT, CZ, SWAP, M, R, X_ERROR, Y_ERROR,
+	/// Z_ERROR, DEPOLARIZE1 and DEPOLARIZE2
+	std::string_view gate_name(const Gate gate);
+	std::optional<Gate> gate_from_name(const std::string_view name);
+
+	bool is_two_qubit_gate(const Gate gate);
+	bool is_noise_channel(const Gate gate);
+
+	/// A gate and the qubits it acts on. For CNOT the first qubit is the control, and for single qubit
+	/// operations the second qubit is unused. The probability is only used by the noise channels.
+	struct Operation
+	{
+		Gate gate;
+		std::uint32_t first_qubit;
+		std::uint32_t second_qubit;
+		float probability;
+
+		bool operator==(const Operation &other) const = default;
+	};
+
+	/// A Clifford circuit with computational basis measurements and resets, stored as a flat list of operations
+	struct Circuit
+	{
+		std::size_t number_qubits = 0;
+		std::vector<Operation> operations;
+
+		/// The number of measurements, i.e. the length of the measurement record of a run of the circuit
+		std::size_t number_measurements = 0;
+
+		Circuit() = default;
+		explicit Circuit(const std::size_t number_qubits);
+
+		/// Appends the gate on each of the targets, or on each consecutive pair of targets for two qubit gates,
+		/// as stim does. Throws if a target is out of range, if a pair of targets are the same qubit, or if the
+		/// probability is not in [0, 1], or is non-zero for a gate other than a noise channel.
+		void append(const Gate gate, std::span<const std::size_t> targets, const float probability = 0);
+
+		void append(const Gate gate, const std::size_t qubit);
+		void append(const Gate gate, const std::size_t first_qubit, const std::size_t second_qubit);
+
+		bool operator==(const Circuit &other) const = default;
+	};
+
+	/// Returns the circuit with pairs of mutually inverse gates removed, when no other operation acts on their
+	/// qubits in between (such as H H, S S_DAG, or CNOT CNOT on the same control and target), repeatedly, in
+	/// O(number of operations) time. Measurements, resets and noise channels are kept, and block cancellation
+	/// across them.
+	Circuit cancel_inverse_gates(const Circuit &circuit);
+
+	/// Applies the gates of the circuit in place to the state vector of length 2^n, in O(2^n) time per gate.
+	/// Throws if the circuit has a measurement, reset or noise channel, or the wrong number of qubits.
+	void apply_circuit(const Circuit &circuit, std::span<std::complex<float>> statevector);
+}
+
+#endif
@@ -0,0 +1,72 @@
+#ifndef _FAST_STABILISER_CIRCUIT_PYBIND_H
+#define _FAST_STABILISER_CIRCUIT_PYBIND_H
+
+#include <pybind11/pybind11.h>
+#include <pybind11/complex.h>
+#include <pybind11/numpy.h>
+#include <pybind11/stl.h>
+
+#include <complex>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "circuit.h"
+
+namespace py = pybind11;
+using namespace fst;
+
+namespace fst_pybind
+{
+	Gate gate_from_python_name(const std::string &name)
+	{
+		const std::optional<Gate> gate = fst::gate_from_name(name);
+
+		if (!gate)
+		{
+			throw std::invalid_argument("Unknown gate " + name + ".");
+		}
+
+		return *gate;
+	}
+
+	void init_circuit(py::module_ &m)
+	{
+		py::class_<Circuit>(m, "Circuit")
+			.def(py::init<const std::size_t>(), py::arg("number_qubits"))
+			.def_readonly("number_qubits", &Circuit::number_qubits, "int\t\tThe number of qubits")
+			.def_readonly("number_measurements", &Circuit::number_measurements, "int\t\tThe number of measurements, i.e. the length of the measurement record of a run")
+			.def("append", [](Circuit &circuit, const std::string &name, const std::vector<std::size_t> &targets, const float probability) { circuit.append(gate_from_python_name(name), targets, probability); }, py::arg("name"), py::arg("targets"), py::arg("probability") = 0, "Appends the gate with the given name (one of H, S, S_DAG, X, Y, Z, CNOT, CZ, SWAP, M and R, or the noise channels X_ERROR, Y_ERROR, Z_ERROR, DEPOLARIZE1 and DEPOLARIZE2 with the given probability) on each of the targets, or on each consecutive pair of targets for the two qubit gates CNOT (control first), CZ, SWAP and DEPOLARIZE2")
+			.def("append", [](Circuit &circuit, const std::string &name, const std::size_t target) { circuit.append(gate_from_python_name(name), target); }, py::arg("name"), py::arg("target"), "Appends the single qubit gate with the given name on the target")
+			.def("get_operations", [](const Circuit &circuit)
+				{
+					std::vector<std::pair<std::string, std::vector<std::size_t>>> operations;
+					operations.reserve(circuit.operations.size());
+
+					for (const Operation &operation : circuit.operations)
+					{
+						std::vector<std::size_t> targets {operation.first_qubit};
+
+						if (is_two_qubit_gate(operation.gate))
+						{
+							targets.push_back(operation.second_qubit);
+						}
+
+						operations.emplace_back(gate_name(operation.gate), std::move(targets));
+					}
+
+					return operations;
+				}, "Returns the operations as a list of (name, targets) tuples")
+			.def("__len__", [](const Circuit &circuit) { return circuit.operations.size(); })
+			.def("__eq__", &Circuit::operator==, py::arg("other"))
+			.doc() = "A Clifford circuit with computational basis measurements (M), resets (R) and pauli noise channels, stored as a flat list of operations";
+
+		m.def("cancel_inverse_gates", &cancel_inverse_gates, py::arg("circuit"), "Returns the circuit with pairs of mutually inverse gates removed, when no other operation acts on their qubits in between");
+		m.def("apply_circuit", [](const Circuit &circuit, py::array_t<std::complex<float>, py::array::c_style> statevector)
+			{ apply_circuit(circuit, std::span(statevector.mutable_data(), static_cast<std::size_t>(statevector.size()))); },
+			py::arg("circuit"), py::arg("statevector").noconvert(), "Applies the gates of the circuit in place to the contiguous numpy array of dtype complex64 of length 2^n, in O(2^n) time per gate");
+	}
+}
+
+#endif
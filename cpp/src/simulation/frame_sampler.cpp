@@ -0,0 +1,319 @@
+#include "frame_sampler.h"
+#include "tableau.h"
+#include "util/parallel.h"
+#include "util/stats.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <functional>
+#include <stdexcept>
+
+namespace fst
+{
+	namespace
+	{
+		constexpr std::uint64_t broadcast(const bool bit)
+		{
+			return std::uint64_t(0) - bit;
+		}
+
+		/// Calls function(bit) for each bit in [0, number_bits) chosen independently with the given probability. The
+		/// gaps between the chosen bits are geometric, so this takes O(probability * number_bits + 1) random numbers.
+		template <typename Function>
+		void for_each_random_bit(const std::size_t number_bits, const double probability, Random_Generator &generator, Function &&function)
+		{
+			if (probability <= 0)
+			{
+				return;
+			}
+
+			if (probability >= 1)
+			{
+				for (std::size_t bit = 0; bit < number_bits; bit++)
+				{
+					function(bit);
+				}
+
+				return;
+			}
+
+			const double log_complement = std::log1p(-probability);
+
+			for (std::size_t bit = 0; ; bit++)
+			{
+				const double gap = std::floor(std::log1p(-generator.random_unit()) / log_complement);
+
+				if (gap >= double(number_bits - bit))
+				{
+					return;
+				}
+
+				bit += static_cast<std::size_t>(gap);
+				function(bit);
+			}
+		}
+
+		/// Multiplies the frame of the shot by I, X, Y or Z as the pauli is 0, 1, 2 or 3
+		void flip_pauli(std::uint64_t *x_frame, std::uint64_t *z_frame, const std::size_t shot, const std::uint64_t pauli)
+		{
+			const std::uint64_t bit = std::uint64_t(1) << (shot % 64);
+
+			x_frame[shot / 64] ^= broadcast(pauli == 1 || pauli == 2) & bit;
+			z_frame[shot / 64] ^= broadcast(pauli >= 2) & bit;
+		}
+
+		/// Transposes the 64 x 64 bit matrix with row i in word i and column j in bit j, by swapping the off-diagonal
+		/// blocks of ever smaller sizes
+		void transpose_bits(std::array<std::uint64_t, 64> &rows)
+		{
+			constexpr std::array<std::uint64_t, 6> masks {
+				0x00000000ffffffff, 0x0000ffff0000ffff, 0x00ff00ff00ff00ff, 0x0f0f0f0f0f0f0f0f, 0x3333333333333333, 0x5555555555555555
+			};
+
+			for (std::size_t level = 0, size = 32; level < masks.size(); level++, size /= 2)
+			{
+				for (std::size_t row = 0; row < 64; row++)
+				{
+					if ((row & size) == 0)
+					{
+						const std::uint64_t swapped = ((rows[row] >> size) ^ rows[row + size]) & masks[level];
+						rows[row] ^= swapped << size;
+						rows[row + size] ^= swapped;
+					}
+				}
+			}
+		}
+	}
+
+	Frame_Sampler::Frame_Sampler(const Circuit &circuit, Random_Generator &generator, const std::size_t shots_per_block)
+		: circuit(circuit), block_words(shots_per_block / 64)
+	{
+		if (shots_per_block % 64 != 0 || block_words == 0 || block_words > 8)
+		{
+			throw std::invalid_argument("The number of shots per block must be a multiple of 64 from 64 to 512.");
+		}
+
+		Tableau tableau(circuit.number_qubits);
+		reference_record.reserve(circuit.number_measurements);
+
+		for (const Operation &operation : circuit.operations)
+		{
+			if (!is_noise_channel(operation.gate))
+			{
+				tableau.apply(operation, generator, reference_record);
+			}
+		}
+	}
+
+	std::size_t Frame_Sampler::record_bytes() const
+	{
+		return (circuit.number_measurements + 7) / 8;
+	}
+
+	void Frame_Sampler::sample_block(Random_Generator &generator, std::vector<std::uint64_t> &x_frames, std::vector<std::uint64_t> &z_frames,
+		std::vector<std::uint64_t> &measurement_frames) const
+	{
+		const std::size_t number_bits = 64 * block_words;
+
+		const auto x_frame = [&](const std::size_t qubit) { return x_frames.data() + qubit * block_words; };
+		const auto z_frame = [&](const std::size_t qubit) { return z_frames.data() + qubit * block_words; };
+
+		// A Z on a qubit in |0> does nothing, so each shot starts with a random Z frame. After a gate turns it into
+		// an X frame, it makes the outcomes that are random in the reference run random in the shots.
+		const auto randomise_z_frame = [&](const std::size_t qubit)
+		{
+			std::generate_n(z_frame(qubit), block_words, std::ref(generator));
+		};
+
+		x_frames.assign(circuit.number_qubits * block_words, 0);
+		z_frames.resize(circuit.number_qubits * block_words);
+		measurement_frames.resize(circuit.number_measurements * block_words);
+
+		for (std::size_t q = 0; q < circuit.number_qubits; q++)
+		{
+			randomise_z_frame(q);
+		}
+
+		std::size_t measurement = 0;
+
+		for (const Operation &operation : circuit.operations)
+		{
+			std::uint64_t *const first_x = x_frame(operation.first_qubit);
+			std::uint64_t *const first_z = z_frame(operation.first_qubit);
+			std::uint64_t *const second_x = x_frame(operation.second_qubit);
+			std::uint64_t *const second_z = z_frame(operation.second_qubit);
+
+			switch (operation.gate)
+			{
+				case Gate::h:
+					std::swap_ranges(first_x, first_x + block_words, first_z);
+					break;
+
+				case Gate::s:
+				case Gate::s_dagger:
+					for (std::size_t w = 0; w < block_words; w++)
+					{
+						first_z[w] ^= first_x[w];
+					}
+					break;
+
+				// The frames do not keep track of signs
+				case Gate::x:
+				case Gate::y:
+				case Gate::z:
+					break;
+
+				case Gate::cnot:
+					for (std::size_t w = 0; w < block_words; w++)
+					{
+						second_x[w] ^= first_x[w];
+						first_z[w] ^= second_z[w];
+					}
+					break;
+
+				case Gate::cz:
+					for (std::size_t w = 0; w < block_words; w++)
+					{
+						first_z[w] ^= second_x[w];
+						second_z[w] ^= first_x[w];
+					}
+					break;
+
+				case Gate::swap:
+					std::swap_ranges(first_x, first_x + block_words, second_x);
+					std::swap_ranges(first_z, first_z + block_words, second_z);
+					break;
+
+				case Gate::measure:
+				{
+					// An X frame flips the outcome of the reference run, and the Z frame is lost in the collapse
+					std::uint64_t *const record = measurement_frames.data() + measurement * block_words;
+					const std::uint64_t reference = broadcast(reference_record[measurement]);
+
+					for (std::size_t w = 0; w < block_words; w++)
+					{
+						record[w] = first_x[w] ^ reference;
+					}
+
+					randomise_z_frame(operation.first_qubit);
+					measurement++;
+					break;
+				}
+
+				case Gate::reset:
+					std::fill_n(first_x, block_words, 0);
+					randomise_z_frame(operation.first_qubit);
+					break;
+
+				case Gate::x_error:
+					for_each_random_bit(number_bits, operation.probability, generator, [&](const std::size_t shot) { flip_pauli(first_x, first_z, shot, 1); });
+					break;
+
+				case Gate::y_error:
+					for_each_random_bit(number_bits, operation.probability, generator, [&](const std::size_t shot) { flip_pauli(first_x, first_z, shot, 2); });
+					break;
+
+				case Gate::z_error:
+					for_each_random_bit(number_bits, operation.probability, generator, [&](const std::size_t shot) { flip_pauli(first_x, first_z, shot, 3); });
+					break;
+
+				case Gate::depolarise1:
+					for_each_random_bit(number_bits, operation.probability, generator, [&](const std::size_t shot)
+						{
+							flip_pauli(first_x, first_z, shot, 1 + generator.random_below(3));
+						});
+					break;
+
+				case Gate::depolarise2:
+					for_each_random_bit(number_bits, operation.probability, generator, [&](const std::size_t shot)
+						{
+							const std::uint64_t paulis = 1 + generator.random_below(15);
+							flip_pauli(first_x, first_z, shot, paulis & 3);
+							flip_pauli(second_x, second_z, shot, paulis >> 2);
+						});
+					break;
+			}
+		}
+	}
+
+	void Frame_Sampler::sample(const std::size_t number_shots, Random_Generator &generator, std::span<std::uint8_t> records) const
+	{
+		FST_TIME_SCOPE(frame_sampling);
+
+		const std::size_t bytes = record_bytes();
+
+		if (records.size() != number_shots * bytes)
+		{
+			throw std::invalid_argument("The buffer must have the number of shots times the record size bytes.");
+		}
+
+		if (bytes == 0)
+		{
+			return;
+		}
+
+		const std::size_t shots_per_block = 64 * block_words;
+		const std::size_t number_blocks = (number_shots + shots_per_block - 1) / shots_per_block;
+
+		std::vector<std::uint64_t> seeds(number_blocks);
+		std::generate(seeds.begin(), seeds.end(), std::ref(generator));
+
+		parallel_for(number_blocks, 1, [&](const std::size_t begin, const std::size_t end)
+			{
+				std::vector<std::uint64_t> x_frames;
+				std::vector<std::uint64_t> z_frames;
+				std::vector<std::uint64_t> measurement_frames;
+
+				for (std::size_t block = begin; block < end; block++)
+				{
+					Random_Generator block_generator(seeds[block]);
+					sample_block(block_generator, x_frames, z_frames, measurement_frames);
+
+					// Transpose the records of the block from by measurement to by shot, 64 x 64 bits at a time
+					for (std::size_t first_measurement = 0; first_measurement < circuit.number_measurements; first_measurement += 64)
+					{
+						const std::size_t number_measurements = std::min<std::size_t>(64, circuit.number_measurements - first_measurement);
+						const std::size_t first_byte = first_measurement / 8;
+						const std::size_t number_bytes = std::min<std::size_t>(8, bytes - first_byte);
+
+						for (std::size_t w = 0; w < block_words; w++)
+						{
+							const std::size_t first_shot = block * shots_per_block + 64 * w;
+
+							if (first_shot >= number_shots)
+							{
+								break;
+							}
+
+							std::array<std::uint64_t, 64> rows {};
+
+							for (std::size_t m = 0; m < number_measurements; m++)
+							{
+								rows[m] = measurement_frames[(first_measurement + m) * block_words + w];
+							}
+
+							transpose_bits(rows);
+
+							for (std::size_t shot = 0; shot < std::min<std::size_t>(64, number_shots - first_shot); shot++)
+							{
+								std::uint8_t *const record = records.data() + (first_shot + shot) * bytes + first_byte;
+
+								for (std::size_t byte = 0; byte < number_bytes; byte++)
+								{
+									record[byte] = static_cast<std::uint8_t>(rows[shot] >> (8 * byte));
+								}
+							}
+						}
+					}
+				}
+			});
+	}
+
+	std::vector<std::uint8_t> Frame_Sampler::sample(const std::size_t number_shots, Random_Generator &generator) const
+	{
+		std::vector<std::uint8_t> records(number_shots * record_bytes());
+		sample(number_shots, generator, records);
+		return records;
+	}
+}
@@ -0,0 +1,54 @@
+#ifndef _FAST_STABILISER_FRAME_SAMPLER_H
+#define _FAST_STABILISER_FRAME_SAMPLER_H
+
+#include "circuit.h"
+#include "util/random.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace fst
+{
+	/// Samples many shots of a Clifford circuit with pauli noise, in the manner of stim. The circuit is run once
+	/// without noise on a Tableau to get a reference measurement record, and each shot is then described by a pauli
+	/// frame: the pauli that takes the reference run to the shot. Frames only need their x and z bits (not their
+	/// sign), so a gate conjugates the frames of a block of shots with a few word operations on each of its qubits.
+	///
+	/// The frames of a block are stored by qubit, with the shots packed into words, so a block of 64 to 512 shots
+	/// is propagated through the circuit at once. Blocks are independent, and are spread over number_threads()
+	/// threads.
+	struct Frame_Sampler
+	{
+		Circuit circuit;
+		std::vector<bool> reference_record;
+
+		/// Runs the circuit without noise to get the reference record. Throws unless the number of shots per
+		/// block is a multiple of 64 from 64 to 512.
+		Frame_Sampler(const Circuit &circuit, Random_Generator &generator, const std::size_t shots_per_block = 512);
+
+		/// The number of bytes holding the measurement record of one shot
+		std::size_t record_bytes() const;
+
+		/// Samples the measurement records of the shots into the buffer, which must have number_shots *
+		/// record_bytes() bytes. The record of each shot is record_bytes() consecutive bytes, with measurement
+		/// m in bit m % 8 of byte m / 8, as in stim's packed format. Throws if the buffer has the wrong size.
+		///
+		/// Each block of shots draws from its own generator, seeded from the given one, so the samples depend
+		/// only on the generator and not on the number of threads.
+		void sample(const std::size_t number_shots, Random_Generator &generator, std::span<std::uint8_t> records) const;
+		std::vector<std::uint8_t> sample(const std::size_t number_shots, Random_Generator &generator) const;
+
+		private:
+
+		std::size_t block_words;
+
+		/// Propagates the frames of a block of shots through the circuit, leaving the records of the block in
+		/// measurement_frames, with the shots of measurement m in the block_words words from m * block_words
+		void sample_block(Random_Generator &generator, std::vector<std::uint64_t> &x_frames, std::vector<std::uint64_t> &z_frames,
+			std::vector<std::uint64_t> &measurement_frames) const;
+	};
+}
+
+#endif
@@ -0,0 +1,56 @@
+#ifndef _FAST_STABILISER_FRAME_SAMPLER_PYBIND_H
+#define _FAST_STABILISER_FRAME_SAMPLER_PYBIND_H
+
+#include <pybind11/pybind11.h>
+#include <pybind11/numpy.h>
+#include <pybind11/stl.h>
+
+#include <span>
+#include <stdexcept>
+
+#include "frame_sampler.h"
+
+namespace py = pybind11;
+using namespace fst;
+
+namespace fst_pybind
+{
+	void init_frame_sampler(py::module_ &m)
+	{
+		py::class_<Frame_Sampler>(m, "Frame_Sampler")
+			.def(py::init<const Circuit &, Random_Generator &, const std::size_t>(), py::arg("circuit"), py::arg("generator"), py::arg("shots_per_block") = 512,
+				"Runs the circuit once without noise to get the reference record. The number of shots per block must be a multiple of 64 from 64 to 512")
+			.def_readonly("reference_record", &Frame_Sampler::reference_record, "list[bool]\t\tThe measurement record of the noiseless reference run")
+			.def_property_readonly("record_bytes", &Frame_Sampler::record_bytes, "int\t\tThe number of bytes holding the measurement record of one shot")
+			.def("sample", [](const Frame_Sampler &sampler, const std::size_t number_shots, Random_Generator &generator)
+				{
+					py::array_t<std::uint8_t> records({static_cast<py::ssize_t>(number_shots), static_cast<py::ssize_t>(sampler.record_bytes())});
+					const std::span<std::uint8_t> buffer(records.mutable_data(), static_cast<std::size_t>(records.size()));
+
+					py::gil_scoped_release release;
+					sampler.sample(number_shots, generator, buffer);
+
+					return records;
+				},
+				py::arg("number_shots"), py::arg("generator"),
+				"Samples the measurement records of the shots as a numpy array of dtype uint8 and shape (number_shots, record_bytes), with measurement m of a shot in bit m % 8 of byte m // 8, as in stim's packed format")
+			.def("sample_into", [](const Frame_Sampler &sampler, py::array_t<std::uint8_t, py::array::c_style> records, Random_Generator &generator)
+				{
+					if (records.ndim() != 2 || static_cast<std::size_t>(records.shape(1)) != sampler.record_bytes())
+					{
+						throw std::invalid_argument("The records must have shape (number_shots, record_bytes).");
+					}
+
+					const std::size_t number_shots = static_cast<std::size_t>(records.shape(0));
+					const std::span<std::uint8_t> buffer(records.mutable_data(), static_cast<std::size_t>(records.size()));
+
+					py::gil_scoped_release release;
+					sampler.sample(number_shots, generator, buffer);
+				},
+				py::arg("records").noconvert(), py::arg("generator"),
+				"Samples the measurement records of one shot per row into the C-contiguous numpy array of dtype uint8 and shape (number_shots, record_bytes), in the format of sample")
+			.doc() = "Samples shots of a Clifford circuit with pauli noise by propagating bit-packed pauli frames, relative to one noiseless reference run, through the circuit in blocks of shots spread over the threads";
+	}
+}
+
+#endif
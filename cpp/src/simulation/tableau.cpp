@@ -0,0 +1,638 @@
+#include "tableau.h"
+#include "stabiliser_state/check_matrix.h"
+#include "stabiliser_state/stabiliser_state.h"
+#include "util/f2_helper.h"
+#include "util/scratch_arena.h"
+#include "util/stats.h"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <memory_resource>
+#include <stdexcept>
+#include <utility>
+
+namespace fst
+{
+	namespace
+	{
+		constexpr std::uint64_t all_bits = ~std::uint64_t(0);
+
+		std::uint64_t broadcast(const bool bit)
+		{
+			return bit ? all_bits : 0;
+		}
+
+		/// Bit i of the result is the parity of bits 0, ..., i - 1 of word
+		std::uint64_t exclusive_prefix_parity(std::uint64_t word)
+		{
+			word ^= word << 1;
+			word ^= word << 2;
+			word ^= word << 4;
+			word ^= word << 8;
+			word ^= word << 16;
+			word ^= word << 32;
+
+			return word << 1;
+		}
+
+		/// Multiplying the single qubit paulis P (given by the bits first_x and first_z) and Q (given by second_x and
+		/// second_z) gives i^k times another such pauli, with k = 0, 1 or -1. For each bit position, sets the bit of
+		/// plus when k = 1 and of minus when k = -1.
+		void product_phases(const std::uint64_t first_x, const std::uint64_t first_z, const std::uint64_t second_x, const std::uint64_t second_z,
+			std::uint64_t &plus, std::uint64_t &minus)
+		{
+			// XY = iZ, YZ = iX and ZX = iY, and the reverse products give -i
+			plus = (first_x & ~first_z & second_x & second_z) | (first_x & first_z & ~second_x & second_z) | (~first_x & first_z & second_x & ~second_z);
+			minus = (first_x & ~first_z & ~second_x & second_z) | (first_x & first_z & second_x & ~second_z) | (~first_x & first_z & second_x & second_z);
+		}
+
+		/// The pauli (-1)^sign P_1 ... P_n in the form used by Pauli, where Y = iXZ
+		Pauli row_pauli(const std::size_t number_qubits, const std::uint64_t x_vector, const std::uint64_t z_vector, const bool sign)
+		{
+			Pauli pauli(number_qubits, x_vector, z_vector, 0, 0);
+			pauli.set_phase_exponent(4 * sign + 2 * std::popcount(x_vector & z_vector));
+			return pauli;
+		}
+
+		/// The symplectic inner product of the paulis (x, z) and (other_x, other_z), which is 1 when they anticommute
+		bool symplectic_product(const std::uint64_t x_vector, const std::uint64_t z_vector, const std::uint64_t other_x_vector, const std::uint64_t other_z_vector)
+		{
+			return std::popcount((x_vector & other_z_vector) ^ (z_vector & other_x_vector)) & 1;
+		}
+	}
+
+	Tableau::Tableau(const std::size_t number_qubits)
+		: number_qubits(number_qubits), half_column_words((number_qubits + 63) / 64), x_columns(2 * number_qubits * half_column_words),
+		  z_columns(2 * number_qubits * half_column_words), signs(2 * half_column_words)
+	{
+		for (std::size_t qubit = 0; qubit < number_qubits; qubit++)
+		{
+			x_column(qubit)[qubit / 64] |= std::uint64_t(1) << (qubit % 64);
+			z_column(qubit)[half_column_words + qubit / 64] |= std::uint64_t(1) << (qubit % 64);
+		}
+	}
+
+	Tableau::Tableau(const Check_Matrix &check_matrix)
+		: Tableau(check_matrix.number_qubits)
+	{
+		check_pauli_qubits();
+
+		const auto &stabilisers = check_matrix.get_paulis();
+
+		// A destabiliser d_i has <s_j, d_i> = 1 exactly when i = j, a linear system in the symplectic vector of d_i.
+		// Row reducing the matrix whose rows pair with the x and z parts of d_i as the s_j do, while keeping track
+		// of the row operations, gives a solution at the pivots for each i.
+		std::array<std::uint64_t, 64> x_coefficients {};
+		std::array<std::uint64_t, 64> z_coefficients {};
+		std::array<std::uint64_t, 64> row_operations {};
+		std::array<std::size_t, 64> pivot_columns {};
+
+		for (std::size_t j = 0; j < number_qubits; j++)
+		{
+			x_coefficients[j] = stabilisers[j].z_vector;
+			z_coefficients[j] = stabilisers[j].x_vector;
+			row_operations[j] = integral_pow_2(j);
+		}
+
+		std::size_t rank = 0;
+
+		for (std::size_t column = 0; column < 2 * number_qubits && rank < number_qubits; column++)
+		{
+			const auto column_set = [&](const std::size_t row)
+			{
+				return column < number_qubits ? bit_set_at(x_coefficients[row], column) : bit_set_at(z_coefficients[row], column - number_qubits);
+			};
+
+			std::size_t pivot_row = rank;
+
+			while (pivot_row < number_qubits && !column_set(pivot_row))
+			{
+				pivot_row++;
+			}
+
+			if (pivot_row == number_qubits)
+			{
+				continue;
+			}
+
+			std::swap(x_coefficients[rank], x_coefficients[pivot_row]);
+			std::swap(z_coefficients[rank], z_coefficients[pivot_row]);
+			std::swap(row_operations[rank], row_operations[pivot_row]);
+
+			for (std::size_t row = 0; row < number_qubits; row++)
+			{
+				if (row != rank && column_set(row))
+				{
+					x_coefficients[row] ^= x_coefficients[rank];
+					z_coefficients[row] ^= z_coefficients[rank];
+					row_operations[row] ^= row_operations[rank];
+				}
+			}
+
+			pivot_columns[rank++] = column;
+		}
+
+		if (rank < number_qubits)
+		{
+			throw std::invalid_argument("The paulis of the check matrix are not independent.");
+		}
+
+		std::array<std::uint64_t, 64> destabiliser_x {};
+		std::array<std::uint64_t, 64> destabiliser_z {};
+
+		for (std::size_t i = 0; i < number_qubits; i++)
+		{
+			for (std::size_t r = 0; r < number_qubits; r++)
+			{
+				if (bit_set_at(row_operations[r], i))
+				{
+					if (pivot_columns[r] < number_qubits)
+					{
+						destabiliser_x[i] ^= integral_pow_2(pivot_columns[r]);
+					}
+					else
+					{
+						destabiliser_z[i] ^= integral_pow_2(pivot_columns[r] - number_qubits);
+					}
+				}
+			}
+
+			// Multiplying d_i by s_j flips whether it commutes with d_j, and no other inner product
+			for (std::size_t j = 0; j < i; j++)
+			{
+				if (symplectic_product(destabiliser_x[i], destabiliser_z[i], destabiliser_x[j], destabiliser_z[j]))
+				{
+					destabiliser_x[i] ^= stabilisers[j].x_vector;
+					destabiliser_z[i] ^= stabilisers[j].z_vector;
+				}
+			}
+		}
+
+		for (std::size_t i = 0; i < number_qubits; i++)
+		{
+			set_row(i, row_pauli(number_qubits, destabiliser_x[i], destabiliser_z[i], 0));
+			set_row(number_qubits + i, stabilisers[i]);
+		}
+	}
+
+	std::uint64_t *Tableau::x_column(const std::size_t qubit)
+	{
+		return x_columns.data() + 2 * half_column_words * qubit;
+	}
+
+	std::uint64_t *Tableau::z_column(const std::size_t qubit)
+	{
+		return z_columns.data() + 2 * half_column_words * qubit;
+	}
+
+	const std::uint64_t *Tableau::x_column(const std::size_t qubit) const
+	{
+		return x_columns.data() + 2 * half_column_words * qubit;
+	}
+
+	const std::uint64_t *Tableau::z_column(const std::size_t qubit) const
+	{
+		return z_columns.data() + 2 * half_column_words * qubit;
+	}
+
+	void Tableau::check_qubit(const std::size_t qubit) const
+	{
+		if (qubit >= number_qubits)
+		{
+			throw std::invalid_argument("The qubit must be less than the number of qubits of the tableau.");
+		}
+	}
+
+	void Tableau::check_qubits(const std::size_t first_qubit, const std::size_t second_qubit) const
+	{
+		check_qubit(first_qubit);
+		check_qubit(second_qubit);
+
+		if (first_qubit == second_qubit)
+		{
+			throw std::invalid_argument("The qubits of a two qubit gate must be distinct.");
+		}
+	}
+
+	void Tableau::check_pauli_qubits() const
+	{
+		if (number_qubits > 64)
+		{
+			throw std::invalid_argument("Only tableaus on at most 64 qubits can be converted to paulis.");
+		}
+	}
+
+	void Tableau::h(const std::size_t qubit)
+	{
+		check_qubit(qubit);
+
+		std::uint64_t *x = x_column(qubit);
+		std::uint64_t *z = z_column(qubit);
+
+		for (std::size_t k = 0; k < 2 * half_column_words; k++)
+		{
+			signs[k] ^= x[k] & z[k];
+			std::swap(x[k], z[k]);
+		}
+	}
+
+	void Tableau::s(const std::size_t qubit)
+	{
+		check_qubit(qubit);
+
+		std::uint64_t *x = x_column(qubit);
+		std::uint64_t *z = z_column(qubit);
+
+		for (std::size_t k = 0; k < 2 * half_column_words; k++)
+		{
+			signs[k] ^= x[k] & z[k];
+			z[k] ^= x[k];
+		}
+	}
+
+	void Tableau::s_dagger(const std::size_t qubit)
+	{
+		check_qubit(qubit);
+
+		std::uint64_t *x = x_column(qubit);
+		std::uint64_t *z = z_column(qubit);
+
+		for (std::size_t k = 0; k < 2 * half_column_words; k++)
+		{
+			signs[k] ^= x[k] & ~z[k];
+			z[k] ^= x[k];
+		}
+	}
+
+	void Tableau::x(const std::size_t qubit)
+	{
+		check_qubit(qubit);
+
+		const std::uint64_t *z = z_column(qubit);
+
+		for (std::size_t k = 0; k < 2 * half_column_words; k++)
+		{
+			signs[k] ^= z[k];
+		}
+	}
+
+	void Tableau::y(const std::size_t qubit)
+	{
+		check_qubit(qubit);
+
+		const std::uint64_t *x = x_column(qubit);
+		const std::uint64_t *z = z_column(qubit);
+
+		for (std::size_t k = 0; k < 2 * half_column_words; k++)
+		{
+			signs[k] ^= x[k] ^ z[k];
+		}
+	}
+
+	void Tableau::z(const std::size_t qubit)
+	{
+		check_qubit(qubit);
+
+		const std::uint64_t *x = x_column(qubit);
+
+		for (std::size_t k = 0; k < 2 * half_column_words; k++)
+		{
+			signs[k] ^= x[k];
+		}
+	}
+
+	void Tableau::cnot(const std::size_t control, const std::size_t target)
+	{
+		check_qubits(control, target);
+
+		std::uint64_t *control_x = x_column(control);
+		std::uint64_t *control_z = z_column(control);
+		std::uint64_t *target_x = x_column(target);
+		std::uint64_t *target_z = z_column(target);
+
+		for (std::size_t k = 0; k < 2 * half_column_words; k++)
+		{
+			signs[k] ^= control_x[k] & target_z[k] & ~(target_x[k] ^ control_z[k]);
+			target_x[k] ^= control_x[k];
+			control_z[k] ^= target_z[k];
+		}
+	}
+
+	void Tableau::cz(const std::size_t first_qubit, const std::size_t second_qubit)
+	{
+		check_qubits(first_qubit, second_qubit);
+
+		const std::uint64_t *first_x = x_column(first_qubit);
+		std::uint64_t *first_z = z_column(first_qubit);
+		const std::uint64_t *second_x = x_column(second_qubit);
+		std::uint64_t *second_z = z_column(second_qubit);
+
+		for (std::size_t k = 0; k < 2 * half_column_words; k++)
+		{
+			signs[k] ^= first_x[k] & second_x[k] & (first_z[k] ^ second_z[k]);
+			first_z[k] ^= second_x[k];
+			second_z[k] ^= first_x[k];
+		}
+	}
+
+	void Tableau::swap(const std::size_t first_qubit, const std::size_t second_qubit)
+	{
+		check_qubits(first_qubit, second_qubit);
+
+		std::swap_ranges(x_column(first_qubit), x_column(first_qubit) + 2 * half_column_words, x_column(second_qubit));
+		std::swap_ranges(z_column(first_qubit), z_column(first_qubit) + 2 * half_column_words, z_column(second_qubit));
+	}
+
+	bool Tableau::is_deterministic(const std::size_t qubit) const
+	{
+		check_qubit(qubit);
+
+		const std::uint64_t *x = x_column(qubit) + half_column_words;
+		return std::all_of(x, x + half_column_words, [](const std::uint64_t word) { return word == 0; });
+	}
+
+	bool Tableau::measure(const std::size_t qubit, Random_Generator &generator)
+	{
+		check_qubit(qubit);
+
+		const std::uint64_t *x = x_column(qubit);
+		const std::uint64_t *stabiliser_x = x + half_column_words;
+		const auto anticommuting_word = std::find_if(stabiliser_x, stabiliser_x + half_column_words, [](const std::uint64_t word) { return word != 0; });
+
+		// When Z commutes with the stabilisers, it is +-1 times their product over the destabilisers that
+		// anticommute with it
+		if (anticommuting_word == stabiliser_x + half_column_words)
+		{
+			return product_sign(x);
+		}
+
+		FST_COUNT(random_measurements, 1);
+
+		// Otherwise, as for Check_Matrix::measure, the other rows anticommuting with Z are multiplied by an
+		// anticommuting stabiliser, which is then replaced by (-1)^outcome Z. Its destabiliser becomes the old
+		// stabiliser, so still anticommutes with it and commutes with the rest.
+		const bool outcome = generator.random_bit();
+		const std::size_t word = anticommuting_word - stabiliser_x;
+		const std::size_t index = 64 * word + std::countr_zero(*anticommuting_word);
+		const std::uint64_t bit = std::uint64_t(1) << (index % 64);
+
+		const Scratch_Scope scope(thread_scratch_arena());
+		std::pmr::vector<std::uint64_t> row_mask(x, x + 2 * half_column_words, &thread_scratch_arena());
+		row_mask[half_column_words + word] &= ~bit;
+
+		multiply_rows_by_stabiliser(row_mask.data(), index);
+
+		const std::size_t destabiliser_word = word;
+		const std::size_t stabiliser_word = half_column_words + word;
+
+		const auto move_bit = [&](std::uint64_t *column)
+		{
+			column[destabiliser_word] = (column[destabiliser_word] & ~bit) | (column[stabiliser_word] & bit);
+			column[stabiliser_word] &= ~bit;
+		};
+
+		for (std::size_t q = 0; q < number_qubits; q++)
+		{
+			move_bit(x_column(q));
+			move_bit(z_column(q));
+		}
+
+		move_bit(signs.data());
+		z_column(qubit)[stabiliser_word] |= bit;
+		signs[stabiliser_word] |= broadcast(outcome) & bit;
+
+		return outcome;
+	}
+
+	void Tableau::multiply_rows_by_stabiliser(const std::uint64_t *row_mask, const std::size_t index)
+	{
+		const std::size_t words = 2 * half_column_words;
+		const std::size_t word = half_column_words + index / 64;
+		const std::size_t bit_index = index % 64;
+
+		// The phases i^k gained on each qubit are summed mod 4 for each row, bit sliced over the rows
+		const Scratch_Scope scope(thread_scratch_arena());
+		std::pmr::vector<std::uint64_t> low_bits(words, 0, &thread_scratch_arena());
+		std::pmr::vector<std::uint64_t> high_bits(words, 0, &thread_scratch_arena());
+
+		for (std::size_t q = 0; q < number_qubits; q++)
+		{
+			std::uint64_t *x = x_column(q);
+			std::uint64_t *z = z_column(q);
+
+			const std::uint64_t stabiliser_x = broadcast(bit_set_at(x[word], bit_index));
+			const std::uint64_t stabiliser_z = broadcast(bit_set_at(z[word], bit_index));
+
+			if ((stabiliser_x | stabiliser_z) == 0)
+			{
+				continue;
+			}
+
+			for (std::size_t k = 0; k < words; k++)
+			{
+				std::uint64_t plus, minus;
+				product_phases(stabiliser_x, stabiliser_z, x[k], z[k], plus, minus);
+				plus &= row_mask[k];
+				minus &= row_mask[k];
+
+				high_bits[k] ^= low_bits[k] & plus;
+				low_bits[k] ^= plus;
+				high_bits[k] ^= minus & ~low_bits[k];
+				low_bits[k] ^= minus;
+
+				x[k] ^= stabiliser_x & row_mask[k];
+				z[k] ^= stabiliser_z & row_mask[k];
+			}
+		}
+
+		// Rows commuting with the stabiliser gain i^0 or i^2 in total, so the high bit is the change of sign
+		const std::uint64_t stabiliser_sign = broadcast(bit_set_at(signs[word], bit_index));
+
+		for (std::size_t k = 0; k < words; k++)
+		{
+			signs[k] ^= row_mask[k] & (high_bits[k] ^ stabiliser_sign);
+		}
+	}
+
+	bool Tableau::product_sign(const std::uint64_t *stabiliser_mask) const
+	{
+		// The exponent of i, mod 4, with the -1 phases counted as 3
+		std::uint64_t exponent = 0;
+
+		for (std::size_t k = 0; k < half_column_words; k++)
+		{
+			exponent += 2 * std::popcount(signs[half_column_words + k] & stabiliser_mask[k]);
+		}
+
+		// On each qubit, the product of the earlier stabilisers is their sum as vectors, so is a prefix parity
+		for (std::size_t q = 0; q < number_qubits; q++)
+		{
+			const std::uint64_t *x = x_column(q) + half_column_words;
+			const std::uint64_t *z = z_column(q) + half_column_words;
+
+			bool x_parity = 0;
+			bool z_parity = 0;
+
+			for (std::size_t k = 0; k < half_column_words; k++)
+			{
+				const std::uint64_t row_x = x[k] & stabiliser_mask[k];
+				const std::uint64_t row_z = z[k] & stabiliser_mask[k];
+
+				std::uint64_t plus, minus;
+				product_phases(exclusive_prefix_parity(row_x) ^ broadcast(x_parity), exclusive_prefix_parity(row_z) ^ broadcast(z_parity), row_x, row_z, plus, minus);
+				exponent += std::popcount(plus) + 3 * std::popcount(minus);
+
+				x_parity ^= std::popcount(row_x) & 1;
+				z_parity ^= std::popcount(row_z) & 1;
+			}
+		}
+
+		return (exponent & 3) == 2;
+	}
+
+	void Tableau::reset(const std::size_t qubit, Random_Generator &generator)
+	{
+		if (measure(qubit, generator))
+		{
+			x(qubit);
+		}
+	}
+
+	void Tableau::apply(const Operation &operation, Random_Generator &generator, std::vector<bool> &measurement_record)
+	{
+		switch (operation.gate)
+		{
+			case Gate::h: h(operation.first_qubit); return;
+			case Gate::s: s(operation.first_qubit); return;
+			case Gate::s_dagger: s_dagger(operation.first_qubit); return;
+			case Gate::x: x(operation.first_qubit); return;
+			case Gate::y: y(operation.first_qubit); return;
+			case Gate::z: z(operation.first_qubit); return;
+			case Gate::cnot: cnot(operation.first_qubit, operation.second_qubit); return;
+			case Gate::cz: cz(operation.first_qubit, operation.second_qubit); return;
+			case Gate::swap: swap(operation.first_qubit, operation.second_qubit); return;
+			case Gate::measure: measurement_record.push_back(measure(operation.first_qubit, generator)); return;
+			case Gate::reset: reset(operation.first_qubit, generator); return;
+			case Gate::x_error: if (generator.random_event(operation.probability)) x(operation.first_qubit); return;
+			case Gate::y_error: if (generator.random_event(operation.probability)) y(operation.first_qubit); return;
+			case Gate::z_error: if (generator.random_event(operation.probability)) z(operation.first_qubit); return;
+			case Gate::depolarise1:
+				if (generator.random_event(operation.probability))
+				{
+					apply_pauli(operation.first_qubit, 1 + generator.random_below(3));
+				}
+				return;
+			case Gate::depolarise2:
+				if (generator.random_event(operation.probability))
+				{
+					const std::uint64_t paulis = 1 + generator.random_below(15);
+					apply_pauli(operation.first_qubit, paulis & 3);
+					apply_pauli(operation.second_qubit, paulis >> 2);
+				}
+				return;
+		}
+
+		throw std::invalid_argument("Unknown gate.");
+	}
+
+	void Tableau::apply_pauli(const std::size_t qubit, const std::uint64_t pauli)
+	{
+		switch (pauli)
+		{
+			case 1: x(qubit); return;
+			case 2: y(qubit); return;
+			case 3: z(qubit); return;
+		}
+	}
+
+	std::vector<bool> Tableau::run(const Circuit &circuit, Random_Generator &generator)
+	{
+		FST_TIME_SCOPE(tableau_run);
+
+		if (circuit.number_qubits > number_qubits)
+		{
+			throw std::invalid_argument("The circuit has more qubits than the tableau.");
+		}
+
+		std::vector<bool> measurement_record;
+		measurement_record.reserve(circuit.number_measurements);
+
+		for (const Operation &operation : circuit.operations)
+		{
+			apply(operation, generator, measurement_record);
+		}
+
+		return measurement_record;
+	}
+
+	Pauli Tableau::get_row(const std::size_t row) const
+	{
+		const std::size_t word = row < number_qubits ? row / 64 : half_column_words + (row - number_qubits) / 64;
+		const std::size_t bit_index = row % number_qubits % 64;
+
+		std::uint64_t x_vector = 0;
+		std::uint64_t z_vector = 0;
+
+		for (std::size_t q = 0; q < number_qubits; q++)
+		{
+			x_vector |= std::uint64_t(bit_set_at(x_column(q)[word], bit_index)) << q;
+			z_vector |= std::uint64_t(bit_set_at(z_column(q)[word], bit_index)) << q;
+		}
+
+		return row_pauli(number_qubits, x_vector, z_vector, bit_set_at(signs[word], bit_index));
+	}
+
+	void Tableau::set_row(const std::size_t row, const Pauli &pauli)
+	{
+		const std::size_t word = row < number_qubits ? row / 64 : half_column_words + (row - number_qubits) / 64;
+		const std::uint64_t bit = std::uint64_t(1) << (row % number_qubits % 64);
+
+		for (std::size_t q = 0; q < number_qubits; q++)
+		{
+			x_column(q)[word] = (x_column(q)[word] & ~bit) | (broadcast(bit_set_at(pauli.x_vector, q)) & bit);
+			z_column(q)[word] = (z_column(q)[word] & ~bit) | (broadcast(bit_set_at(pauli.z_vector, q)) & bit);
+		}
+
+		// The pauli is Hermitian, so its phase relative to P_1 ... P_n is +-1
+		const bool sign = ((pauli.get_phase_exponent() - 2 * std::popcount(pauli.x_vector & pauli.z_vector)) & 7) == 4;
+		signs[word] = (signs[word] & ~bit) | (broadcast(sign) & bit);
+	}
+
+	Pauli Tableau::get_stabiliser(const std::size_t index) const
+	{
+		check_pauli_qubits();
+		check_qubit(index);
+
+		return get_row(number_qubits + index);
+	}
+
+	Pauli Tableau::get_destabiliser(const std::size_t index) const
+	{
+		check_pauli_qubits();
+		check_qubit(index);
+
+		return get_row(index);
+	}
+
+	Check_Matrix Tableau::to_check_matrix() const
+	{
+		check_pauli_qubits();
+
+		std::vector<Pauli> stabilisers;
+		stabilisers.reserve(number_qubits);
+
+		for (std::size_t i = 0; i < number_qubits; i++)
+		{
+			stabilisers.push_back(get_row(number_qubits + i));
+		}
+
+		return Check_Matrix(stabilisers);
+	}
+
+	Stabiliser_State Tableau::to_stabiliser_state() const
+	{
+		Check_Matrix check_matrix = to_check_matrix();
+		return Stabiliser_State(check_matrix);
+	}
+}
@@ -0,0 +1,112 @@
+#ifndef _FAST_STABILISER_TABLEAU_H
+#define _FAST_STABILISER_TABLEAU_H
+
+#include "circuit.h"
+#include "pauli/pauli.h"
+#include "util/random.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace fst
+{
+	struct Check_Matrix;
+	struct Stabiliser_State;
+
+	/// The stabiliser tableau of Aaronson & Gottesman, used to simulate Clifford circuits on any number of qubits.
+	///
+	/// Each row is a Hermitian pauli (-1)^r P_1 ... P_n, where P_q is I, X, Y or Z as the bits (x_q, z_q) are 00, 10,
+	/// 11 or 01. The n stabilisers generate the stabiliser group of the state, as for Check_Matrix, and the n
+	/// destabilisers complete them to a symplectic basis: the i-th destabiliser anticommutes with the i-th stabiliser,
+	/// and commutes with the other stabilisers and all destabilisers.
+	///
+	/// The tableau is stored by column: for each qubit, the x bits of the 2n rows are packed into words (the
+	/// destabilisers and then the stabilisers), and likewise the z bits, so that a gate updates O(n / 64) words.
+	/// The signs of the destabilisers are not kept up to date by measurements, as they never affect the outcomes.
+	struct Tableau
+	{
+		std::size_t number_qubits = 0;
+
+		/// The tableau of |0...0>, with stabilisers Z_i and destabilisers X_i
+		explicit Tableau(const std::size_t number_qubits);
+
+		/// The tableau of the state of the check matrix (on at most 64 qubits), with destabilisers found by
+		/// Gaussian elimination in O(n^3 / 64) time
+		explicit Tableau(const Check_Matrix &check_matrix);
+
+		/// The gates act by conjugating each row in O(n / 64) time. Throws if a qubit is out of range, or a
+		/// two qubit gate is given the same qubit twice.
+		void h(const std::size_t qubit);
+		void s(const std::size_t qubit);
+		void s_dagger(const std::size_t qubit);
+		void x(const std::size_t qubit);
+		void y(const std::size_t qubit);
+		void z(const std::size_t qubit);
+		void cnot(const std::size_t control, const std::size_t target);
+		void cz(const std::size_t first_qubit, const std::size_t second_qubit);
+		void swap(const std::size_t first_qubit, const std::size_t second_qubit);
+
+		/// Whether measuring the qubit has a deterministic outcome, checked in O(n / 64) time
+		bool is_deterministic(const std::size_t qubit) const;
+
+		/// Measures the qubit in the computational basis, returning the outcome and collapsing the state. A random
+		/// outcome multiplies the rows anticommuting with Z in one pass over the columns, in O(n^2 / 64) time. A
+		/// deterministic outcome is the sign of the product of the stabilisers picked out by the destabilisers,
+		/// found column by column without changing the tableau, also in O(n^2 / 64) time but with no writes.
+		bool measure(const std::size_t qubit, Random_Generator &generator);
+
+		/// Resets the qubit to |0>, by measuring it and flipping it if needed
+		void reset(const std::size_t qubit, Random_Generator &generator);
+
+		/// Applies the operation, appending the outcome of a measurement to the record. Noise channels apply their
+		/// pauli with its probability, drawing from the generator.
+		void apply(const Operation &operation, Random_Generator &generator, std::vector<bool> &measurement_record);
+
+		/// Runs the circuit, which must have at most as many qubits as the tableau, returning the measurement record
+		std::vector<bool> run(const Circuit &circuit, Random_Generator &generator);
+
+		/// The i-th stabiliser and destabiliser as paulis, on at most 64 qubits
+		Pauli get_stabiliser(const std::size_t index) const;
+		Pauli get_destabiliser(const std::size_t index) const;
+
+		/// Returns the check matrix of the stabilisers, or the stabiliser state (with global phase 1), on at most
+		/// 64 qubits
+		Check_Matrix to_check_matrix() const;
+		Stabiliser_State to_stabiliser_state() const;
+
+		bool operator==(const Tableau &other) const = default;
+
+		private:
+
+		/// The number of words holding one half (the destabilisers or the stabilisers) of a column
+		std::size_t half_column_words = 0;
+
+		/// The x and z bits of qubit q are the 2 * half_column_words words from q * 2 * half_column_words
+		std::vector<std::uint64_t> x_columns;
+		std::vector<std::uint64_t> z_columns;
+		std::vector<std::uint64_t> signs;
+
+		std::uint64_t *x_column(const std::size_t qubit);
+		std::uint64_t *z_column(const std::size_t qubit);
+		const std::uint64_t *x_column(const std::size_t qubit) const;
+		const std::uint64_t *z_column(const std::size_t qubit) const;
+
+		void check_qubit(const std::size_t qubit) const;
+		void check_qubits(const std::size_t first_qubit, const std::size_t second_qubit) const;
+
+		/// Sets each row in the mask (over all 2n rows) to the stabiliser with the given index times that row
+		void multiply_rows_by_stabiliser(const std::uint64_t *row_mask, const std::size_t index);
+
+		/// The sign of the product of the stabilisers in the mask (over the n stabilisers), which must commute
+		bool product_sign(const std::uint64_t *stabiliser_mask) const;
+
+		Pauli get_row(const std::size_t row) const;
+		void set_row(const std::size_t row, const Pauli &pauli);
+		void check_pauli_qubits() const;
+
+		/// Applies I, X, Y or Z to the qubit as the pauli is 0, 1, 2 or 3
+		void apply_pauli(const std::size_t qubit, const std::uint64_t pauli);
+	};
+}
+
+#endif
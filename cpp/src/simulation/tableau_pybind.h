@@ -0,0 +1,44 @@
+#ifndef _FAST_STABILISER_TABLEAU_PYBIND_H
+#define _FAST_STABILISER_TABLEAU_PYBIND_H
+
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+
+#include "tableau.h"
+#include "stabiliser_state/check_matrix.h"
+#include "stabiliser_state/stabiliser_state.h"
+
+namespace py = pybind11;
+using namespace fst;
+
+namespace fst_pybind
+{
+	void init_tableau(py::module_ &m)
+	{
+		py::class_<Tableau>(m, "Tableau")
+			.def(py::init<const std::size_t>(), py::arg("number_qubits"), "The tableau of |0...0>")
+			.def(py::init<const Check_Matrix &>(), py::arg("check_matrix"), "The tableau of the state of the check matrix, on at most 64 qubits")
+			.def_readonly("number_qubits", &Tableau::number_qubits, "int\t\tThe number of qubits")
+			.def("h", &Tableau::h, py::arg("qubit"))
+			.def("s", &Tableau::s, py::arg("qubit"))
+			.def("s_dagger", &Tableau::s_dagger, py::arg("qubit"))
+			.def("x", &Tableau::x, py::arg("qubit"))
+			.def("y", &Tableau::y, py::arg("qubit"))
+			.def("z", &Tableau::z, py::arg("qubit"))
+			.def("cnot", &Tableau::cnot, py::arg("control"), py::arg("target"))
+			.def("cz", &Tableau::cz, py::arg("first_qubit"), py::arg("second_qubit"))
+			.def("swap", &Tableau::swap, py::arg("first_qubit"), py::arg("second_qubit"))
+			.def("is_deterministic", &Tableau::is_deterministic, py::arg("qubit"), "Returns whether measuring the qubit has a deterministic outcome")
+			.def("measure", &Tableau::measure, py::arg("qubit"), py::arg("generator"), "Measures the qubit in the computational basis, returning the outcome as a bool and collapsing the state")
+			.def("reset", &Tableau::reset, py::arg("qubit"), py::arg("generator"), "Resets the qubit to |0>")
+			.def("run", &Tableau::run, py::arg("circuit"), py::arg("generator"), "Runs the circuit, returning the measurement record as a list[bool]")
+			.def("get_stabiliser", &Tableau::get_stabiliser, py::arg("index"), "Returns the stabiliser with the given index as a Pauli, on at most 64 qubits")
+			.def("get_destabiliser", &Tableau::get_destabiliser, py::arg("index"), "Returns the destabiliser with the given index as a Pauli, on at most 64 qubits")
+			.def("to_check_matrix", &Tableau::to_check_matrix, "Returns the check matrix of the stabilisers, on at most 64 qubits")
+			.def("to_stabiliser_state", &Tableau::to_stabiliser_state, "Returns the stabiliser state (with global phase 1), on at most 64 qubits")
+			.def("__eq__", &Tableau::operator==, py::arg("other"))
+			.doc() = "The stabiliser tableau of Aaronson & Gottesman, with bit-packed columns, used to simulate Clifford circuits on any number of qubits. The n stabilisers generate the stabiliser group of the state, and the n destabilisers complete them to a symplectic basis";
+	}
+}
+
+#endif
@@ -1,18 +1,155 @@
 #include "check_matrix.h"
 #include "stabiliser_state.h"
 #include "util/f2_helper.h"
-
+#include "util/hash.h"
+#include "util/random.h"
+#include "util/scratch_arena.h"
+#include "util/stats.h"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <compare>
+#include <cstdint>
 #include <stdexcept>
-#include <iostream>
 
 using namespace std;
 
 namespace fst
 {
-    Check_Matrix::Check_Matrix(const std::vector<Pauli> paulis, const bool row_reduced)
-        : row_reduced(row_reduced), paulis(paulis)
+    namespace
     {
-        number_qubits = paulis.size();
+        /// The symplectic vector (x_vector, z_vector) of a pauli on n qubits, ordered as the 2n bit number
+        /// x_vector * 2^n + z_vector, i.e. by the x bits and then the z bits. This needs more than a word above 32
+        /// qubits, so the two halves are kept apart.
+        struct Symplectic_Vector
+        {
+            std::size_t x_vector = 0;
+            std::size_t z_vector = 0;
+
+            auto operator<=>(const Symplectic_Vector &other) const = default;
+
+            bool is_zero() const
+            {
+                return x_vector == 0 && z_vector == 0;
+            }
+
+            /// The vector with only the leading bit, which is the pivot in the canonical form
+            Symplectic_Vector leading_bit() const
+            {
+                return x_vector != 0 ? Symplectic_Vector {std::bit_floor(x_vector), 0} : Symplectic_Vector {0, std::bit_floor(z_vector)};
+            }
+
+            bool shares_bit_with(const Symplectic_Vector &other) const
+            {
+                return ((x_vector & other.x_vector) | (z_vector & other.z_vector)) != 0;
+            }
+
+            Symplectic_Vector operator&(const Symplectic_Vector &other) const
+            {
+                return {x_vector & other.x_vector, z_vector & other.z_vector};
+            }
+
+            Symplectic_Vector &operator|=(const Symplectic_Vector &other)
+            {
+                x_vector |= other.x_vector;
+                z_vector |= other.z_vector;
+                return *this;
+            }
+
+            Symplectic_Vector &operator^=(const Symplectic_Vector &other)
+            {
+                x_vector ^= other.x_vector;
+                z_vector ^= other.z_vector;
+                return *this;
+            }
+        };
+
+        Symplectic_Vector symplectic_vector(const Pauli &pauli)
+        {
+            return {pauli.x_vector, pauli.z_vector};
+        }
+
+        /// Returns why the paulis do not generate a stabiliser group, or nullptr if they do
+        const char *stabiliser_group_error(std::span<const Pauli> paulis)
+        {
+            if (paulis.empty())
+            {
+                return nullptr;
+            }
+
+            const std::size_t number_qubits = paulis.front().number_qubits;
+
+            if (number_qubits > 64 || paulis.size() > number_qubits)
+            {
+                return "There must be at most 64 qubits, and at most as many paulis as qubits.";
+            }
+
+            for (const Pauli &pauli : paulis)
+            {
+                if (pauli.number_qubits != number_qubits || !pauli.is_hermitian())
+                {
+                    return "The paulis must be Hermitian and on the same number of qubits.";
+                }
+            }
+
+            // Bit j of row i of the commutation matrix is set when paulis i and j anticommute
+            std::array<std::uint64_t, 64> commutation_matrix {};
+
+            for (std::size_t i = 0; i < paulis.size(); i++)
+            {
+                for (std::size_t j = 0; j < i; j++)
+                {
+                    const std::uint64_t anticommute = std::popcount((paulis[i].x_vector & paulis[j].z_vector) ^ (paulis[i].z_vector & paulis[j].x_vector)) & 1;
+                    commutation_matrix[i] |= anticommute << j;
+                    commutation_matrix[j] |= anticommute << i;
+                }
+            }
+
+            if (std::any_of(commutation_matrix.begin(), commutation_matrix.end(), [](const std::uint64_t row) { return row != 0; }))
+            {
+                return "The paulis must pairwise commute.";
+            }
+
+            // Reduces each pauli by the earlier ones, which are kept by pivot: the leading bit of the x vector, or
+            // (after the 64 for x) of the z vector for those with no x. A pauli reducing to zero is dependent.
+            std::array<std::pair<std::size_t, std::size_t>, 128> reduced {};
+
+            for (const Pauli &pauli : paulis)
+            {
+                std::size_t x_vector = pauli.x_vector;
+                std::size_t z_vector = pauli.z_vector;
+
+                while (x_vector != 0 || z_vector != 0)
+                {
+                    const std::size_t pivot = x_vector != 0 ? 64 + integral_log_2(x_vector) : integral_log_2(z_vector);
+
+                    if (reduced[pivot].first == 0 && reduced[pivot].second == 0)
+                    {
+                        reduced[pivot] = {x_vector, z_vector};
+                        break;
+                    }
+
+                    x_vector ^= reduced[pivot].first;
+                    z_vector ^= reduced[pivot].second;
+                }
+
+                if (x_vector == 0 && z_vector == 0)
+                {
+                    return "The paulis must be independent.";
+                }
+            }
+
+            return nullptr;
+        }
+    }
+
+    Check_Matrix::Check_Matrix(std::span<const Pauli> paulis, const bool row_reduced, const allocator_type &allocator)
+        : row_reduced(row_reduced), paulis(paulis.begin(), paulis.end(), allocator), z_only_stabilisers(allocator), x_stabilisers(allocator),
+          z_only_pivots(allocator)
+    {
+        // The paulis of a partial stabiliser group are fewer than their qubits
+        number_qubits = paulis.empty() ? 0 : paulis.front().number_qubits;
         categorise_paulis();
 
         if (row_reduced)
@@ -21,29 +158,96 @@ namespace fst
         }
     }
 
-    const std::vector<Pauli>& Check_Matrix::get_paulis() const
+    Check_Matrix::Check_Matrix(const std::size_t number_qubits, const allocator_type &allocator)
+        : number_qubits(number_qubits), row_reduced(true), paulis(allocator), z_only_stabilisers(allocator), x_stabilisers(allocator),
+          z_only_pivots(allocator)
+    {
+        paulis.reserve(number_qubits);
+    }
+
+    Check_Matrix::Check_Matrix(const Check_Matrix &other)
+        : Check_Matrix(other, allocator_type())
+    {
+    }
+
+    Check_Matrix::Check_Matrix(const Check_Matrix &other, const allocator_type &allocator)
+        : number_qubits(other.number_qubits), row_reduced(other.row_reduced), paulis(other.paulis, allocator), z_only_stabilisers(allocator),
+          x_stabilisers(allocator), z_only_pivots(other.z_only_pivots, allocator)
+    {
+        copy_categories(other, other.paulis.data());
+    }
+
+    Check_Matrix &Check_Matrix::operator=(const Check_Matrix &other)
+    {
+        if (this != &other)
+        {
+            *this = Check_Matrix(other);
+        }
+
+        return *this;
+    }
+
+    Check_Matrix &Check_Matrix::operator=(Check_Matrix &&other)
+    {
+        if (this != &other)
+        {
+            // The paulis are moved element by element (so change address) when the allocators differ
+            const Pauli *other_paulis = other.paulis.data();
+
+            number_qubits = other.number_qubits;
+            row_reduced = other.row_reduced;
+            paulis = std::move(other.paulis);
+            z_only_pivots = std::move(other.z_only_pivots);
+            copy_categories(other, other_paulis);
+        }
+
+        return *this;
+    }
+
+    void Check_Matrix::copy_categories(const Check_Matrix &other, const Pauli *other_paulis)
+    {
+        z_only_stabilisers.clear();
+        x_stabilisers.clear();
+
+        for (const Pauli *pauli : other.z_only_stabilisers)
+        {
+            z_only_stabilisers.push_back(&paulis[pauli - other_paulis]);
+        }
+
+        for (const Pauli *pauli : other.x_stabilisers)
+        {
+            x_stabilisers.push_back(&paulis[pauli - other_paulis]);
+        }
+    }
+
+    Check_Matrix::allocator_type Check_Matrix::get_allocator() const
+    {
+        return paulis.get_allocator();
+    }
+
+    const std::pmr::vector<Pauli>& Check_Matrix::get_paulis() const
     {
         return paulis;
     }
 
-    void Check_Matrix::set_paulis(std::vector<Pauli> paulis_)
+    void Check_Matrix::set_paulis(std::span<const Pauli> paulis_)
     {
         row_reduced = false;
-        paulis = std::move(paulis_);
+        paulis.assign(paulis_.begin(), paulis_.end());
         categorise_paulis();
     }
 
-    const std::vector<Pauli *>& Check_Matrix::get_z_only_stabilisers() const
+    const std::pmr::vector<Pauli *>& Check_Matrix::get_z_only_stabilisers() const
     {
         return z_only_stabilisers;
     }
 
-    const std::vector<Pauli *>& Check_Matrix::get_x_stabilisers() const
+    const std::pmr::vector<Pauli *>& Check_Matrix::get_x_stabilisers() const
     {
         return x_stabilisers;
     }
 
-    const std::vector<std::size_t> & Check_Matrix::get_z_only_pivots() const
+    const std::pmr::vector<std::size_t> & Check_Matrix::get_z_only_pivots() const
     {
         if (row_reduced)
         {
@@ -55,6 +259,9 @@ namespace fst
 
     void Check_Matrix::categorise_paulis()
     {
+        z_only_stabilisers.clear();
+        x_stabilisers.clear();
+
         for (auto &pauli : paulis)
         {
             if (pauli.x_vector == 0)
@@ -67,7 +274,8 @@ namespace fst
         }
     }
 
-    Check_Matrix::Check_Matrix(Stabiliser_State &stabiliser_state)
+    Check_Matrix::Check_Matrix(Stabiliser_State &stabiliser_state, const allocator_type &allocator)
+        : paulis(allocator), z_only_stabilisers(allocator), x_stabilisers(allocator), z_only_pivots(allocator)
     {
         number_qubits = stabiliser_state.number_qubits;
 
@@ -75,34 +283,32 @@ namespace fst
 
         paulis.reserve(number_qubits);
 
-        std::vector<std::size_t> pivot_vectors;
-        std::unordered_set<std::size_t> pivot_indices_set;
+        // As the basis is row reduced, the pivot of each basis vector is its leading bit
+        std::size_t pivot_mask = 0;
 
         for(const auto basis_vector : stabiliser_state.basis_vectors)
         {
-            std::size_t pivot_index = integral_log_2(basis_vector);
-            pivot_indices_set.insert(pivot_index);
-            pivot_vectors.push_back(integral_pow_2(pivot_index));
+            pivot_mask |= std::bit_floor(basis_vector);
         }
 
-        add_x_stabilisers(pivot_vectors, stabiliser_state);
-        add_z_only_stabilisers(pivot_vectors, pivot_indices_set, stabiliser_state);
+        add_x_stabilisers(stabiliser_state);
+        add_z_only_stabilisers(pivot_mask, stabiliser_state);
 
         row_reduced = true;
     }
 
-    void Check_Matrix::add_z_only_stabilisers(const std::vector<std::size_t> &pivot_vectors, const std::unordered_set<std::size_t> &pivot_indices_set, const Stabiliser_State &state)
+    void Check_Matrix::add_z_only_stabilisers(const std::size_t pivot_mask, const Stabiliser_State &state)
     {
         for(std::size_t i = 0; i < number_qubits; i++)
         {
-            if (!pivot_indices_set.contains(i))
+            if (!bit_set_at(pivot_mask, i))
             {
                 std::size_t alpha = integral_pow_2(i);
 
                 // Make alpha perpendicular to the basis vectors
                 for (std::size_t j = 0; j < state.dim; j++)
                 {
-                    alpha |= bit_set_at(state.basis_vectors[j], i) * pivot_vectors[j];
+                    alpha |= bit_set_at(state.basis_vectors[j], i) * std::bit_floor(state.basis_vectors[j]);
                 }
 
                 bool sign_bit = f2_dot_product(alpha, state.shift);
@@ -116,7 +322,7 @@ namespace fst
         }
     }
 
-    void Check_Matrix::add_x_stabilisers(const std::vector<std::size_t> &pivot_vectors, const Stabiliser_State &state)
+    void Check_Matrix::add_x_stabilisers(const Stabiliser_State &state)
     {
         for (std::size_t i = 0; i < state.dim; i++)
         {
@@ -127,7 +333,7 @@ namespace fst
             // Ensure that the z_vector has the correct inner product with all the basis vectors
             for (std::size_t j = 0; j < state.dim; j++)
             {
-                z_vector ^= pivot_vectors[j] * (state.quadratic_form.at(integral_pow_2(i) ^ integral_pow_2(j)) ^ ( (int) imag_bit & bit_set_at(state.imaginary_part, j) ));
+                z_vector ^= std::bit_floor(state.basis_vectors[j]) * (state.quadratic_form.at(integral_pow_2(i) ^ integral_pow_2(j)) ^ ( (int) imag_bit & bit_set_at(state.imaginary_part, j) ));
             }
 
             bool sign_bit = bit_set_at(state.real_linear_part, i) ^ imag_bit ^ f2_dot_product(z_vector, state.shift);
@@ -140,13 +346,16 @@ namespace fst
 
     std::vector<std::complex<float>> Check_Matrix::get_state_vector()
     {
-        return Stabiliser_State(*this).get_state_vector();
+        const Scratch_Scope scope(thread_scratch_arena());
+        return Stabiliser_State(*this, &thread_scratch_arena()).get_state_vector();
     }
 
     void Check_Matrix::row_reduce()
     {
         if (row_reduced) {return;}
 
+        FST_TIME_SCOPE(check_matrix_row_reduce);
+
         row_reduce_x_stabilisers();
         row_reduce_z_only_stabilisers();
         
@@ -175,6 +384,7 @@ namespace fst
                 {
                     if (other_pauli != pauli && bit_set_at(other_pauli->x_vector, u_pivot_index))
                     {
+                        FST_COUNT(row_reduction_ops, 1);
                         other_pauli->multiply_by_pauli_on_right(*pauli);
                     }
                 }
@@ -194,6 +404,7 @@ namespace fst
             {
                 if (other_pauli != pauli && bit_set_at(other_pauli->z_vector, pivot_index))
                 {
+                    FST_COUNT(row_reduction_ops, 1);
                     other_pauli->multiply_by_pauli_on_right(*pauli);
                 }
             }
@@ -209,34 +420,414 @@ namespace fst
 
         // for (const auto & pauli : x_stabilisers)
         // {
-        //     if (verbose)
-        //     {
-        //         cout << "pivot_marker: " << pivot_marker << "\n";
-        //     }
         //     pivot_marker ^= integral_pow_2((std::size_t) integral_log_2(pauli->x_vector));
         // }
 
         // // Flip all of the bits in the pivot marker
         // pivot_marker ^= (integral_pow_2(number_qubits) - 1);
 
+        z_only_pivots.clear();
         z_only_pivots.reserve(z_only_stabilisers.size());
 
         for (const auto & pauli : z_only_stabilisers)
         {
             // // Anding with the pivot marker sets all x-stabiliser pivot columns to zero, leaving just the z part
-            // if (verbose)
-            // {
-            //     cout << "About to do z_vector & pivot_marker with the following data: " << pauli->z_vector << " " << pivot_marker << "\n";
-            //     cout << "Result is " << (pauli->z_vector & pivot_marker) << "\n";
-            // }
+            // z_only_pivots.push_back( integral_log_2(pauli->z_vector & pivot_marker) );
+            z_only_pivots.push_back( integral_log_2(pauli->z_vector) );
+        }
+    }
 
-            if (verbose)
+    void Check_Matrix::check_generator(const Pauli &generator, const Pauli *excluded) const
+    {
+        if (generator.number_qubits != number_qubits || !generator.is_hermitian())
+        {
+            throw std::invalid_argument("The generator must be a Hermitian pauli on the same number of qubits as the check matrix.");
+        }
+
+        for (const Pauli &pauli : paulis)
+        {
+            if (&pauli != excluded && pauli.anticommutes_with(generator))
             {
-                cout << "pivot is " << integral_log_2(pauli->z_vector) << "\n";
+                throw std::invalid_argument("The generator must commute with the other generators.");
             }
+        }
+    }
 
-            // z_only_pivots.push_back( integral_log_2(pauli->z_vector & pivot_marker) );
-            z_only_pivots.push_back( integral_log_2(pauli->z_vector) );
+    Pauli Check_Matrix::reduce_generator(Pauli generator, const Pauli *excluded) const
+    {
+        // The pivots of each type are only set in their own pauli, so one pass clears them all
+        for (const Pauli *pauli : x_stabilisers)
+        {
+            if (pauli != excluded && bit_set_at(generator.x_vector, (std::size_t) integral_log_2(pauli->x_vector)))
+            {
+                FST_COUNT(row_reduction_ops, 1);
+                generator.multiply_by_pauli_on_right(*pauli);
+            }
+        }
+
+        if (generator.x_vector == 0)
+        {
+            for (std::size_t i = 0; i < z_only_stabilisers.size(); i++)
+            {
+                if (z_only_stabilisers[i] != excluded && bit_set_at(generator.z_vector, z_only_pivots[i]))
+                {
+                    FST_COUNT(row_reduction_ops, 1);
+                    generator.multiply_by_pauli_on_right(*z_only_stabilisers[i]);
+                }
+            }
+
+            if (generator.z_vector == 0)
+            {
+                throw std::invalid_argument("The generator must not be in the group generated by the other generators.");
+            }
+        }
+
+        return generator;
+    }
+
+    void Check_Matrix::remove_from_categories(const Pauli *pauli)
+    {
+        // Removing a generator leaves the others with distinct pivots, so still row reduced
+        const auto x_stabiliser = std::find(x_stabilisers.begin(), x_stabilisers.end(), pauli);
+
+        if (x_stabiliser != x_stabilisers.end())
+        {
+            x_stabilisers.erase(x_stabiliser);
+            return;
         }
+
+        const auto z_only_stabiliser = std::find(z_only_stabilisers.begin(), z_only_stabilisers.end(), pauli);
+        z_only_pivots.erase(z_only_pivots.begin() + (z_only_stabiliser - z_only_stabilisers.begin()));
+        z_only_stabilisers.erase(z_only_stabiliser);
     }
-}
\ No newline at end of file
+
+    void Check_Matrix::insert_reduced_generator(Pauli *pauli)
+    {
+        // The reduced generator is clear at the existing pivots, so its leading bit is a new pivot
+        const bool z_only = pauli->x_vector == 0;
+        const std::size_t pivot = (std::size_t) integral_log_2(z_only ? pauli->z_vector : pauli->x_vector);
+
+        for (Pauli *other_pauli : z_only ? z_only_stabilisers : x_stabilisers)
+        {
+            if (bit_set_at(z_only ? other_pauli->z_vector : other_pauli->x_vector, pivot))
+            {
+                FST_COUNT(row_reduction_ops, 1);
+                other_pauli->multiply_by_pauli_on_right(*pauli);
+            }
+        }
+
+        if (z_only)
+        {
+            z_only_stabilisers.push_back(pauli);
+            z_only_pivots.push_back(pivot);
+        }
+        else
+        {
+            x_stabilisers.push_back(pauli);
+        }
+    }
+
+    void Check_Matrix::replace_generator(const std::size_t index, const Pauli &generator)
+    {
+        if (index >= paulis.size())
+        {
+            throw std::invalid_argument("The index of the generator must be less than the number of generators.");
+        }
+
+        row_reduce();
+
+        Pauli *replaced = &paulis[index];
+        check_generator(generator, replaced);
+        const Pauli reduced = reduce_generator(generator, replaced);
+
+        remove_from_categories(replaced);
+        *replaced = reduced;
+        insert_reduced_generator(replaced);
+    }
+
+    void Check_Matrix::multiply_generator(const std::size_t index, const Pauli &pauli)
+    {
+        if (index >= paulis.size())
+        {
+            throw std::invalid_argument("The index of the generator must be less than the number of generators.");
+        }
+
+        if (pauli.number_qubits != number_qubits)
+        {
+            throw std::invalid_argument("The pauli must have the same number of qubits as the check matrix.");
+        }
+
+        Pauli product = paulis[index];
+        product.multiply_by_pauli_on_right(pauli);
+
+        replace_generator(index, product);
+    }
+
+    void Check_Matrix::add_generator(const Pauli &generator)
+    {
+        if (paulis.size() >= number_qubits)
+        {
+            throw std::invalid_argument("The check matrix already has a generator for each qubit.");
+        }
+
+        row_reduce();
+
+        check_generator(generator, nullptr);
+        const Pauli reduced = reduce_generator(generator, nullptr);
+
+        // Growing the paulis may move them, so the categories are pointed at their new addresses
+        if (paulis.size() == paulis.capacity())
+        {
+            const std::pmr::vector<Pauli> old_paulis(std::move(paulis));
+            paulis = std::pmr::vector<Pauli>(old_paulis.get_allocator());
+            paulis.reserve(number_qubits);
+            paulis.assign(old_paulis.begin(), old_paulis.end());
+
+            for (Pauli *&pauli : z_only_stabilisers)
+            {
+                pauli = &paulis[pauli - old_paulis.data()];
+            }
+
+            for (Pauli *&pauli : x_stabilisers)
+            {
+                pauli = &paulis[pauli - old_paulis.data()];
+            }
+        }
+
+        paulis.push_back(reduced);
+        insert_reduced_generator(&paulis.back());
+    }
+
+    void Check_Matrix::remove_generator(const std::size_t index)
+    {
+        if (index >= paulis.size())
+        {
+            throw std::invalid_argument("The index of the generator must be less than the number of generators.");
+        }
+
+        row_reduce();
+
+        remove_from_categories(&paulis[index]);
+
+        if (index + 1 != paulis.size())
+        {
+            Pauli *last = &paulis.back();
+            paulis[index] = *last;
+
+            for (Pauli *&pauli : last->x_vector == 0 ? z_only_stabilisers : x_stabilisers)
+            {
+                if (pauli == last)
+                {
+                    pauli = &paulis[index];
+                }
+            }
+        }
+
+        paulis.pop_back();
+    }
+
+    void Check_Matrix::canonicalise()
+    {
+        for (std::size_t r = 0; r < paulis.size(); r++)
+        {
+            std::size_t largest = r;
+
+            for (std::size_t i = r + 1; i < paulis.size(); i++)
+            {
+                if (symplectic_vector(paulis[i]) > symplectic_vector(paulis[largest]))
+                {
+                    largest = i;
+                }
+            }
+
+            std::swap(paulis[r], paulis[largest]);
+
+            const Symplectic_Vector vector = symplectic_vector(paulis[r]);
+
+            if (vector.is_zero())
+            {
+                throw std::invalid_argument("The paulis of the check matrix are not independent.");
+            }
+
+            const Symplectic_Vector pivot = vector.leading_bit();
+
+            for (std::size_t i = 0; i < paulis.size(); i++)
+            {
+                if (i != r && symplectic_vector(paulis[i]).shares_bit_with(pivot))
+                {
+                    FST_COUNT(row_reduction_ops, 1);
+                    paulis[i].multiply_by_pauli_on_right(paulis[r]);
+                }
+            }
+        }
+
+        categorise_paulis();
+        z_only_pivots.clear();
+        set_z_only_pivots();
+        row_reduced = true;
+    }
+
+    bool Check_Matrix::is_canonical() const
+    {
+        Symplectic_Vector pivots;
+
+        for (std::size_t i = 0; i < paulis.size(); i++)
+        {
+            const Symplectic_Vector vector = symplectic_vector(paulis[i]);
+
+            if (vector.is_zero() || (i > 0 && vector >= symplectic_vector(paulis[i - 1])) || pivots.shares_bit_with(vector.leading_bit()))
+            {
+                return false;
+            }
+
+            pivots |= vector.leading_bit();
+        }
+
+        for (const Pauli &pauli : paulis)
+        {
+            const Symplectic_Vector vector = symplectic_vector(pauli);
+
+            if ((vector & pivots) != vector.leading_bit())
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    bool Check_Matrix::operator==(const Check_Matrix &other) const
+    {
+        if (!is_canonical() || !other.is_canonical())
+        {
+            const Scratch_Scope scope(thread_scratch_arena());
+            Check_Matrix canonical_check_matrix(*this, &thread_scratch_arena());
+            Check_Matrix other_canonical_check_matrix(other, &thread_scratch_arena());
+            canonical_check_matrix.canonicalise();
+            other_canonical_check_matrix.canonicalise();
+
+            return canonical_check_matrix == other_canonical_check_matrix;
+        }
+
+        return number_qubits == other.number_qubits && paulis == other.paulis;
+    }
+
+    bool Check_Matrix::measure(const Pauli &observable, Random_Generator &generator)
+    {
+        if (observable.number_qubits != number_qubits || !observable.is_hermitian())
+        {
+            throw std::invalid_argument("The observable must be a Hermitian pauli on the same number of qubits as the check matrix.");
+        }
+
+        auto anticommuting = std::find_if(paulis.begin(), paulis.end(), [&observable](const Pauli &pauli) { return pauli.anticommutes_with(observable); });
+
+        if (anticommuting == paulis.end())
+        {
+            // The observable commutes with the whole group, so is +-1 times an element of it. The canonical paulis
+            // have distinct pivots, so the element is the product of those whose pivots are set in the observable.
+            canonicalise();
+
+            Pauli product(number_qubits, 0, 0, 0, 0);
+            Symplectic_Vector remainder = symplectic_vector(observable);
+
+            for (const Pauli &pauli : paulis)
+            {
+                const Symplectic_Vector vector = symplectic_vector(pauli);
+
+                if (remainder.shares_bit_with(vector.leading_bit()))
+                {
+                    remainder ^= vector;
+                    product.multiply_by_pauli_on_right(pauli);
+                }
+            }
+
+            return ((observable.get_phase_exponent() - product.get_phase_exponent()) & 7) == 4;
+        }
+
+        // Multiplying the other anticommuting paulis by this one leaves a generating set in which only it
+        // anticommutes with the observable, and the collapsed state is stabilised by the rest and +-observable
+        const bool outcome = generator.random_bit();
+        const Pauli anticommuting_pauli = *anticommuting;
+
+        for (auto pauli = paulis.begin(); pauli != paulis.end(); pauli++)
+        {
+            if (pauli != anticommuting && pauli->anticommutes_with(observable))
+            {
+                pauli->multiply_by_pauli_on_right(anticommuting_pauli);
+            }
+        }
+
+        *anticommuting = observable;
+        anticommuting->set_phase_exponent(observable.get_phase_exponent() + 4 * outcome);
+
+        categorise_paulis();
+        z_only_pivots.clear();
+        row_reduced = false;
+
+        return outcome;
+    }
+
+    bool Check_Matrix::measure(const std::size_t qubit, Random_Generator &generator)
+    {
+        if (qubit >= number_qubits)
+        {
+            throw std::invalid_argument("The qubit to measure must be less than the number of qubits.");
+        }
+
+        return measure(Pauli(number_qubits, 0, integral_pow_2(qubit), 0, 0), generator);
+    }
+
+    double Check_Matrix::marginal_probability(const std::size_t qubit_mask, const std::size_t outcomes) const
+    {
+        const Scratch_Scope scope(thread_scratch_arena());
+        Check_Matrix check_matrix(*this, &thread_scratch_arena());
+
+        return Stabiliser_State(check_matrix, &thread_scratch_arena()).marginal_probability(qubit_mask, outcomes);
+    }
+
+    bool is_stabiliser_group(std::span<const Pauli> paulis)
+    {
+        return stabiliser_group_error(paulis) == nullptr;
+    }
+
+    bool is_valid_check_matrix(std::span<const Pauli> paulis)
+    {
+        return (paulis.empty() || paulis.size() == paulis.front().number_qubits) && is_stabiliser_group(paulis);
+    }
+
+    Check_Matrix validated_check_matrix(std::span<const Pauli> paulis, const bool row_reduced)
+    {
+        if (const char *error = stabiliser_group_error(paulis))
+        {
+            throw std::invalid_argument(error);
+        }
+
+        if (!paulis.empty() && paulis.size() != paulis.front().number_qubits)
+        {
+            throw std::invalid_argument("A check matrix must have as many paulis as qubits.");
+        }
+
+        return Check_Matrix(paulis, row_reduced);
+    }
+}
+
+std::size_t std::hash<fst::Check_Matrix>::operator()(const fst::Check_Matrix &check_matrix) const
+{
+    if (!check_matrix.is_canonical())
+    {
+        const fst::Scratch_Scope scope(fst::thread_scratch_arena());
+        fst::Check_Matrix canonical_check_matrix(check_matrix, &fst::thread_scratch_arena());
+        canonical_check_matrix.canonicalise();
+
+        return (*this)(canonical_check_matrix);
+    }
+
+    std::size_t seed = check_matrix.number_qubits;
+
+    for (const fst::Pauli &pauli : check_matrix.get_paulis())
+    {
+        fst::hash_combine(seed, std::hash<fst::Pauli>{}(pauli));
+    }
+
+    return seed;
+}
@@ -5,39 +5,57 @@
 
 #include <vector>
 #include <complex>
-#include <unordered_set>
+#include <functional>
+#include <memory_resource>
+#include <span>
 
 namespace fst
 {
     struct Stabiliser_State;
+    class Random_Generator;
 
     /// The class used to represent a list of n commuting paulis, an alternative representation
     /// of a stabiliser state
+    ///
+    /// The paulis are allocated with the allocator the check matrix is constructed with, as for Stabiliser_State.
     struct Check_Matrix
     {
+        using allocator_type = std::pmr::polymorphic_allocator<>;
+
         std::size_t number_qubits = 0;
         
         // Get the list of Stabilisers
-        const std::vector<Pauli>& get_paulis() const;
+        const std::pmr::vector<Pauli>& get_paulis() const;
         // Set the list of Stabilisers
-        // TODO : use std::forward to reduce overhead?
-        void set_paulis(std::vector<Pauli> paulis_);
+        void set_paulis(std::span<const Pauli> paulis_);
         
         /// Paulis are sorted into 2 types: "z_only", which have no X component, and "x_stabilisers",
         /// which may have both an x and z component
-        const std::vector<Pauli *>& get_z_only_stabilisers() const;
-        const std::vector<Pauli *>& get_x_stabilisers() const;
+        const std::pmr::vector<Pauli *>& get_z_only_stabilisers() const;
+        const std::pmr::vector<Pauli *>& get_x_stabilisers() const;
 
         /// IF THE CHECK MATRIX IS ROW REDUCED, then this returns a list of the pivot columns of the "z_only"
         /// stabilisers (correspdonding to the order of the z_only_stabiliser list). The pivot column of a "z_only"
         /// stabiliser should contain a 1, where all other "z_only" stabiliers have a zero there. Moreover, it should *not*
         /// be a pivot_column for the "x_stabilisers".
-        const std::vector<size_t> & get_z_only_pivots() const;
+        const std::pmr::vector<size_t> & get_z_only_pivots() const;
         
         bool row_reduced;
 
-        explicit Check_Matrix(const std::vector<Pauli> paulis, const bool row_reduced = false);
-        explicit Check_Matrix(Stabiliser_State &stabiliser_state);
+        explicit Check_Matrix(std::span<const Pauli> paulis, const bool row_reduced = false, const allocator_type &allocator = {});
+        /// The check matrix of the trivial stabiliser group on the qubits, with no generators, for building a group up
+        /// with add_generator
+        explicit Check_Matrix(const std::size_t number_qubits, const allocator_type &allocator = {});
+        explicit Check_Matrix(Stabiliser_State &stabiliser_state, const allocator_type &allocator = {});
+
+        /// Copies and moves point their categorised stabilisers at their own paulis
+        Check_Matrix(const Check_Matrix &other);
+        Check_Matrix(const Check_Matrix &other, const allocator_type &allocator);
+        Check_Matrix &operator=(const Check_Matrix &other);
+        Check_Matrix(Check_Matrix &&other) = default;
+        Check_Matrix &operator=(Check_Matrix &&other);
+
+        allocator_type get_allocator() const;
 
         /// Return the state vector of length 2^n stabilised by each of the Paulis in the check matrix
         std::vector<std::complex<float>> get_state_vector();
@@ -48,24 +66,103 @@ namespace fst
         /// echelon form.
         void row_reduce();
 
+        /// Puts the check matrix in its canonical form: the reduced row echelon form of the whole stabiliser group,
+        /// viewing each pauli as the vector x_vector * 2^n + z_vector. The paulis are sorted by decreasing pivot, so
+        /// the "x_stabilisers" come first, and the signs are those of the resulting elements of the group. The
+        /// canonical form only depends on the stabiliser group, and is also row reduced in the sense above.
+        void canonicalise();
+
+        /// Whether the paulis are in canonical form, checked in O(n^2) time
+        bool is_canonical() const;
+
+        /// Whether the check matrices generate the same stabiliser group. This takes O(n^2) time when both are
+        /// canonical, and otherwise compares canonicalised copies.
+        bool operator==(const Check_Matrix &other) const;
+
+        // Incremental updates, which keep the check matrix row reduced (row reducing it first if it is not) without
+        // reducing it again from scratch. The new generator is reduced by the pivots of the others, and any new pivot
+        // it has is cleared from the others of its type, so each update takes O(n) pauli multiplications, i.e.
+        // O(n^2 / 64) time. Like row_reduce, they may change the other generators, but not the group they generate.
+        //
+        // Each throws (leaving the check matrix unchanged) if the new generator is not a Hermitian pauli on the
+        // qubits of the check matrix that commutes with the other generators, or is in the group they generate.
+
+        /// Replaces the generator at the index of get_paulis()
+        void replace_generator(const std::size_t index, const Pauli &generator);
+
+        /// Replaces the generator at the index by its product with the pauli on the right, which must commute with it
+        void multiply_generator(const std::size_t index, const Pauli &pauli);
+
+        /// Adds and removes generators, for check matrices of partial stabiliser groups with fewer than n generators.
+        /// Adding throws if there are already n generators. Removing moves the last generator to the index of the
+        /// removed one. Other methods, such as get_state_vector, measure and serialisation, need all n generators, and
+        /// serialisation throws without them.
+        void add_generator(const Pauli &generator);
+        void remove_generator(const std::size_t index);
+
+        /// Measures the Hermitian pauli observable, returning the outcome m for the eigenvalue (-1)^m, and updates the
+        /// paulis to generate the stabiliser group of the collapsed state, in O(n^2) time. As in Aaronson & Gottesman,
+        /// if some pauli anticommutes with the observable, the outcome is uniformly random, and that pauli is replaced
+        /// by (-1)^m times the observable. Otherwise the outcome is deterministic, and is read off from the canonical
+        /// form, which the check matrix is left in.
+        bool measure(const Pauli &observable, Random_Generator &generator);
+
+        /// Measures the given qubit in the computational basis, i.e. the observable Z on that qubit
+        bool measure(const std::size_t qubit, Random_Generator &generator);
+
+        /// Returns the probability that measuring the qubits set in qubit_mask in the computational basis gives the
+        /// corresponding bits of outcomes, as for Stabiliser_State::marginal_probability
+        double marginal_probability(const std::size_t qubit_mask, const std::size_t outcomes) const;
+
         private:
 
-        std::vector<Pauli> paulis;
-        std::vector<Pauli *> z_only_stabilisers;
-        std::vector<Pauli *> x_stabilisers;
+        std::pmr::vector<Pauli> paulis;
+        std::pmr::vector<Pauli *> z_only_stabilisers;
+        std::pmr::vector<Pauli *> x_stabilisers;
         
-        std::vector<size_t> z_only_pivots;
+        std::pmr::vector<size_t> z_only_pivots;
                 
         void categorise_paulis();
+
+        /// Points the categorised stabilisers at the paulis with the same indices as those of other
+        void copy_categories(const Check_Matrix &other, const Pauli *other_paulis);
         
-        void add_z_only_stabilisers(const std::vector<std::size_t> &pivot_vectors, const std::unordered_set<std::size_t> &pivot_indices_set, const Stabiliser_State &state);
-		void add_x_stabilisers(const std::vector<std::size_t> &pivot_vectors, const Stabiliser_State &state);  
+        void add_z_only_stabilisers(const std::size_t pivot_mask, const Stabiliser_State &state);
+		void add_x_stabilisers(const Stabiliser_State &state);  
 
         void row_reduce_x_stabilisers();
         void row_reduce_z_only_stabilisers();
 
         void set_z_only_pivots();
+
+        /// Helpers for the incremental updates. The excluded pauli (if any) is the one being replaced, which is
+        /// ignored when checking and reducing the new generator.
+        void check_generator(const Pauli &generator, const Pauli *excluded) const;
+        Pauli reduce_generator(Pauli generator, const Pauli *excluded) const;
+        void remove_from_categories(const Pauli *pauli);
+        void insert_reduced_generator(Pauli *pauli);
     };
+
+    /// Whether the paulis generate a stabiliser group: they are Hermitian paulis on the same number of qubits (at
+    /// least as many as the paulis) which pairwise commute and are independent, so the group does not contain -I.
+    /// The commutation matrix of m paulis is built a word per row, and their rank is found by elimination on their
+    /// x and z words, so this takes O(m^2) word operations.
+    bool is_stabiliser_group(std::span<const Pauli> paulis);
+
+    /// Whether the paulis are a valid check matrix, i.e. the n generators of the stabiliser group of an n qubit state
+    bool is_valid_check_matrix(std::span<const Pauli> paulis);
+
+    /// Returns the check matrix of the paulis, as the constructor does, throwing std::invalid_argument with the reason
+    /// if they are not a valid check matrix. The constructor does not check its paulis, and other methods may give
+    /// garbage if they are invalid.
+    Check_Matrix validated_check_matrix(std::span<const Pauli> paulis, const bool row_reduced = false);
 }
 
+/// Hashes the canonical form of the check matrix, so that equal check matrices have equal hashes
+template <>
+struct std::hash<fst::Check_Matrix>
+{
+    std::size_t operator()(const fst::Check_Matrix &check_matrix) const;
+};
+
 #endif
\ No newline at end of file
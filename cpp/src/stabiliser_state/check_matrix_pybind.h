@@ -5,7 +5,12 @@
 #include <pybind11/complex.h>
 #include <pybind11/stl.h>
 
+#include <optional>
+
 #include "check_matrix.h"
+#include "pauli/packed_paulis_pybind.h"
+#include "serialisation/pickle_pybind.h"
+#include "util/random.h"
 
 namespace py = pybind11;
 using namespace fst;
@@ -18,13 +23,46 @@ namespace fst_pybind
         py::class_<Check_Matrix>(m, "Check_Matrix")
             .def_readwrite("number_qubits", &Check_Matrix::number_qubits, "int\t\tThe number of qubits")
             .def_readwrite("row_reduced", &Check_Matrix::row_reduced, "bool")
-            .def("set_paulis", &Check_Matrix::set_paulis, py::arg("paulis"), "Sets the list of stabilisers for the stabiliser state")
+            .def("set_paulis", [](Check_Matrix &check_matrix, const std::vector<Pauli> &paulis) { check_matrix.set_paulis(paulis); }, py::arg("paulis"), "Sets the list of stabilisers for the stabiliser state")
             .def("get_paulis", &Check_Matrix::get_paulis, "Gets the list[Pauli] of stabilisers for the stabiliser state")
-            .def(py::init<const std::vector<Pauli>, const bool>(), py::arg("paulis"), py::arg("row_reduced") = false)
+            .def(py::init<const std::size_t>(), py::arg("number_qubits"), "The check matrix of the trivial stabiliser group on the qubits, with no generators, for building a group up with add_generator")
+            .def(py::init([](const std::vector<Pauli> &paulis, const bool row_reduced, const bool validate)
+                {
+                    return validate ? validated_check_matrix(paulis, row_reduced) : Check_Matrix(paulis, row_reduced);
+                }),
+                py::arg("paulis"), py::arg("row_reduced") = false, py::arg("validate") = false,
+                "With validate, throws unless the paulis are a valid check matrix: n independent, pairwise commuting, Hermitian Paulis on n qubits")
             .def(py::init<Stabiliser_State &>(), py::arg("stabiliser_state"))
+            .def_static("from_numpy", [](const py::array &x_bits, const py::array &z_bits, const std::optional<py::array> &signs, const std::optional<std::size_t> number_qubits,
+                    const bool validate)
+                {
+                    const std::vector<Pauli> paulis = paulis_from_numpy(number_qubits.value_or(number_rows(x_bits)), x_bits, z_bits, signs);
+                    return validate ? validated_check_matrix(paulis) : Check_Matrix(paulis);
+                },
+                py::arg("x_bits"), py::arg("z_bits"), py::arg("signs") = py::none(), py::arg("number_qubits") = py::none(), py::arg("validate") = false,
+                "Returns the check matrix of the Paulis in the format of paulis_to_numpy, such as the stabilisers of a stim tableau, with one Pauli per qubit unless number_qubits is given. With validate, throws unless the Paulis are a valid check matrix")
+            .def("to_numpy", [](const Check_Matrix &check_matrix, const bool bit_packed) { return paulis_to_numpy(check_matrix.get_paulis(), bit_packed); }, py::arg("bit_packed") = false,
+                "Returns the Paulis as numpy arrays (x_bits, z_bits, signs), in the format of paulis_to_numpy")
             .def("get_state_vector", &Check_Matrix::get_state_vector, "Returns the state vector of length 2^n stabilised by each of the Paulis in the check matrix")
             .def("row_reduce", &Check_Matrix::row_reduce, "Row reduces the check matrix, giving a new set of Paulis that generates the same stabiliser group.\n\nPaulis are sorted into 2 types: \"z_only\", which have no X component, and \"x_stabilisers\", which may have both an x and z component. After performing this function, the x_vectors of the new \"x_stabiliser\" Paulis and the z_vectors of the new \"z_only\" stabilisers are in reduced row echelon form. Note that the collection of all the Paulis' z_vectors may NOT be in reduced row echelon form")
+            .def("canonicalise", &Check_Matrix::canonicalise, "Puts the check matrix in its canonical form, the reduced row echelon form of the whole stabiliser group (viewing each Pauli as the vector x_vector * 2^n + z_vector), sorted by decreasing pivot")
+            .def("is_canonical", &Check_Matrix::is_canonical, "Returns whether the Paulis are in canonical form")
+            .def("replace_generator", &Check_Matrix::replace_generator, py::arg("index"), py::arg("generator"), "Replaces the generator at the index of get_paulis(), keeping the check matrix row reduced in O(n^2 / 64) time. Throws unless the generator is a Hermitian Pauli commuting with, and independent of, the other generators")
+            .def("multiply_generator", &Check_Matrix::multiply_generator, py::arg("index"), py::arg("pauli"), "Replaces the generator at the index by its product with the Pauli on the right, as for replace_generator")
+            .def("add_generator", &Check_Matrix::add_generator, py::arg("generator"), "Adds a generator to a check matrix of a partial stabiliser group with fewer than n generators, as for replace_generator")
+            .def("remove_generator", &Check_Matrix::remove_generator, py::arg("index"), "Removes the generator at the index, moving the last generator to its place, and leaves a check matrix of a partial stabiliser group")
+            .def("measure", py::overload_cast<const Pauli &, Random_Generator &>(&Check_Matrix::measure), py::arg("observable"), py::arg("generator"), "Measures the Hermitian Pauli observable, returning the outcome m (for the eigenvalue (-1)^m) as a bool, and updates the Paulis to generate the stabiliser group of the collapsed state in O(n^2) time")
+            .def("measure", py::overload_cast<const std::size_t, Random_Generator &>(&Check_Matrix::measure), py::arg("qubit"), py::arg("generator"), "Measures the given qubit in the computational basis, returning the outcome as a bool, and collapses the state")
+            .def("marginal_probability", &Check_Matrix::marginal_probability, py::arg("qubit_mask"), py::arg("outcomes"), "Returns the probability that measuring the qubits set in qubit_mask in the computational basis gives the corresponding bits of outcomes, without collapsing the state. For the prefix b of length k of the measured bit string, use qubit_mask = 2^k - 1")
+            .def("__eq__", &Check_Matrix::operator==, py::arg("other"), "Returns whether the check matrices generate the same stabiliser group")
+            .def("__hash__", [](const Check_Matrix &check_matrix) { return std::hash<Check_Matrix>{}(check_matrix); })
+            .def(get_pickle<Check_Matrix>(&deserialise_check_matrix))
             .doc() = "The class used to represent a list of n commuting Paulis, an alternative representation of a stabiliser state";
+
+        m.def("is_stabiliser_group", [](const std::vector<Pauli> &paulis) { return is_stabiliser_group(paulis); }, py::arg("paulis"),
+            "Returns whether the list of Paulis generates a stabiliser group: they are Hermitian Paulis on the same number of qubits, which pairwise commute and are independent, in O(m^2) word operations for m Paulis");
+        m.def("is_valid_check_matrix", [](const std::vector<Pauli> &paulis) { return is_valid_check_matrix(paulis); }, py::arg("paulis"),
+            "Returns whether the list of Paulis generates a stabiliser group and has one Pauli for each qubit");
     }
 }
 
@@ -0,0 +1,199 @@
+#include "composition.h"
+#include "util/bit_kernels.h"
+#include "util/f2_helper.h"
+
+#include <bit>
+#include <stdexcept>
+
+namespace fst
+{
+	namespace
+	{
+		bool quadratic_coefficient(const Stabiliser_State &state, const std::size_t i, const std::size_t j)
+		{
+			const auto coefficient = state.quadratic_form.find(integral_pow_2(i) | integral_pow_2(j));
+			return coefficient != state.quadratic_form.end() && coefficient->second;
+		}
+
+		void check_tensor_qubits(const std::size_t first_qubits, const std::size_t second_qubits)
+		{
+			if (first_qubits + second_qubits > 64)
+			{
+				throw std::invalid_argument("The tensor product must have at most 64 qubits.");
+			}
+		}
+	}
+
+	Stabiliser_State tensor(const Stabiliser_State &first, const Stabiliser_State &second)
+	{
+		check_tensor_qubits(first.number_qubits, second.number_qubits);
+
+		const std::size_t offset = second.number_qubits;
+		const std::size_t dim_offset = second.dim;
+
+		Stabiliser_State product(first.number_qubits + second.number_qubits, first.dim + second.dim);
+		product.basis_vectors.reserve(product.dim);
+		product.basis_vectors.assign(second.basis_vectors.begin(), second.basis_vectors.end());
+
+		for (const std::size_t vector : first.basis_vectors)
+		{
+			product.basis_vectors.push_back(vector << offset);
+		}
+
+		product.shift = (first.shift << offset) | second.shift;
+		product.real_linear_part = (first.real_linear_part << dim_offset) | second.real_linear_part;
+		product.imaginary_part = (first.imaginary_part << dim_offset) | second.imaginary_part;
+		product.global_phase = first.global_phase * second.global_phase;
+
+		// The imaginary parts combine as i^(a + b) = i^(a + b mod 2) (-1)^(a b) for a = m_1.c_1 and b = m_2.c_2 (mod 2),
+		// so Q(e_i, e_j) gains m_i m_j between a basis vector i of the second state and j of the first
+		product.quadratic_form[0] = 0;
+
+		for (std::size_t j = 0; j < product.dim; j++)
+		{
+			for (std::size_t i = 0; i < j; i++)
+			{
+				bool coefficient;
+
+				if (j < dim_offset)
+				{
+					coefficient = quadratic_coefficient(second, i, j);
+				}
+				else if (i >= dim_offset)
+				{
+					coefficient = quadratic_coefficient(first, i - dim_offset, j - dim_offset);
+				}
+				else
+				{
+					coefficient = bit_set_at(product.imaginary_part, i) && bit_set_at(product.imaginary_part, j);
+				}
+
+				product.quadratic_form[integral_pow_2(i) | integral_pow_2(j)] = coefficient;
+			}
+		}
+
+		return product;
+	}
+
+	Check_Matrix tensor(const Check_Matrix &first, const Check_Matrix &second)
+	{
+		check_tensor_qubits(first.number_qubits, second.number_qubits);
+
+		std::vector<Pauli> paulis;
+		paulis.reserve(first.number_qubits + second.number_qubits);
+
+		for (const Pauli &pauli : second.get_paulis())
+		{
+			paulis.push_back(tensor(Pauli(first.number_qubits, 0, 0, 0, 0), pauli));
+		}
+
+		for (const Pauli &pauli : first.get_paulis())
+		{
+			paulis.push_back(tensor(pauli, Pauli(second.number_qubits, 0, 0, 0, 0)));
+		}
+
+		return Check_Matrix(paulis);
+	}
+
+	Stabiliser_State permute_qubits(const Stabiliser_State &state, std::span<const std::size_t> permutation)
+	{
+		if (!is_bit_permutation(permutation, state.number_qubits))
+		{
+			throw std::invalid_argument("The permutation must be a permutation of the qubits.");
+		}
+
+		// Only the support moves, as the forms are functions of the coordinates in the basis
+		Stabiliser_State permuted = state;
+
+		for (std::size_t &vector : permuted.basis_vectors)
+		{
+			vector = permute_bits(vector, permutation);
+		}
+
+		permuted.shift = permute_bits(state.shift, permutation);
+		permuted.row_reduced = false;
+
+		return permuted;
+	}
+
+	Check_Matrix permute_qubits(const Check_Matrix &check_matrix, std::span<const std::size_t> permutation)
+	{
+		std::vector<Pauli> paulis;
+		paulis.reserve(check_matrix.number_qubits);
+
+		for (const Pauli &pauli : check_matrix.get_paulis())
+		{
+			paulis.push_back(permute_qubits(pauli, permutation));
+		}
+
+		return Check_Matrix(paulis);
+	}
+
+	std::vector<Pauli> partial_trace(const Check_Matrix &check_matrix, const std::size_t traced_qubits)
+	{
+		const std::size_t number_qubits = check_matrix.number_qubits;
+		const std::size_t all_qubits = number_qubits == 64 ? ~std::size_t(0) : integral_pow_2(number_qubits) - 1;
+
+		if ((traced_qubits & ~all_qubits) != 0)
+		{
+			throw std::invalid_argument("The traced qubits must be less than the number of qubits.");
+		}
+
+		std::vector<Pauli> paulis(check_matrix.get_paulis().begin(), check_matrix.get_paulis().end());
+		std::size_t rank = 0;
+
+		// Eliminate each x and z column of the traced qubits, so that the paulis after the pivots act as the
+		// identity on the traced qubits. Those paulis generate the subgroup doing so, as the pivots are independent there.
+		for (std::size_t column = 0; column < 2 * number_qubits; column++)
+		{
+			const std::size_t qubit = column % number_qubits;
+
+			if (!bit_set_at(traced_qubits, qubit))
+			{
+				continue;
+			}
+
+			const auto has_bit = [&](const Pauli &pauli) { return bit_set_at(column < number_qubits ? pauli.x_vector : pauli.z_vector, qubit); };
+
+			std::size_t pivot = rank;
+
+			while (pivot < paulis.size() && !has_bit(paulis[pivot]))
+			{
+				pivot++;
+			}
+
+			if (pivot == paulis.size())
+			{
+				continue;
+			}
+
+			std::swap(paulis[rank], paulis[pivot]);
+
+			for (std::size_t i = rank + 1; i < paulis.size(); i++)
+			{
+				if (has_bit(paulis[i]))
+				{
+					paulis[i].multiply_by_pauli_on_right(paulis[rank]);
+				}
+			}
+
+			rank++;
+		}
+
+		const std::size_t kept_qubits = all_qubits & ~traced_qubits;
+		std::vector<Pauli> reduced_paulis;
+		reduced_paulis.reserve(paulis.size() - rank);
+
+		for (std::size_t i = rank; i < paulis.size(); i++)
+		{
+			Pauli reduced = paulis[i];
+			reduced.number_qubits = std::popcount(kept_qubits);
+			reduced.x_vector = extract_bits(paulis[i].x_vector, kept_qubits);
+			reduced.z_vector = extract_bits(paulis[i].z_vector, kept_qubits);
+
+			reduced_paulis.push_back(reduced);
+		}
+
+		return reduced_paulis;
+	}
+}
@@ -0,0 +1,33 @@
+#ifndef _FAST_STABILISER_COMPOSITION_H
+#define _FAST_STABILISER_COMPOSITION_H
+
+#include "check_matrix.h"
+#include "stabiliser_state.h"
+
+#include <span>
+#include <vector>
+
+namespace fst
+{
+	/// Returns the tensor product of the states, equal to np.kron of their state vectors: the qubits of the second
+	/// state come first, followed by those of the first. The bases, linear and quadratic forms are concatenated in
+	/// O((dim_1 + dim_2)^2) time, with no state vectors. Throws if the product has more than 64 qubits.
+	Stabiliser_State tensor(const Stabiliser_State &first, const Stabiliser_State &second);
+
+	/// Returns the check matrix of the tensor product of the states, in the order of tensor for stabiliser states,
+	/// in O(n) time
+	Check_Matrix tensor(const Check_Matrix &first, const Check_Matrix &second);
+
+	/// Returns the state with qubit q moved to qubit permutation[q], in O(n dim) time. Throws unless the
+	/// permutation is a permutation of the qubits.
+	Stabiliser_State permute_qubits(const Stabiliser_State &state, std::span<const std::size_t> permutation);
+	Check_Matrix permute_qubits(const Check_Matrix &check_matrix, std::span<const std::size_t> permutation);
+
+	/// Returns generators of the reduced stabiliser group of the qubits not in traced_qubits, i.e. the elements of
+	/// the stabiliser group that act as the identity on the traced qubits, restricted to the remaining qubits (in
+	/// order). The reduced state is 2^-m times the sum of the group, for m remaining qubits, so it is pure exactly
+	/// when there are m generators. This is Gaussian elimination on the columns of the traced qubits, in O(n^2) time.
+	std::vector<Pauli> partial_trace(const Check_Matrix &check_matrix, const std::size_t traced_qubits);
+}
+
+#endif
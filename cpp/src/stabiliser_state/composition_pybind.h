@@ -0,0 +1,33 @@
+#ifndef _FAST_STABILISER_COMPOSITION_PYBIND_H
+#define _FAST_STABILISER_COMPOSITION_PYBIND_H
+
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+
+#include <vector>
+
+#include "composition.h"
+
+namespace py = pybind11;
+using namespace fst;
+
+namespace fst_pybind
+{
+	void init_composition(py::module_ &m)
+	{
+		m.def("tensor", py::overload_cast<const Stabiliser_State &, const Stabiliser_State &>(&tensor), py::arg("first"), py::arg("second"),
+			"Returns the tensor product of the stabiliser states, equal to np.kron of their state vectors, in polynomial time");
+		m.def("tensor", py::overload_cast<const Check_Matrix &, const Check_Matrix &>(&tensor), py::arg("first"), py::arg("second"),
+			"Returns the check matrix of the tensor product of the states, with the qubits of the second first");
+
+		m.def("permute_qubits", [](const Stabiliser_State &state, const std::vector<std::size_t> &permutation) { return permute_qubits(state, permutation); },
+			py::arg("stabiliser_state"), py::arg("permutation"), "Returns the stabiliser state with qubit q moved to qubit permutation[q]");
+		m.def("permute_qubits", [](const Check_Matrix &check_matrix, const std::vector<std::size_t> &permutation) { return permute_qubits(check_matrix, permutation); },
+			py::arg("check_matrix"), py::arg("permutation"), "Returns the check matrix with qubit q moved to qubit permutation[q]");
+
+		m.def("partial_trace", &partial_trace, py::arg("check_matrix"), py::arg("traced_qubits"),
+			"Returns a list of generators of the reduced stabiliser group of the qubits not in the bit mask traced_qubits, i.e. the stabilisers acting as the identity on the traced qubits, restricted to the remaining qubits in order. The reduced state is pure exactly when there is one generator per remaining qubit");
+	}
+}
+
+#endif
@@ -0,0 +1,348 @@
+#ifndef _FAST_STABILISER_FIXED_STABILISER_STATE_H
+#define _FAST_STABILISER_FIXED_STABILISER_STATE_H
+
+#include "stabiliser_state.h"
+#include "util/f2_helper.h"
+#include "util/fixed_size.h"
+#include "util/phase.h"
+#include "util/stats.h"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <complex>
+#include <concepts>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+namespace fst
+{
+	/// A stabiliser state on a number of qubits N fixed at compile time, stored in the same way as Stabiliser_State
+	/// but without any heap allocation: the basis is a std::array, and the quadratic form is stored as the rows of
+	/// its (symmetric, zero diagonal) matrix rather than as a map. The loops over the qubits then have constant
+	/// bounds, which the compiler can unroll.
+	template <std::size_t N>
+	struct Fixed_Stabiliser_State
+	{
+		static_assert(N <= max_fixed_qubits, "Fixed size stabiliser states are only instantiated for small N");
+
+		static constexpr std::size_t number_qubits = N;
+		static constexpr std::size_t state_vector_size = integral_pow_2(N);
+
+		std::array<std::size_t, N> basis_vectors {};
+		std::size_t dim = 0;
+		std::size_t shift = 0;
+
+		std::size_t real_linear_part = 0;
+		std::size_t imaginary_part = 0;
+
+		/// quadratic_rows[i] has j-th bit Q(e_i, e_j)
+		std::array<std::size_t, N> quadratic_rows {};
+		std::complex<float> global_phase = 1.0f;
+
+		bool row_reduced = false;
+
+		Fixed_Stabiliser_State() = default;
+
+		/// Copies a stabiliser state on N qubits, throwing std::invalid_argument for any other number of qubits
+		explicit Fixed_Stabiliser_State(const Stabiliser_State &state)
+			: dim(state.dim), shift(state.shift), real_linear_part(state.real_linear_part), imaginary_part(state.imaginary_part),
+			global_phase(state.global_phase), row_reduced(state.row_reduced)
+		{
+			if (state.number_qubits != N)
+			{
+				throw std::invalid_argument("The state is on a different number of qubits.");
+			}
+
+			for (std::size_t i = 0; i < dim; i++)
+			{
+				basis_vectors[i] = state.basis_vectors[i];
+
+				for (std::size_t j = 0; j < i; j++)
+				{
+					const bool entry = state.quadratic_form.at(integral_pow_2(i) | integral_pow_2(j));
+					quadratic_rows[i] |= entry * integral_pow_2(j);
+					quadratic_rows[j] |= entry * integral_pow_2(i);
+				}
+			}
+		}
+
+		Stabiliser_State to_stabiliser_state(const Stabiliser_State::allocator_type &allocator = {}) const
+		{
+			Stabiliser_State state(N, dim, allocator);
+			state.basis_vectors.assign(basis_vectors.begin(), basis_vectors.begin() + dim);
+			state.shift = shift;
+			state.real_linear_part = real_linear_part;
+			state.imaginary_part = imaginary_part;
+			state.global_phase = global_phase;
+			state.row_reduced = row_reduced;
+
+			state.quadratic_form.reserve(dim * (dim - 1) / 2 + 1);
+			state.quadratic_form[0] = 0;
+
+			for (std::size_t i = 0; i < dim; i++)
+			{
+				for (std::size_t j = i + 1; j < dim; j++)
+				{
+					state.quadratic_form[integral_pow_2(i) | integral_pow_2(j)] = bit_set_at(quadratic_rows[i], j);
+				}
+			}
+
+			return state;
+		}
+
+		/// Writes the state vector (with respect to the computational basis) into state_vector, without allocating
+		void write_state_vector(const std::span<std::complex<float>, state_vector_size> state_vector) const
+		{
+			std::fill(state_vector.begin(), state_vector.end(), std::complex<float>(0));
+
+			const std::complex<float> first_entry = global_phase / float(std::sqrt(integral_pow_2(dim)));
+			state_vector[shift] = first_entry;
+
+			std::size_t vector_index = 0;
+			std::size_t total_index = shift;
+			bool imag_exponent = 0;
+			Phase_Exponent phase_exponent = 0;
+			FST_COUNT(gray_code_steps, integral_pow_2(dim) - 1);
+
+			for (std::size_t iterate = 1; iterate < integral_pow_2(dim); iterate++)
+			{
+				// Iterate through the Gray code
+				const std::size_t new_vector_index = iterate ^ (iterate >> 1);
+				const std::size_t flipped_bit = std::countr_zero(iterate);
+
+				total_index ^= basis_vectors[flipped_bit];
+				const bool real_update_exponent = bit_set_at(real_linear_part, flipped_bit) ^ f2_dot_product(quadratic_rows[flipped_bit], vector_index);
+				const bool new_imag_exponent = bit_set_at(imaginary_part, flipped_bit) ^ imag_exponent;
+
+				// multiply by i if going from 1 to i, multiply by -i = w^6 if going from i to 1
+				phase_exponent += 4 * real_update_exponent + 2 * new_imag_exponent + 6 * imag_exponent;
+				state_vector[total_index] = multiply_by_phase(first_entry, phase_exponent);
+
+				vector_index = new_vector_index;
+				imag_exponent = new_imag_exponent;
+			}
+		}
+
+		/// Return the state vector of length 2^N of the stabiliser state (with respect to the computational basis)
+		std::vector<std::complex<float>> get_state_vector() const
+		{
+			std::vector<std::complex<float>> state_vector(state_vector_size);
+			FST_COUNT(bytes_allocated, state_vector_size * sizeof(std::complex<float>));
+			write_state_vector(std::span<std::complex<float>, state_vector_size>(state_vector));
+
+			return state_vector;
+		}
+	};
+
+	/// The fixed size version of the conversion in stabiliser_state_from_statevector.cpp. The support is not
+	/// collected, as only the indices at positions 2^j (giving the basis) and the number of non-zero amplitudes
+	/// are needed; the amplitudes at the other points of the affine space are then read from the state vector.
+	template <std::size_t N, bool assume_valid, bool return_state, std::floating_point Real>
+	auto fixed_stabiliser_from_statevector_internal(const std::span<const std::complex<Real>, integral_pow_2(N)> statevector)
+		-> std::conditional_t<return_state, std::optional<Fixed_Stabiliser_State<N>>, bool>
+	{
+		constexpr std::size_t state_vector_size = integral_pow_2(N);
+
+		std::size_t shift = 0;
+
+		while (shift < state_vector_size && statevector[shift] == Real(0))
+		{
+			++shift;
+		}
+
+		if (shift == state_vector_size)
+		{
+			FST_COUNT(rejected_support, 1);
+			return {};
+		}
+
+		Fixed_Stabiliser_State<N> state;
+		std::array<std::size_t, N> &basis_vectors = state.basis_vectors;
+
+		// The j-th basis vector is (index ^ shift) for the 2^j-th index of the support, in increasing order
+		std::size_t support_size = 0;
+
+		for (std::size_t index = shift; index < state_vector_size; index++)
+		{
+			if (statevector[index] != Real(0))
+			{
+				if (support_size != 0 && is_power_of_2(support_size))
+				{
+					basis_vectors[std::countr_zero(support_size)] = index ^ shift;
+				}
+
+				support_size++;
+			}
+		}
+
+		if (!is_power_of_2(support_size))
+		{
+			FST_COUNT(rejected_support, 1);
+			return {};
+		}
+
+		const std::size_t dimension = integral_log_2(support_size);
+		const std::complex<Real> first_entry = statevector[shift];
+		const std::complex<Real> global_phase = Real(std::sqrt(support_size)) * first_entry;
+
+		if (std::abs(std::norm(global_phase) - 1) >= 0.125)
+		{
+			FST_COUNT(rejected_normalisation, 1);
+			return {};
+		}
+
+		std::size_t real_linear_part = 0;
+		std::size_t imaginary_part = 0;
+
+		for (std::size_t j = 0; j < dimension; j++)
+		{
+			const std::optional<Phase_Exponent> phase_exponent = quarter_phase_exponent(statevector[shift ^ basis_vectors[j]] / first_entry);
+
+			if (!phase_exponent)
+			{
+				FST_COUNT(rejected_phase, 1);
+				return {};
+			}
+
+			// The phase is (-1)^(real_linear_part_j) * i^(imaginary_part_j)
+			real_linear_part ^= integral_pow_2(j) * (*phase_exponent >= 4);
+			imaginary_part ^= integral_pow_2(j) * ((*phase_exponent >> 1) & 1);
+		}
+
+		std::array<std::size_t, N> &quadratic_rows = state.quadratic_rows;
+
+		for (std::size_t j = 0; j < dimension; j++)
+		{
+			for (std::size_t i = j + 1; i < dimension; i++)
+			{
+				const std::size_t vector_index = integral_pow_2(i) | integral_pow_2(j);
+
+				const std::optional<Phase_Exponent> phase_exponent = quarter_phase_exponent(statevector[shift ^ basis_vectors[i] ^ basis_vectors[j]] / first_entry);
+
+				if (!phase_exponent)
+				{
+					FST_COUNT(rejected_phase, 1);
+					return {};
+				}
+
+				const Phase_Exponent linear_exponent = 4 * f2_dot_product(vector_index, real_linear_part) + 2 * f2_dot_product(vector_index, imaginary_part);
+				const Phase_Exponent quadratic_form_exponent = (*phase_exponent - linear_exponent) & 7;
+
+				if (quadratic_form_exponent != 0 && quadratic_form_exponent != 4)
+				{
+					FST_COUNT(rejected_phase, 1);
+					return {};
+				}
+
+				const bool quadratic_form_entry = quadratic_form_exponent == 4;
+				quadratic_rows[i] |= quadratic_form_entry * integral_pow_2(j);
+				quadratic_rows[j] |= quadratic_form_entry * integral_pow_2(i);
+			}
+		}
+
+		if constexpr (!assume_valid)
+		{
+			// The walk below visits 2^dimension distinct points only if the basis is independent, and then the
+			// support has exactly those points
+			std::array<std::size_t, N> reduced_basis = basis_vectors;
+
+			for (std::size_t i = 0; i < dimension; i++)
+			{
+				if (reduced_basis[i] == 0)
+				{
+					FST_COUNT(rejected_support, 1);
+					return {};
+				}
+
+				const std::size_t pivot = std::bit_floor(reduced_basis[i]);
+
+				for (std::size_t k = i + 1; k < dimension; k++)
+				{
+					reduced_basis[k] ^= reduced_basis[i] * ((reduced_basis[k] & pivot) != 0);
+				}
+			}
+
+			std::size_t vector_index = 0;
+			bool imag_exponent = 0;
+			std::size_t total_index = shift;
+			Phase_Exponent phase_exponent = 0;
+
+			for (std::size_t iterate = 1; iterate < support_size; iterate++)
+			{
+				// Iterate through the Gray code
+				const std::size_t new_vector_index = iterate ^ (iterate >> 1);
+				const std::size_t flipped_bit = std::countr_zero(iterate);
+
+				total_index ^= basis_vectors[flipped_bit];
+				const bool real_update_exponent = bit_set_at(real_linear_part, flipped_bit) ^ f2_dot_product(quadratic_rows[flipped_bit], vector_index);
+
+				const bool new_imag_exponent = bit_set_at(imaginary_part, flipped_bit) ^ imag_exponent;
+				// multiply by i if going from 1 to i, multiply by -i = w^6 if going from i to 1
+				phase_exponent += 4 * real_update_exponent + 2 * new_imag_exponent + 6 * imag_exponent;
+
+				if (!amplitudes_match(statevector[total_index], multiply_by_phase(first_entry, phase_exponent)))
+				{
+					FST_COUNT(gray_code_steps, iterate);
+					FST_COUNT(rejected_amplitude, 1);
+					return {};
+				}
+
+				vector_index = new_vector_index;
+				imag_exponent = new_imag_exponent;
+			}
+
+			FST_COUNT(gray_code_steps, support_size - 1);
+		}
+
+		if constexpr (return_state)
+		{
+			state.dim = dimension;
+			state.shift = shift;
+			state.real_linear_part = real_linear_part;
+			state.imaginary_part = imaginary_part;
+			state.global_phase = std::complex<float>(global_phase);
+			state.row_reduced = true;
+			return state;
+		}
+		else
+		{
+			return true;
+		}
+	}
+
+	/// Convert a state vector of 2^N complex amplitudes into a fixed size stabiliser state object, throwing
+	/// std::invalid_argument if it is not a stabiliser state. This gives the same state as the generic
+	/// stabiliser_from_statevector, which calls this for at most max_fixed_qubits qubits. The amplitudes may be
+	/// single or double precision, and are compared in that precision.
+	///
+	/// Assuming valid is faster, but will result in undefined behaviour if the state vector is not in fact a
+	/// valid stabiliser state
+	template <std::size_t N, std::floating_point Real>
+	Fixed_Stabiliser_State<N> stabiliser_from_statevector(const std::span<const std::complex<Real>, integral_pow_2(N)> statevector, const bool assume_valid = false)
+	{
+		std::optional<Fixed_Stabiliser_State<N>> state = assume_valid
+															? fixed_stabiliser_from_statevector_internal<N, true, true, Real>(statevector)
+															: fixed_stabiliser_from_statevector_internal<N, false, true, Real>(statevector);
+
+		if (!state)
+		{
+			throw std::invalid_argument("State was not a stabiliser state");
+		}
+
+		return *state;
+	}
+
+	/// Test whether a state vector of 2^N complex amplitudes corresponds to a stabiliser state, without allocating
+	template <std::size_t N, std::floating_point Real>
+	bool is_stabiliser_state(const std::span<const std::complex<Real>, integral_pow_2(N)> statevector)
+	{
+		return fixed_stabiliser_from_statevector_internal<N, false, false, Real>(statevector);
+	}
+}
+
+#endif
@@ -0,0 +1,68 @@
+#include "random_stabiliser_state.h"
+#include "pauli/random_pauli.h"
+
+namespace fst
+{
+	Check_Matrix random_check_matrix(const std::size_t number_qubits, Random_Generator &generator)
+	{
+		return Check_Matrix(random_symplectic_paulis(number_qubits, generator).first);
+	}
+
+	Stabiliser_State random_stabiliser_state(const std::size_t number_qubits, Random_Generator &generator)
+	{
+		Check_Matrix check_matrix = random_check_matrix(number_qubits, generator);
+		return Stabiliser_State(check_matrix);
+	}
+
+	std::vector<Check_Matrix> random_check_matrices(const std::size_t number_qubits, const std::size_t count, Random_Generator &generator)
+	{
+		std::vector<Check_Matrix> check_matrices;
+		check_matrices.reserve(count);
+
+		for (std::size_t i = 0; i < count; i++)
+		{
+			check_matrices.push_back(random_check_matrix(number_qubits, generator));
+		}
+
+		return check_matrices;
+	}
+
+	std::vector<Stabiliser_State> random_stabiliser_states(const std::size_t number_qubits, const std::size_t count, Random_Generator &generator)
+	{
+		std::vector<Stabiliser_State> states;
+		states.reserve(count);
+
+		for (std::size_t i = 0; i < count; i++)
+		{
+			states.push_back(random_stabiliser_state(number_qubits, generator));
+		}
+
+		return states;
+	}
+
+	void perturb_statevector(std::vector<std::complex<float>> &vector, Random_Generator &generator)
+	{
+		std::complex<float> &entry = vector[generator.random_below(vector.size())];
+
+		if (entry == .0f)
+		{
+			entry = 1;
+		}
+		else if (generator.random_bit())
+		{
+			entry *= std::complex<float>(0, 1);
+		}
+		else
+		{
+			entry = 0;
+		}
+	}
+
+	std::vector<std::complex<float>> random_almost_stabiliser_statevector(const std::size_t number_qubits, Random_Generator &generator)
+	{
+		std::vector<std::complex<float>> vector = random_stabiliser_state(number_qubits, generator).get_state_vector();
+		perturb_statevector(vector, generator);
+
+		return vector;
+	}
+}
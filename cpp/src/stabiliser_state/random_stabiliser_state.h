@@ -0,0 +1,33 @@
+#ifndef _FAST_STABILISER_RANDOM_STABILISER_STATE_H
+#define _FAST_STABILISER_RANDOM_STABILISER_STATE_H
+
+#include "check_matrix.h"
+#include "stabiliser_state.h"
+#include "util/random.h"
+
+#include <complex>
+#include <vector>
+
+namespace fst
+{
+	/// Returns the check matrix of a uniformly random stabiliser state, i.e. the images of the Z_i under a
+	/// uniformly random Clifford, in O(n^2) time
+	Check_Matrix random_check_matrix(const std::size_t number_qubits, Random_Generator &generator);
+
+	/// Returns a uniformly random stabiliser state (with global phase 1)
+	Stabiliser_State random_stabiliser_state(const std::size_t number_qubits, Random_Generator &generator);
+
+	/// Return count independent uniformly random check matrices or stabiliser states
+	std::vector<Check_Matrix> random_check_matrices(const std::size_t number_qubits, const std::size_t count, Random_Generator &generator);
+	std::vector<Stabiliser_State> random_stabiliser_states(const std::size_t number_qubits, const std::size_t count, Random_Generator &generator);
+
+	/// Modifies a random entry of the vector: a non-zero entry is multiplied by i or set to zero (each with
+	/// probability 1/2), and a zero entry is set to one
+	void perturb_statevector(std::vector<std::complex<float>> &vector, Random_Generator &generator);
+
+	/// Returns the state vector of a uniformly random stabiliser state, perturbed by perturb_statevector. For more
+	/// than a couple of qubits this is almost never a stabiliser state, so is a hard case for is_stabiliser_state
+	std::vector<std::complex<float>> random_almost_stabiliser_statevector(const std::size_t number_qubits, Random_Generator &generator);
+}
+
+#endif
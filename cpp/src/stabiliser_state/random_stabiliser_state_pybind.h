@@ -0,0 +1,24 @@
+#ifndef _FAST_STABILISER_RANDOM_STABILISER_STATE_PYBIND_H
+#define _FAST_STABILISER_RANDOM_STABILISER_STATE_PYBIND_H
+
+#include <pybind11/pybind11.h>
+#include <pybind11/complex.h>
+#include <pybind11/stl.h>
+
+#include "random_stabiliser_state.h"
+
+namespace py = pybind11;
+using namespace fst;
+
+namespace fst_pybind
+{
+	void init_random_stabiliser_state(py::module_ &m)
+	{
+		m.def("random_check_matrix", &random_check_matrix, py::arg("number_qubits"), py::arg("generator"), "Returns the check matrix of a uniformly random stabiliser state");
+		m.def("random_stabiliser_state", &random_stabiliser_state, py::arg("number_qubits"), py::arg("generator"), "Returns a uniformly random stabiliser state with global phase 1");
+		m.def("random_stabiliser_states", &random_stabiliser_states, py::arg("number_qubits"), py::arg("count"), py::arg("generator"), "Returns a list of count independent uniformly random stabiliser states");
+		m.def("random_almost_stabiliser_statevector", &random_almost_stabiliser_statevector, py::arg("number_qubits"), py::arg("generator"), "Returns the state vector of a uniformly random stabiliser state with a random entry modified");
+	}
+}
+
+#endif
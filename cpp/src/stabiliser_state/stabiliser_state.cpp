@@ -2,53 +2,58 @@
 #include "check_matrix.h"
 #include "util/f2_helper.h"
 #include "pauli/pauli.h"
+#include "util/hash.h"
+#include "util/random.h"
+#include "util/scratch_arena.h"
+#include "util/stats.h"
 
+#include <array>
+#include <bit>
 #include <cmath>
-#include <iostream>
+#include <stdexcept>
 
 using namespace std;
 
 namespace fst
 {
-	bool verbose = false;
+	Stabiliser_State::Stabiliser_State(const allocator_type &allocator)
+		: basis_vectors(allocator), quadratic_form(allocator)
+	{
+	}
+
+	Stabiliser_State::Stabiliser_State(const std::size_t number_qubits, const std::size_t dim, const allocator_type &allocator)
+		: number_qubits(number_qubits), basis_vectors(allocator), dim(dim), quadratic_form(allocator)
+	{
+	}
+
+	Stabiliser_State::Stabiliser_State(const std::size_t number_qubits, const allocator_type &allocator)
+		: Stabiliser_State(number_qubits, number_qubits, allocator)
+	{
+	}
 
-	Stabiliser_State::Stabiliser_State(const std::size_t number_qubits, const std::size_t dim)
-		: number_qubits(number_qubits), dim(dim)
+	Stabiliser_State::Stabiliser_State(const Stabiliser_State &other, const allocator_type &allocator)
+		: number_qubits(other.number_qubits), basis_vectors(other.basis_vectors, allocator), dim(other.dim), shift(other.shift),
+		  real_linear_part(other.real_linear_part), imaginary_part(other.imaginary_part), quadratic_form(other.quadratic_form, allocator),
+		  global_phase(other.global_phase), row_reduced(other.row_reduced)
 	{
 	}
 
-	Stabiliser_State::Stabiliser_State(const std::size_t number_qubits)
-		: Stabiliser_State(number_qubits, number_qubits)
+	Stabiliser_State::allocator_type Stabiliser_State::get_allocator() const
 	{
+		return basis_vectors.get_allocator();
 	}
 
-	Stabiliser_State::Stabiliser_State(Check_Matrix &check_matrix)
+	Stabiliser_State::Stabiliser_State(Check_Matrix &check_matrix, const allocator_type &allocator)
+		: Stabiliser_State(allocator)
 	{
+		FST_TIME_SCOPE(state_from_check_matrix);
+
 		number_qubits = check_matrix.number_qubits;
 
 		check_matrix.row_reduce();
 		dim = check_matrix.get_x_stabilisers().size();
 
-		if (verbose)
-		{
-			cout << "dim of V is " << dim << "\n";
-			cout << "Currently, shift is " << shift << "\n";
-		}
-
 		set_support_from_cm(check_matrix);
-		string basis_vecs("");
-		for (std::size_t num : basis_vectors)
-		{
-			basis_vecs += to_string(num);
-			basis_vecs += " ";
-		}
-
-		if (verbose)
-		{
-			cout << "Basis vectors: " << basis_vecs << "\n";
-			cout << "Shift: " << shift << "\n";
-		}
-
 		set_linear_and_quadratic_forms_from_cm(check_matrix);
 
 		row_reduced = true;
@@ -67,13 +72,6 @@ namespace fst
 
 		for (std::size_t i = 0; i < number_qubits - dim; i++)
 		{
-			if (verbose)
-			{
-				cout << "z vector: " << check_matrix.get_z_only_stabilisers()[i]->z_vector << "\n";
-				cout << "z_only_pivot: " << check_matrix.get_z_only_pivots()[i] << "\n";
-				cout << "sign bit: " << check_matrix.get_z_only_stabilisers()[i]->sign_bit << "\n";
-			}
-			
 			shift |= integral_pow_2( check_matrix.get_z_only_pivots()[i] ) * (check_matrix.get_z_only_stabilisers()[i]->sign_bit);
 		}
 	}
@@ -103,48 +101,54 @@ namespace fst
         }
 	}
 
-	std::vector<std::complex<float>> Stabiliser_State::get_state_vector() const
+	Support_Range Stabiliser_State::support() const
 	{
-		const std::size_t support_size = integral_pow_2(dim);
-		std::vector<std::complex<float>> state_vector(integral_pow_2(number_qubits), 0);
-
-		std::size_t vector_index = 0;
-		bool imag_exponent = 0;
-		std::size_t total_index = shift;
-		std::complex<float> phase = global_phase / float(std::sqrt(support_size));
+		return Support_Range{this};
+	}
 
-		state_vector[total_index] = phase;
+	template <std::floating_point Real>
+	std::vector<std::complex<Real>> Stabiliser_State::get_state_vector() const
+	{
+		FST_TIME_SCOPE(state_vector);
 
-		for (std::size_t iterate = 1; iterate < support_size; iterate++)
-		{
-			// Iterate through the Gray code
-			std::size_t new_vector_index = iterate ^ (iterate >> 1);
-			std::size_t flipped_bit = integral_log_2(vector_index ^ new_vector_index);
+		std::vector<std::complex<Real>> state_vector(integral_pow_2(number_qubits), 0);
+		FST_COUNT(bytes_allocated, state_vector.size() * sizeof(std::complex<Real>));
+		FST_COUNT(gray_code_steps, integral_pow_2(dim) - 1);
 
-			total_index ^= basis_vectors[flipped_bit];
-			float real_linear_phase_update = f_min1_pow(bit_set_at(real_linear_part, flipped_bit));
+		// Only the phases are taken from the walk, so the amplitudes are formed in the requested precision
+		const std::complex<Real> normalised_global_phase = std::complex<Real>(global_phase) / Real(std::sqrt(integral_pow_2(dim)));
 
-			bool new_imag_exponent = bit_set_at(imaginary_part, flipped_bit) ^ imag_exponent;
-			// multiply by i if going from 1 to i, multiply by -i if going from i to 1
-			std::complex<float> imaginary_phase_update {(float) 1-(imag_exponent^new_imag_exponent), (float) (imag_exponent^new_imag_exponent)*(1-2*imag_exponent)};
+		for (Support_Iterator iterator(*this); iterator != std::default_sentinel; ++iterator)
+		{
+			state_vector[(*iterator).first] = multiply_by_phase(normalised_global_phase, iterator.amplitude_phase_exponent());
+		}
+		
+		return state_vector;
+	}
 
-			bool quadratic_update_exponent = 0;
+	template std::vector<std::complex<float>> Stabiliser_State::get_state_vector<float>() const;
+	template std::vector<std::complex<double>> Stabiliser_State::get_state_vector<double>() const;
 
-			for (std::size_t j = 0; j < dim; j++)
-			{
-				quadratic_update_exponent ^= (quadratic_form.at(integral_pow_2(flipped_bit) ^ integral_pow_2(j)) & bit_set_at(vector_index, j));
-			}
+	std::pair<std::vector<std::size_t>, std::vector<std::complex<float>>> Stabiliser_State::get_sparse_state_vector() const
+	{
+		FST_TIME_SCOPE(state_vector);
 
-			float quadratic_phase_update = f_min1_pow(quadratic_update_exponent);
+		const std::size_t support_size = integral_pow_2(dim);
 
-			phase *= real_linear_phase_update * imaginary_phase_update * quadratic_phase_update;
+		std::vector<std::size_t> indices;
+		indices.reserve(support_size);
+		std::vector<std::complex<float>> amplitudes;
+		amplitudes.reserve(support_size);
+		FST_COUNT(bytes_allocated, support_size * (sizeof(std::size_t) + sizeof(std::complex<float>)));
+		FST_COUNT(gray_code_steps, support_size - 1);
 
-			state_vector[total_index] = phase;
-			vector_index = new_vector_index;
-			imag_exponent = new_imag_exponent;
+		for (const auto [index, amplitude] : support())
+		{
+			indices.push_back(index);
+			amplitudes.push_back(amplitude);
 		}
-		
-		return state_vector;
+
+		return {std::move(indices), std::move(amplitudes)};
 	}
 
 	void Stabiliser_State::row_reduce_basis()
@@ -167,18 +171,418 @@ namespace fst
 		row_reduced = true;
     }
 
-    void Stabiliser_State::add_vi_to_vj(const std::size_t i, const std::size_t j, const std::size_t v_i)
-    {
-        basis_vectors[j] ^= v_i;
+	void Stabiliser_State::add_vi_to_vj(const std::size_t i, const std::size_t j, const std::size_t v_i)
+	{
+		FST_COUNT(row_reduction_ops, 1);
 
-        imaginary_part ^= integral_pow_2(j) * bit_set_at(imaginary_part, i);
-		real_linear_part ^= integral_pow_2(j) * bit_set_at(real_linear_part, j);
+		// In the new basis, the coordinate c_i of the old basis becomes c_i + c_j, so the terms involving c_i
+		// gain a c_j. In particular, Q(e_i, e_j) c_i c_j gains Q(e_i, e_j) c_j^2 = Q(e_i, e_j) c_j.
+		basis_vectors[j] ^= v_i;
 
-        for (std::size_t k = 0; k < dim; k++)
-        {
-            quadratic_form[integral_pow_2(k) ^ integral_pow_2(j)] ^= (quadratic_form[integral_pow_2(k) ^ integral_pow_2(i)] & (k!=j));
-        }
+		imaginary_part ^= integral_pow_2(j) * bit_set_at(imaginary_part, i);
+		real_linear_part ^= integral_pow_2(j) * (bit_set_at(real_linear_part, i) ^ quadratic_form.at(integral_pow_2(i) | integral_pow_2(j)));
 
-        quadratic_form[integral_pow_2(j)] ^= quadratic_form[integral_pow_2(i)];
-    }
+		for (std::size_t k = 0; k < dim; k++)
+		{
+			if (k != i && k != j)
+			{
+				quadratic_form.at(integral_pow_2(k) | integral_pow_2(j)) ^= quadratic_form.at(integral_pow_2(k) | integral_pow_2(i));
+			}
+		}
+	}
+
+	void Stabiliser_State::swap_basis_vectors(const std::size_t i, const std::size_t j)
+	{
+		if (i == j) {return;}
+
+		std::swap(basis_vectors[i], basis_vectors[j]);
+
+		const std::size_t swap_mask = integral_pow_2(i) | integral_pow_2(j);
+
+		if (bit_set_at(real_linear_part, i) != bit_set_at(real_linear_part, j))
+		{
+			real_linear_part ^= swap_mask;
+		}
+
+		if (bit_set_at(imaginary_part, i) != bit_set_at(imaginary_part, j))
+		{
+			imaginary_part ^= swap_mask;
+		}
+
+		for (std::size_t k = 0; k < dim; k++)
+		{
+			if (k != i && k != j)
+			{
+				std::swap(quadratic_form.at(integral_pow_2(k) | integral_pow_2(i)), quadratic_form.at(integral_pow_2(k) | integral_pow_2(j)));
+			}
+		}
+	}
+
+	void Stabiliser_State::add_vj_to_shift(const std::size_t j)
+	{
+		// The amplitude at the new shift is the old amplitude at shift + v_j, and in the new coordinates c_j
+		// becomes c_j + 1. Then Q(e_j, e_k) c_j c_k gains Q(e_j, e_k) c_k, and i^(m.c) gains (-1)^(m_j m.c).
+		shift ^= basis_vectors[j];
+
+		const bool real_bit = bit_set_at(real_linear_part, j);
+		const bool imag_bit = bit_set_at(imaginary_part, j);
+		global_phase = multiply_by_phase(global_phase, 4 * real_bit + 2 * imag_bit);
+
+		for (std::size_t k = 0; k < dim; k++)
+		{
+			if (k != j)
+			{
+				real_linear_part ^= integral_pow_2(k) * quadratic_form.at(integral_pow_2(j) | integral_pow_2(k));
+			}
+		}
+
+		if (imag_bit)
+		{
+			real_linear_part ^= imaginary_part;
+		}
+	}
+
+	void Stabiliser_State::canonicalise()
+	{
+		quadratic_form[0] = 0;
+
+		row_reduced = false;
+		row_reduce_basis();
+
+		// Sort the basis by pivot
+		for (std::size_t i = 0; i < dim; i++)
+		{
+			std::size_t smallest = i;
+
+			for (std::size_t j = i + 1; j < dim; j++)
+			{
+				if (basis_vectors[j] < basis_vectors[smallest])
+				{
+					smallest = j;
+				}
+			}
+
+			swap_basis_vectors(i, smallest);
+		}
+
+		// Make the shift zero at the pivots
+		for (std::size_t j = 0; j < dim; j++)
+		{
+			const std::size_t pivot_index = integral_log_2(basis_vectors[j]);
+
+			if (bit_set_at(shift, pivot_index))
+			{
+				add_vj_to_shift(j);
+			}
+		}
+	}
+
+	bool Stabiliser_State::is_canonical() const
+	{
+		std::size_t pivots = 0;
+
+		for (std::size_t j = 0; j < dim; j++)
+		{
+			if ((j > 0 && basis_vectors[j] <= basis_vectors[j - 1]) || (pivots & std::bit_floor(basis_vectors[j])) != 0)
+			{
+				return false;
+			}
+
+			pivots |= std::bit_floor(basis_vectors[j]);
+		}
+
+		for (std::size_t j = 0; j < dim; j++)
+		{
+			if ((basis_vectors[j] & pivots) != std::bit_floor(basis_vectors[j]))
+			{
+				return false;
+			}
+		}
+
+		return (shift & pivots) == 0;
+	}
+
+	bool Stabiliser_State::operator==(const Stabiliser_State &other) const
+	{
+		if (!is_canonical() || !other.is_canonical())
+		{
+			const Scratch_Scope scope(thread_scratch_arena());
+			Stabiliser_State canonical_state(*this, &thread_scratch_arena());
+			Stabiliser_State other_canonical_state(other, &thread_scratch_arena());
+			canonical_state.canonicalise();
+			other_canonical_state.canonicalise();
+
+			return canonical_state == other_canonical_state;
+		}
+
+		if (number_qubits != other.number_qubits || dim != other.dim || shift != other.shift || basis_vectors != other.basis_vectors
+			|| real_linear_part != other.real_linear_part || imaginary_part != other.imaginary_part
+			|| std::norm(global_phase - other.global_phase) >= 0.001)
+		{
+			return false;
+		}
+
+		for (std::size_t i = 0; i < dim; i++)
+		{
+			for (std::size_t j = i + 1; j < dim; j++)
+			{
+				if (quadratic_form.at(integral_pow_2(i) | integral_pow_2(j)) != other.quadratic_form.at(integral_pow_2(i) | integral_pow_2(j)))
+				{
+					return false;
+				}
+			}
+		}
+
+		return true;
+	}
+
+	bool Stabiliser_State::measure(const Pauli &observable, Random_Generator &generator)
+	{
+		if (observable.number_qubits != number_qubits || !observable.is_hermitian())
+		{
+			throw std::invalid_argument("The observable must be a Hermitian pauli on the same number of qubits as the state.");
+		}
+
+		row_reduce_basis();
+
+		// Write the x part of the observable in the basis, which the row reduced basis reads off at its pivots
+		std::size_t coordinates = 0;
+		std::size_t remainder = observable.x_vector;
+
+		for (std::size_t j = 0; j < dim; j++)
+		{
+			if ((remainder & std::bit_floor(basis_vectors[j])) != 0)
+			{
+				coordinates |= integral_pow_2(j);
+				remainder ^= basis_vectors[j];
+			}
+		}
+
+		// beta_j = z.v_j, so that the sign (-1)^(z.(shift + sum c_j v_j)) of the Z part is (-1)^(z.shift + beta.c)
+		std::size_t z_products = 0;
+
+		for (std::size_t j = 0; j < dim; j++)
+		{
+			z_products |= integral_pow_2(j) * f2_dot_product(observable.z_vector, basis_vectors[j]);
+		}
+
+		if (remainder != 0)
+		{
+			// The observable P maps the support to a disjoint affine space, so each outcome has probability 1/2, and
+			// the state collapses to (|psi> + (-1)^m P|psi>) / sqrt(2). This is supported on the space extended by the
+			// x part of P, where the new coordinate contributes the phase of P and the signs of its Z part.
+			const bool outcome = generator.random_bit();
+			add_basis_vector(observable.x_vector, z_products,
+				observable.get_phase_exponent() + 4 * (f2_dot_product(observable.z_vector, shift) ^ outcome));
+
+			return outcome;
+		}
+
+		// Otherwise P preserves the support, mapping c to c + coordinates, and comparing the forms there gives
+		// <shift + V c|P|psi> = w^k (-1)^(l.c) <shift + V c|psi> for a phase w^k (a power of i) and a linear form l.
+		// The imaginary part contributes i^(m.(c + coordinates) - m.c) = i^(m.coordinates) (-1)^((m.coordinates) (m.c)),
+		// with the dot products taken mod 2.
+		const bool imaginary_value = f2_dot_product(imaginary_part, coordinates);
+		std::size_t linear_form = z_products ^ (imaginary_part * imaginary_value);
+
+		for (std::size_t j = 0; j < dim; j++)
+		{
+			bool coefficient = 0;
+
+			for (std::size_t i = 0; i < dim; i++)
+			{
+				if (i != j && bit_set_at(coordinates, i))
+				{
+					coefficient ^= quadratic_form.at(integral_pow_2(i) | integral_pow_2(j));
+				}
+			}
+
+			linear_form ^= integral_pow_2(j) * coefficient;
+		}
+
+		bool quadratic_value = 0;
+
+		for (std::size_t i = 0; i < dim; i++)
+		{
+			for (std::size_t j = i + 1; j < dim; j++)
+			{
+				quadratic_value ^= bit_set_at(coordinates, i) && bit_set_at(coordinates, j) && quadratic_form.at(integral_pow_2(i) | integral_pow_2(j));
+			}
+		}
+
+		const Phase_Exponent phase_exponent = observable.get_phase_exponent()
+			+ 4 * (f2_dot_product(observable.z_vector, shift ^ observable.x_vector) ^ f2_dot_product(real_linear_part, coordinates) ^ quadratic_value)
+			+ 2 * imaginary_value;
+
+		// When l = 0, the state is an eigenstate of P, with eigenvalue w^k = +-1. Otherwise <psi|P|psi> = 0, so the
+		// outcome is uniformly random, and the state collapses to (1 + (-1)^m w^k (-1)^(l.c)) |psi> / sqrt(2).
+		if (linear_form == 0)
+		{
+			return (phase_exponent & 7) == 4;
+		}
+
+		const bool outcome = generator.random_bit();
+		const Phase_Exponent outcome_phase_exponent = (phase_exponent + 4 * outcome) & 7;
+
+		if (outcome_phase_exponent == 2 || outcome_phase_exponent == 6)
+		{
+			// (1 + i^s (-1)^(l.c)) / sqrt(2) = w^s i^(-s (l.c)) for s = +-1 leaves the support. Writing i^(x mod 2) as
+			// i^x (-1)^(x choose 2) for the integer x = sum_j x_j, the product i^(m.c) i^(-s (l.c)) is i^(m'.c) for
+			// m' = m + l, up to signs (-1)^(c_j) where m_j - s l_j is 2 or -1, and the quadratic terms m_i l_j + l_i m_j.
+			const bool anticlockwise = outcome_phase_exponent == 2;
+			global_phase = multiply_by_phase(global_phase, anticlockwise ? 1 : 7);
+
+			for (std::size_t i = 0; i < dim; i++)
+			{
+				for (std::size_t j = i + 1; j < dim; j++)
+				{
+					if ((bit_set_at(imaginary_part, i) && bit_set_at(linear_form, j)) != (bit_set_at(linear_form, i) && bit_set_at(imaginary_part, j)))
+					{
+						quadratic_form.at(integral_pow_2(i) | integral_pow_2(j)) ^= 1;
+					}
+				}
+			}
+
+			real_linear_part ^= linear_form & (anticlockwise ? ~imaginary_part : imaginary_part);
+			imaginary_part ^= linear_form;
+
+			return outcome;
+		}
+
+		// Otherwise the state collapses onto the half of the space where l.c = (outcome_phase_exponent == 4).
+		// Changing basis so that l.c is the coordinate c_k, the constraint fixes c_k.
+		const std::size_t k = std::countr_zero(linear_form);
+
+		for (std::size_t j = 0; j < dim; j++)
+		{
+			if (j != k && bit_set_at(linear_form, j))
+			{
+				add_vi_to_vj(k, j, basis_vectors[k]);
+			}
+		}
+
+		if (outcome_phase_exponent == 4)
+		{
+			add_vj_to_shift(k);
+		}
+
+		swap_basis_vectors(k, dim - 1);
+		remove_last_basis_vector();
+
+		return outcome;
+	}
+
+	bool Stabiliser_State::measure(const std::size_t qubit, Random_Generator &generator)
+	{
+		if (qubit >= number_qubits)
+		{
+			throw std::invalid_argument("The qubit to measure must be less than the number of qubits.");
+		}
+
+		return measure(Pauli(number_qubits, 0, integral_pow_2(qubit), 0, 0), generator);
+	}
+
+	double Stabiliser_State::marginal_probability(const std::size_t qubit_mask, const std::size_t outcomes) const
+	{
+		// The outcomes are uniformly distributed over the support, and the restriction to the measured qubits is an
+		// affine map of rank r, so each reachable outcome has probability 2^(-r). Eliminate over the restricted basis,
+		// with each new vector reduced by the earlier ones, to find the rank and whether the outcome is reachable.
+		std::array<std::size_t, 64> restricted_basis;
+		std::size_t rank = 0;
+
+		for (std::size_t j = 0; j < dim; j++)
+		{
+			std::size_t vector = basis_vectors[j] & qubit_mask;
+
+			for (std::size_t i = 0; i < rank; i++)
+			{
+				if ((vector & std::bit_floor(restricted_basis[i])) != 0)
+				{
+					vector ^= restricted_basis[i];
+				}
+			}
+
+			if (vector != 0)
+			{
+				restricted_basis[rank++] = vector;
+			}
+		}
+
+		std::size_t target = (outcomes ^ shift) & qubit_mask;
+
+		for (std::size_t i = 0; i < rank; i++)
+		{
+			if ((target & std::bit_floor(restricted_basis[i])) != 0)
+			{
+				target ^= restricted_basis[i];
+			}
+		}
+
+		return target == 0 ? std::ldexp(1.0, -static_cast<int>(rank)) : 0.0;
+	}
+
+	void Stabiliser_State::add_basis_vector(const std::size_t vector, const std::size_t quadratic_coefficients, const Phase_Exponent phase_exponent)
+	{
+		// The amplitudes with c_dim = 1 gain the phase w^phase_exponent (a power of i) and (-1)^(Q(e_j, e_dim) c_j).
+		// A factor of i is the imaginary bit for c_dim, as i^(m.c) i^(c_dim) = i^(m.c + c_dim mod 2) (-1)^((m.c) c_dim).
+		const bool imag_bit = (phase_exponent >> 1) & 1;
+
+		for (std::size_t j = 0; j < dim; j++)
+		{
+			quadratic_form[integral_pow_2(j) | integral_pow_2(dim)] = bit_set_at(quadratic_coefficients, j) ^ (imag_bit && bit_set_at(imaginary_part, j));
+		}
+
+		basis_vectors.push_back(vector);
+		real_linear_part |= integral_pow_2(dim) * ((phase_exponent & 7) >= 4);
+		imaginary_part |= integral_pow_2(dim) * imag_bit;
+		dim++;
+
+		row_reduced = false;
+	}
+
+	void Stabiliser_State::remove_last_basis_vector()
+	{
+		// Restricts to c_(dim - 1) = 0, dropping the terms involving it
+		dim--;
+		basis_vectors.pop_back();
+
+		for (std::size_t j = 0; j < dim; j++)
+		{
+			quadratic_form.erase(integral_pow_2(j) | integral_pow_2(dim));
+		}
+
+		real_linear_part &= ~integral_pow_2(dim);
+		imaginary_part &= ~integral_pow_2(dim);
+
+		row_reduced = false;
+	}
+}
+
+std::size_t std::hash<fst::Stabiliser_State>::operator()(const fst::Stabiliser_State &state) const
+{
+	if (!state.is_canonical())
+	{
+		const fst::Scratch_Scope scope(fst::thread_scratch_arena());
+		fst::Stabiliser_State canonical_state(state, &fst::thread_scratch_arena());
+		canonical_state.canonicalise();
+
+		return (*this)(canonical_state);
+	}
+
+	std::size_t seed = state.number_qubits;
+	fst::hash_combine(seed, state.shift);
+	fst::hash_combine(seed, state.real_linear_part);
+	fst::hash_combine(seed, state.imaginary_part);
+
+	for (std::size_t i = 0; i < state.dim; i++)
+	{
+		fst::hash_combine(seed, state.basis_vectors[i]);
+
+		for (std::size_t j = i + 1; j < state.dim; j++)
+		{
+			fst::hash_combine(seed, state.quadratic_form.at(fst::integral_pow_2(i) | fst::integral_pow_2(j)));
+		}
+	}
+
+	return seed;
 }
@@ -2,18 +2,22 @@
 #define _FAST_STABILISER_STABILISER_STATE_H
 
 #include "pauli/pauli.h"
+#include "support_iterator.h"
 
 #include <vector>
 #include <complex>
+#include <concepts>
+#include <functional>
+#include <memory_resource>
 #include <unordered_map>
+#include <utility>
 
 // TODO: enforce quadratic_form[0] = 0
 // TODO: make quadratic_form opaque so it behaves as you expect (and reduce copying)
 namespace fst
 {
-	extern bool verbose;
-
 	struct Check_Matrix;
+	class Random_Generator;
 
 	/// The class used to represent a stabiliser state
 	///
@@ -22,10 +26,15 @@ namespace fst
 	/// More precisely, it is stored as a list of basis vectors for a vector space,
 	/// a constant vector that is added to every element of the vector space to reach,
 	/// the affine space, and a quadratic and linear form defined on the vector space.
+	///
+	/// The basis and quadratic form are allocated with the allocator the state is constructed with. As for the
+	/// standard containers, copies use the default allocator unless given one, and moves keep the allocator.
 	struct Stabiliser_State
 	{
+		using allocator_type = std::pmr::polymorphic_allocator<>;
+
 		std::size_t number_qubits = 0;
-		std::vector<std::size_t> basis_vectors;
+		std::pmr::vector<std::size_t> basis_vectors;
 		std::size_t dim = 0;
 		std::size_t shift = 0;
 
@@ -34,27 +43,75 @@ namespace fst
 		
 		/// The quadratic form is stored as map. It should always have quadratic_form[0] = 0
 		/// Q(e_i, e_j) is stored as quadratic_form[2^i ^ 2^j] 
-		std::unordered_map<std::size_t, bool> quadratic_form;
+		std::pmr::unordered_map<std::size_t, bool> quadratic_form;
 		std::complex<float> global_phase = 1.0;
 		
 		bool row_reduced = false;
 
 		Stabiliser_State() = default;
-		Stabiliser_State(const std::size_t number_qubits, const std::size_t dim);
-		explicit Stabiliser_State(const std::size_t number_qubits);
+		explicit Stabiliser_State(const allocator_type &allocator);
+		Stabiliser_State(const std::size_t number_qubits, const std::size_t dim, const allocator_type &allocator = {});
+		explicit Stabiliser_State(const std::size_t number_qubits, const allocator_type &allocator = {});
 		
-		explicit Stabiliser_State(Check_Matrix &check_matrix);
+		explicit Stabiliser_State(Check_Matrix &check_matrix, const allocator_type &allocator = {});
+
+		Stabiliser_State(const Stabiliser_State &other) = default;
+		Stabiliser_State(Stabiliser_State &&other) = default;
+		Stabiliser_State &operator=(const Stabiliser_State &other) = default;
+		Stabiliser_State &operator=(Stabiliser_State &&other) = default;
+
+		/// Copies the state, allocating with the given allocator
+		Stabiliser_State(const Stabiliser_State &other, const allocator_type &allocator);
+
+		allocator_type get_allocator() const;
 
 		/// Return the state vector of length 2^n of the stabiliser state (with respect
-		/// to the computational basis)
-		std::vector<std::complex<float>> get_state_vector() const;
+		/// to the computational basis). Instantiated for float and double amplitudes.
+		template <std::floating_point Real = float>
+		std::vector<std::complex<Real>> get_state_vector() const;
+
+		/// Return only the non-zero amplitudes of the stabiliser state, as a list of basis indices and a
+		/// list of the amplitudes at those indices (each of length 2^dim). The entries are in the order of the
+		/// Gray code walk over the affine space, so are not sorted by index.
+		std::pair<std::vector<std::size_t>, std::vector<std::complex<float>>> get_sparse_state_vector() const;
+
+		/// Return a lazy range over the (basis index, amplitude) pairs of the non-zero amplitudes, in the same
+		/// Gray code order as get_sparse_state_vector(), holding only O(n) state. The range refers to this
+		/// instance, which must outlive it and not be modified while it is in use.
+		Support_Range support() const;
 		
 		/// Row reduces the basis to reduced row-echelon form. Note that the quadratic form and 
 		/// the real and imaginary linear parts are also updated, so the instance represents the
 		/// same stabiliser state
 		void row_reduce_basis();
 
-		bool operator==(const Stabiliser_State &other) const = default;
+		/// Puts the state in its canonical form: the basis is row reduced and sorted by pivot, and the shift is zero
+		/// at the pivots, with the linear and quadratic forms and the global phase updated so the instance represents
+		/// the same stabiliser state. Then the global phase is that of the amplitude at the shift, and two states
+		/// are equal exactly when their canonical forms are.
+		void canonicalise();
+
+		/// Whether the basis and shift are in canonical form, checked in O(dim^2) time
+		bool is_canonical() const;
+
+		/// Whether the states have the same state vector, up to a small error in the global phase. This takes
+		/// O(n^2) time when both states are canonical, and otherwise compares canonicalised copies.
+		bool operator==(const Stabiliser_State &other) const;
+
+		/// Measures the Hermitian pauli observable, returning the outcome m for the eigenvalue (-1)^m, and collapses
+		/// the instance onto the corresponding eigenspace, in O(n^2) time. If the observable moves the affine space off
+		/// itself, the outcome is uniformly random and the space gains a dimension. Otherwise the observable preserves
+		/// the support, and either fixes the state (so the outcome is deterministic), or the outcome is uniformly random
+		/// and the space is halved or the forms gain a phase.
+		bool measure(const Pauli &observable, Random_Generator &generator);
+
+		/// Measures the given qubit in the computational basis, i.e. the observable Z on that qubit
+		bool measure(const std::size_t qubit, Random_Generator &generator);
+
+		/// Returns the probability that measuring the qubits set in qubit_mask in the computational basis gives the
+		/// corresponding bits of outcomes, in O(n^2) time without collapsing the state. For example, the probability
+		/// of a prefix b of length k of the measured bit string is marginal_probability(2^k - 1, b).
+		double marginal_probability(const std::size_t qubit_mask, const std::size_t outcomes) const;
 		
 		private:
 
@@ -62,7 +119,19 @@ namespace fst
 		void set_linear_and_quadratic_forms_from_cm(const Check_Matrix &check_matrix);
 
 		void add_vi_to_vj(const std::size_t i, const std::size_t j, const std::size_t v_i);
+		void swap_basis_vectors(const std::size_t i, const std::size_t j);
+		void add_vj_to_shift(const std::size_t j);
+
+		void add_basis_vector(const std::size_t vector, const std::size_t quadratic_coefficients, const Phase_Exponent phase_exponent);
+		void remove_last_basis_vector();
 	};
 }
 
+/// Hashes the canonical form of the state (ignoring the global phase), so that equal states have equal hashes
+template <>
+struct std::hash<fst::Stabiliser_State>
+{
+	std::size_t operator()(const fst::Stabiliser_State &state) const;
+};
+
 #endif
\ No newline at end of file
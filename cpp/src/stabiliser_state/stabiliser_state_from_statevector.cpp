@@ -1,7 +1,16 @@
 #include "stabiliser_state_from_statevector.h"
+#include "fixed_stabiliser_state.h"
 
 #include "util/f2_helper.h"
-
+#include "util/fixed_size.h"
+#include "util/phase.h"
+#include "util/scratch_arena.h"
+#include "util/stats.h"
+
+#include <algorithm>
+#include <concepts>
+#include <limits>
+#include <memory_resource>
 #include <optional>
 #include <vector>
 
@@ -9,62 +18,37 @@ using namespace fst;
 
 namespace
 {
-	template <bool assume_valid, bool return_state>
-	auto stabiliser_from_statevector_internal(const std::span<const std::complex<float>> statevector)
+	/// Given the support of a state, as the list of vectors (index ^ shift) for each index in the support
+	/// (in increasing order of index, where shift is the smallest index) together with the amplitudes at those
+	/// indices, either returns the corresponding stabiliser state or tests whether it is a stabiliser state.
+	/// Temporaries are allocated from scratch, and the state with allocator. The amplitudes are compared in their own
+	/// precision, up to amplitude_tolerance relative to the first amplitude, which every amplitude matches in size.
+	template <bool assume_valid, bool return_state, std::floating_point Real>
+	auto stabiliser_from_support_internal(const std::size_t number_qubits, const std::size_t shift,
+		const std::span<const std::size_t> vector_space_indices, const std::span<const std::complex<Real>> support_amplitudes,
+		std::pmr::memory_resource *scratch, const Stabiliser_State::allocator_type &allocator)
 		-> std::conditional_t<return_state, std::optional<fst::Stabiliser_State>, bool>
 	{
-		const std::size_t state_vector_size = statevector.size();
-
-		if (!is_power_of_2(state_vector_size))
-		{
-			return {};
-		}
-
-		const std::size_t number_qubits = integral_log_2(state_vector_size);
-		std::size_t shift = 0;
-
-		while (shift < state_vector_size && statevector[shift] == .0f)
-		{
-			++shift;
-		}
-
-		if (shift == state_vector_size)
-		{
-			return {};
-		}
-
-		std::vector<std::size_t> vector_space_indices;
-		vector_space_indices.reserve(state_vector_size + 1);
-		vector_space_indices.push_back(0);
-
-		// TODO: create seperate array of the statevector entries here as well, so we don't have to keep XORing with shift later on
-
-		for (std::size_t index = shift + 1; index < state_vector_size; index++)
-		{
-			if (statevector[index] != .0f)
-			{
-				vector_space_indices.push_back(shift ^ index);
-			}
-		}
-
 		const std::size_t support_size = vector_space_indices.size();
 
 		if (!is_power_of_2(support_size))
 		{
+			FST_COUNT(rejected_support, 1);
 			return {};
 		}
 
 		const std::size_t dimension = integral_log_2(support_size);
-		const float normalisation_factor = (float) std::sqrt(support_size);
-		const std::complex<float> first_entry = statevector[shift];
-		const std::complex<float> global_phase = normalisation_factor * first_entry;
+		const Real normalisation_factor = Real(std::sqrt(support_size));
+		const std::complex<Real> first_entry = support_amplitudes[0];
+		const std::complex<Real> global_phase = normalisation_factor * first_entry;
 
 		if (std::abs(std::norm(global_phase) - 1) >= 0.125)
 		{
+			FST_COUNT(rejected_normalisation, 1);
 			return {};
 		}
 
-		std::vector<std::size_t> basis_vectors;
+		std::pmr::vector<std::size_t> basis_vectors(return_state ? allocator : scratch);
 		basis_vectors.reserve(dimension);
 
 		std::size_t real_linear_part = 0;
@@ -77,31 +61,30 @@ namespace
 			const std::size_t basis_vector = vector_space_indices[weight_one_string];
 			basis_vectors.push_back(basis_vector);
 
-			std::complex<float> phase = statevector[basis_vector ^ shift] / first_entry;
+			const std::optional<Phase_Exponent> phase_exponent = quarter_phase_exponent(support_amplitudes[weight_one_string] / first_entry);
 
-			if (std::norm(phase + 1.0f) < 0.125)
-			{
-				real_linear_part ^= weight_one_string;
-			}
-			else if (std::norm(phase - std::complex<float>{0, 1}) < 0.125)
-			{
-				imaginary_part ^= weight_one_string;
-			}
-			else if (std::norm(phase - std::complex<float>{0, -1}) < 0.125)
-			{
-				real_linear_part ^= weight_one_string;
-				imaginary_part ^= weight_one_string;
-			}
-			else if (std::norm(phase - 1.0f) >= 0.125)
+			if (!phase_exponent)
 			{
+				FST_COUNT(rejected_phase, 1);
 				return {};
 			}
+
+			// The phase is (-1)^(real_linear_part_j) * i^(imaginary_part_j)
+			real_linear_part ^= weight_one_string * (*phase_exponent >= 4);
+			imaginary_part ^= weight_one_string * ((*phase_exponent >> 1) & 1);
 		}
 
-		std::unordered_map<std::size_t, bool> quadratic_form;
-		quadratic_form.reserve(dimension * (dimension + 1)/2 + 1);
+		// Only the state needs the quadratic form as a map
+		std::pmr::unordered_map<std::size_t, bool> quadratic_form(allocator);
+
+		if constexpr (return_state)
+		{
+			quadratic_form.reserve(dimension * (dimension + 1)/2 + 1);
+			quadratic_form[0] = 0;
+		}
 
-		quadratic_form[0] = 0;
+		// quadratic_rows[i] has j-th bit Q(e_i, e_j)
+		std::pmr::vector<std::size_t> quadratic_rows(dimension, 0, scratch);
 
 		for (std::size_t j = 0; j < dimension; j++)
 		{
@@ -109,36 +92,41 @@ namespace
 			{
 				const std::size_t vector_index = integral_pow_2(i) | integral_pow_2(j);
 
-				const float real_linear_eval = sign_f2_dot_product(vector_index, real_linear_part);
-				const std::complex<float> imag_linear_eval = imag_f2_dot_product(vector_index, imaginary_part);
-				const std::complex<float> linear_eval = real_linear_eval * imag_linear_eval;
+				const std::optional<Phase_Exponent> phase_exponent = quarter_phase_exponent(support_amplitudes[vector_index] / first_entry);
 
-				const std::size_t total_index = vector_space_indices[vector_index] ^ shift;
-
-				const std::complex<float> quadratic_form_eval = statevector[total_index] / (first_entry * linear_eval);
-
-				if (std::norm(quadratic_form_eval + 1.0f) < 0.125)
+				if (!phase_exponent)
 				{
-					quadratic_form[vector_index] = 1;
+					FST_COUNT(rejected_phase, 1);
+					return {};
 				}
-				else if(std::norm(quadratic_form_eval - 1.0f) < 0.125)
+
+				const Phase_Exponent linear_exponent = 4 * f2_dot_product(vector_index, real_linear_part) + 2 * f2_dot_product(vector_index, imaginary_part);
+				const Phase_Exponent quadratic_form_exponent = (*phase_exponent - linear_exponent) & 7;
+
+				if (quadratic_form_exponent != 0 && quadratic_form_exponent != 4)
 				{
-					quadratic_form[vector_index] = 0;
+					FST_COUNT(rejected_phase, 1);
+					return {};
 				}
-				else
+
+				const bool quadratic_form_entry = quadratic_form_exponent == 4;
+
+				if constexpr (return_state)
 				{
-					return {};
+					quadratic_form[vector_index] = quadratic_form_entry;
 				}
+
+				quadratic_rows[i] |= quadratic_form_entry * integral_pow_2(j);
+				quadratic_rows[j] |= quadratic_form_entry * integral_pow_2(i);
 			}
 		}
 
 		if constexpr (!assume_valid)
 		{
-			// TODO this duplicates alot of code from the get_state_vector() method of stabiliser_state. Fix
 			std::size_t vector_index = 0;
 			bool imag_exponent = 0;
-			std::size_t total_index = shift;
-			std::complex<float> phase = global_phase / float(std::sqrt(support_size));
+			std::size_t total_index = 0;
+			Phase_Exponent phase_exponent = 0;
 
 			for (std::size_t iterate = 1; iterate < support_size; iterate++)
 			{
@@ -147,42 +135,43 @@ namespace
 				std::size_t flipped_bit = integral_log_2(vector_index ^ new_vector_index);
 
 				total_index ^= basis_vectors[flipped_bit];
-				float real_linear_phase_update = f_min1_pow(bit_set_at(real_linear_part, flipped_bit));
+				const bool real_update_exponent = bit_set_at(real_linear_part, flipped_bit) ^ f2_dot_product(quadratic_rows[flipped_bit], vector_index);
 
 				bool new_imag_exponent = bit_set_at(imaginary_part, flipped_bit) ^ imag_exponent;
-				// multiply by i if going from 1 to i, multiply by -i if going from i to 1
-				std::complex<float> imaginary_phase_update {(float) 1-(imag_exponent^new_imag_exponent), (float) (imag_exponent^new_imag_exponent)*(1-2*imag_exponent)};
-
-				bool quadratic_update_exponent = 0;
+				// multiply by i if going from 1 to i, multiply by -i = w^6 if going from i to 1
+				phase_exponent += 4 * real_update_exponent + 2 * new_imag_exponent + 6 * imag_exponent;
 
-				for (std::size_t j = 0; j < dimension; j++)
+				// The support must be exactly the affine space spanned by the basis vectors
+				if (vector_space_indices[new_vector_index] != total_index)
 				{
-					quadratic_update_exponent ^= (quadratic_form.at(integral_pow_2(flipped_bit) ^ integral_pow_2(j)) & bit_set_at(vector_index, j));
+					FST_COUNT(gray_code_steps, iterate);
+					FST_COUNT(rejected_support, 1);
+					return {};
 				}
 
-				float quadratic_phase_update = f_min1_pow(quadratic_update_exponent);
-
-				phase *= real_linear_phase_update * imaginary_phase_update * quadratic_phase_update;
-
-				if (std::norm(phase - statevector[total_index]) >= 0.001)
+				if (!amplitudes_match(support_amplitudes[new_vector_index], multiply_by_phase(first_entry, phase_exponent)))
 				{
+					FST_COUNT(gray_code_steps, iterate);
+					FST_COUNT(rejected_amplitude, 1);
 					return {};
 				}
 
 				vector_index = new_vector_index;
 				imag_exponent = new_imag_exponent;
 			}
+
+			FST_COUNT(gray_code_steps, support_size - 1);
 		}
 
 		if constexpr (return_state)
 		{
-			Stabiliser_State state(number_qubits, dimension);
+			Stabiliser_State state(number_qubits, dimension, allocator);
 			state.shift = shift;
 			state.basis_vectors = std::move(basis_vectors);
 			state.real_linear_part = real_linear_part;
 			state.imaginary_part = imaginary_part;
 			state.quadratic_form = std::move(quadratic_form);
-			state.global_phase = global_phase;
+			state.global_phase = std::complex<float>(global_phase);
 			state.row_reduced = true;
 			return state;
 		}
@@ -191,28 +180,298 @@ namespace
 			return true;
 		}
 	}
-}
 
-fst::Stabiliser_State fst::stabiliser_from_statevector(const std::vector<std::complex<float>> &statevector, bool assume_valid)
-{
-	std::optional<Stabiliser_State> state = assume_valid
-												? stabiliser_from_statevector_internal<true, true>(statevector)
-												: stabiliser_from_statevector_internal<false, true>(statevector);
+	template <bool assume_valid, bool return_state, std::floating_point Real>
+	auto stabiliser_from_statevector_internal(const std::span<const std::complex<Real>> statevector, std::pmr::memory_resource *scratch,
+		const Stabiliser_State::allocator_type &allocator)
+		-> std::conditional_t<return_state, std::optional<fst::Stabiliser_State>, bool>
+	{
+		const std::size_t state_vector_size = statevector.size();
+
+		if (!is_power_of_2(state_vector_size))
+		{
+			FST_COUNT(rejected_support, 1);
+			return {};
+		}
+
+		const std::size_t number_qubits = integral_log_2(state_vector_size);
+		std::size_t shift = 0;
+
+		while (shift < state_vector_size && statevector[shift] == Real(0))
+		{
+			++shift;
+		}
+
+		if (shift == state_vector_size)
+		{
+			FST_COUNT(rejected_support, 1);
+			return {};
+		}
+
+		std::pmr::vector<std::size_t> vector_space_indices(scratch);
+		vector_space_indices.reserve(state_vector_size - shift);
+		std::pmr::vector<std::complex<Real>> support_amplitudes(scratch);
+		support_amplitudes.reserve(state_vector_size - shift);
+
+		for (std::size_t index = shift; index < state_vector_size; index++)
+		{
+			if (statevector[index] != Real(0))
+			{
+				vector_space_indices.push_back(shift ^ index);
+				support_amplitudes.push_back(statevector[index]);
+			}
+		}
+
+		return stabiliser_from_support_internal<assume_valid, return_state, Real>(number_qubits, shift, vector_space_indices, support_amplitudes, scratch, allocator);
+	}
+
+	template <bool assume_valid, bool return_state, std::floating_point Real>
+	auto stabiliser_from_sparse_statevector_internal(const std::size_t number_qubits, const std::span<const std::size_t> indices,
+		const std::span<const std::complex<Real>> amplitudes, std::pmr::memory_resource *scratch, const Stabiliser_State::allocator_type &allocator)
+		-> std::conditional_t<return_state, std::optional<fst::Stabiliser_State>, bool>
+	{
+		if (indices.size() != amplitudes.size() || number_qubits > std::numeric_limits<std::size_t>::digits)
+		{
+			FST_COUNT(rejected_support, 1);
+			return {};
+		}
+
+		std::pmr::vector<std::size_t> support_order(scratch);
+		support_order.reserve(indices.size());
+
+		for (std::size_t entry = 0; entry < indices.size(); entry++)
+		{
+			if (number_qubits < std::numeric_limits<std::size_t>::digits && indices[entry] >> number_qubits)
+			{
+				FST_COUNT(rejected_support, 1);
+				return {};
+			}
+
+			if (amplitudes[entry] != Real(0))
+			{
+				support_order.push_back(entry);
+			}
+		}
 
-	if (!state)
+		if (support_order.empty())
+		{
+			FST_COUNT(rejected_support, 1);
+			return {};
+		}
+
+		const auto by_index = [&indices](const std::size_t first, const std::size_t second) { return indices[first] < indices[second]; };
+
+		if (!std::is_sorted(support_order.begin(), support_order.end(), by_index))
+		{
+			std::sort(support_order.begin(), support_order.end(), by_index);
+		}
+
+		const std::size_t shift = indices[support_order[0]];
+
+		std::pmr::vector<std::size_t> vector_space_indices(scratch);
+		vector_space_indices.reserve(support_order.size());
+		std::pmr::vector<std::complex<Real>> support_amplitudes(scratch);
+		support_amplitudes.reserve(support_order.size());
+
+		for (const std::size_t entry : support_order)
+		{
+			// Repeated indices can never describe a valid state
+			if (!vector_space_indices.empty() && (indices[entry] ^ shift) == vector_space_indices.back())
+			{
+				FST_COUNT(rejected_support, 1);
+				return {};
+			}
+
+			vector_space_indices.push_back(indices[entry] ^ shift);
+			support_amplitudes.push_back(amplitudes[entry]);
+		}
+
+		return stabiliser_from_support_internal<assume_valid, return_state, Real>(number_qubits, shift, vector_space_indices, support_amplitudes, scratch, allocator);
+	}
+
+	template <std::floating_point Real>
+	Stabiliser_State convert_statevector(const std::span<const std::complex<Real>> statevector, const bool assume_valid,
+		std::pmr::memory_resource *scratch, const Stabiliser_State::allocator_type &allocator)
 	{
-		throw std::invalid_argument("State was not a stabiliser state");
+		if (is_power_of_2(statevector.size()) && statevector.size() <= integral_pow_2(max_fixed_qubits))
+		{
+			return dispatch_fixed_qubits(std::size_t(integral_log_2(statevector.size())), [statevector, assume_valid, &allocator]<std::size_t N>()
+			{
+				const std::span<const std::complex<Real>, integral_pow_2(N)> fixed_statevector(statevector);
+				return stabiliser_from_statevector<N>(fixed_statevector, assume_valid).to_stabiliser_state(allocator);
+			});
+		}
+
+		std::optional<Stabiliser_State> state = assume_valid
+													? stabiliser_from_statevector_internal<true, true, Real>(statevector, scratch, allocator)
+													: stabiliser_from_statevector_internal<false, true, Real>(statevector, scratch, allocator);
+
+		if (!state)
+		{
+			throw std::invalid_argument("State was not a stabiliser state");
+		}
+
+		return *std::move(state);
 	}
 
-	return *std::move(state);
+	template <std::floating_point Real>
+	bool test_statevector(const std::span<const std::complex<Real>> statevector, std::pmr::memory_resource *scratch)
+	{
+		if (is_power_of_2(statevector.size()) && statevector.size() <= integral_pow_2(max_fixed_qubits))
+		{
+			return dispatch_fixed_qubits(std::size_t(integral_log_2(statevector.size())), [statevector]<std::size_t N>()
+			{
+				const std::span<const std::complex<Real>, integral_pow_2(N)> fixed_statevector(statevector);
+				return is_stabiliser_state<N>(fixed_statevector);
+			});
+		}
+
+		return stabiliser_from_statevector_internal<false, false, Real>(statevector, scratch, scratch);
+	}
+
+	template <std::floating_point Real>
+	Stabiliser_State convert_sparse_statevector(const std::size_t number_qubits, const std::span<const std::size_t> indices,
+		const std::span<const std::complex<Real>> amplitudes, const bool assume_valid, std::pmr::memory_resource *scratch,
+		const Stabiliser_State::allocator_type &allocator)
+	{
+		std::optional<Stabiliser_State> state = assume_valid
+													? stabiliser_from_sparse_statevector_internal<true, true, Real>(number_qubits, indices, amplitudes, scratch, allocator)
+													: stabiliser_from_sparse_statevector_internal<false, true, Real>(number_qubits, indices, amplitudes, scratch, allocator);
+
+		if (!state)
+		{
+			throw std::invalid_argument("State was not a stabiliser state");
+		}
+
+		return *std::move(state);
+	}
+}
+
+fst::Stabiliser_State fst::stabiliser_from_statevector(const std::span<const std::complex<float>> statevector, bool assume_valid)
+{
+	FST_TIME_SCOPE(state_from_statevector);
+
+	const Scratch_Scope scope(thread_scratch_arena());
+	return convert_statevector<float>(statevector, assume_valid, &thread_scratch_arena(), {});
+}
+
+fst::Stabiliser_State fst::stabiliser_from_statevector(const std::span<const std::complex<float>> statevector, Scratch_Arena &arena, bool assume_valid)
+{
+	FST_TIME_SCOPE(state_from_statevector);
+
+	return convert_statevector<float>(statevector, assume_valid, &arena, &arena);
 }
 
-bool fst::is_stabiliser_state(const std::vector<std::complex<float>> &statevector)
+bool fst::is_stabiliser_state(const std::span<const std::complex<float>> statevector)
 {
-	return stabiliser_from_statevector_internal<false, false>(statevector);
+	FST_TIME_SCOPE(state_from_statevector);
+
+	const Scratch_Scope scope(thread_scratch_arena());
+	return test_statevector<float>(statevector, &thread_scratch_arena());
+}
+
+bool fst::is_stabiliser_state(const std::span<const std::complex<float>> statevector, Scratch_Arena &arena)
+{
+	FST_TIME_SCOPE(state_from_statevector);
+
+	const Scratch_Scope scope(arena);
+	return test_statevector<float>(statevector, &arena);
 }
 
 fst::Stabiliser_State fst::stab_in_the_dark(const std::vector<std::complex<float>> &statevector)
 {
 	return stabiliser_from_statevector(statevector, true);
 }
+
+fst::Stabiliser_State fst::stabiliser_from_statevector(const std::size_t number_qubits, const std::span<const std::size_t> indices, const std::span<const std::complex<float>> amplitudes, bool assume_valid)
+{
+	FST_TIME_SCOPE(state_from_statevector);
+
+	const Scratch_Scope scope(thread_scratch_arena());
+	return convert_sparse_statevector<float>(number_qubits, indices, amplitudes, assume_valid, &thread_scratch_arena(), {});
+}
+
+fst::Stabiliser_State fst::stabiliser_from_statevector(const std::size_t number_qubits, const std::span<const std::size_t> indices, const std::span<const std::complex<float>> amplitudes, Scratch_Arena &arena, bool assume_valid)
+{
+	FST_TIME_SCOPE(state_from_statevector);
+
+	return convert_sparse_statevector<float>(number_qubits, indices, amplitudes, assume_valid, &arena, &arena);
+}
+
+bool fst::is_stabiliser_state(const std::size_t number_qubits, const std::span<const std::size_t> indices, const std::span<const std::complex<float>> amplitudes)
+{
+	FST_TIME_SCOPE(state_from_statevector);
+
+	const Scratch_Scope scope(thread_scratch_arena());
+	return stabiliser_from_sparse_statevector_internal<false, false, float>(number_qubits, indices, amplitudes, &thread_scratch_arena(), &thread_scratch_arena());
+}
+
+bool fst::is_stabiliser_state(const std::size_t number_qubits, const std::span<const std::size_t> indices, const std::span<const std::complex<float>> amplitudes, Scratch_Arena &arena)
+{
+	FST_TIME_SCOPE(state_from_statevector);
+
+	const Scratch_Scope scope(arena);
+	return stabiliser_from_sparse_statevector_internal<false, false, float>(number_qubits, indices, amplitudes, &arena, &arena);
+}
+
+fst::Stabiliser_State fst::stabiliser_from_statevector(const std::span<const std::complex<double>> statevector, bool assume_valid)
+{
+	FST_TIME_SCOPE(state_from_statevector);
+
+	const Scratch_Scope scope(thread_scratch_arena());
+	return convert_statevector<double>(statevector, assume_valid, &thread_scratch_arena(), {});
+}
+
+fst::Stabiliser_State fst::stabiliser_from_statevector(const std::span<const std::complex<double>> statevector, Scratch_Arena &arena, bool assume_valid)
+{
+	FST_TIME_SCOPE(state_from_statevector);
+
+	return convert_statevector<double>(statevector, assume_valid, &arena, &arena);
+}
+
+bool fst::is_stabiliser_state(const std::span<const std::complex<double>> statevector)
+{
+	FST_TIME_SCOPE(state_from_statevector);
+
+	const Scratch_Scope scope(thread_scratch_arena());
+	return test_statevector<double>(statevector, &thread_scratch_arena());
+}
+
+bool fst::is_stabiliser_state(const std::span<const std::complex<double>> statevector, Scratch_Arena &arena)
+{
+	FST_TIME_SCOPE(state_from_statevector);
+
+	const Scratch_Scope scope(arena);
+	return test_statevector<double>(statevector, &arena);
+}
+
+fst::Stabiliser_State fst::stabiliser_from_statevector(const std::size_t number_qubits, const std::span<const std::size_t> indices, const std::span<const std::complex<double>> amplitudes, bool assume_valid)
+{
+	FST_TIME_SCOPE(state_from_statevector);
+
+	const Scratch_Scope scope(thread_scratch_arena());
+	return convert_sparse_statevector<double>(number_qubits, indices, amplitudes, assume_valid, &thread_scratch_arena(), {});
+}
+
+fst::Stabiliser_State fst::stabiliser_from_statevector(const std::size_t number_qubits, const std::span<const std::size_t> indices, const std::span<const std::complex<double>> amplitudes, Scratch_Arena &arena, bool assume_valid)
+{
+	FST_TIME_SCOPE(state_from_statevector);
+
+	return convert_sparse_statevector<double>(number_qubits, indices, amplitudes, assume_valid, &arena, &arena);
+}
+
+bool fst::is_stabiliser_state(const std::size_t number_qubits, const std::span<const std::size_t> indices, const std::span<const std::complex<double>> amplitudes)
+{
+	FST_TIME_SCOPE(state_from_statevector);
+
+	const Scratch_Scope scope(thread_scratch_arena());
+	return stabiliser_from_sparse_statevector_internal<false, false, double>(number_qubits, indices, amplitudes, &thread_scratch_arena(), &thread_scratch_arena());
+}
+
+bool fst::is_stabiliser_state(const std::size_t number_qubits, const std::span<const std::size_t> indices, const std::span<const std::complex<double>> amplitudes, Scratch_Arena &arena)
+{
+	FST_TIME_SCOPE(state_from_statevector);
+
+	const Scratch_Scope scope(arena);
+	return stabiliser_from_sparse_statevector_internal<false, false, double>(number_qubits, indices, amplitudes, &arena, &arena);
+}
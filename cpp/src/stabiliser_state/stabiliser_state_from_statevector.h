@@ -2,8 +2,11 @@
 #define _FAST_STABILISER_STABILISER_STATE_FROM_VECTOR_H
 
 #include <complex>
+#include <span>
+#include <vector>
 
 #include "stabiliser_state.h"
+#include "util/scratch_arena.h"
 
 namespace fst
 {
@@ -11,13 +14,48 @@ namespace fst
 	///
 	/// Assuming valid is faster, but will result in undefined behaviour if the state vector is not in fact a
 	/// valid stabaliser state
-	Stabiliser_State stabiliser_from_statevector(const std::vector<std::complex<float>> &statevector, bool assume_valid = false);
+	Stabiliser_State stabiliser_from_statevector(const std::span<const std::complex<float>> statevector, bool assume_valid = false);
 
 	/// ;)
 	Stabiliser_State stab_in_the_dark(const std::vector<std::complex<float>> &statevector);
 
 	/// Test wheter a state vector of complex amplitudes corresponds to a stabiliser state.
-	bool is_stabiliser_state(const std::vector<std::complex<float>> &statevector);
+	bool is_stabiliser_state(const std::span<const std::complex<float>> statevector);
+
+	/// Convert a sparse state vector on number_qubits qubits into a stabiliser state object. The state is given
+	/// as a list of basis indices and the (complex) amplitudes at those indices, in any order; all other amplitudes
+	/// are zero. Runs in time O(|support| n), so never allocates the full 2^n state vector.
+	///
+	/// Assuming valid is faster, but will result in undefined behaviour if the state vector is not in fact a
+	/// valid stabaliser state
+	Stabiliser_State stabiliser_from_statevector(const std::size_t number_qubits, const std::span<const std::size_t> indices, const std::span<const std::complex<float>> amplitudes, bool assume_valid = false);
+
+	/// Test wheter a sparse state vector, given as a list of basis indices and amplitudes, corresponds to a stabiliser state.
+	bool is_stabiliser_state(const std::size_t number_qubits, const std::span<const std::size_t> indices, const std::span<const std::complex<float>> amplitudes);
+
+	/// The conversions above keep their temporaries in the thread's scratch arena. These overloads instead allocate
+	/// the temporaries and the returned state in the given arena, so that once the arena has grown, converting in a
+	/// loop (resetting the arena each time) allocates nothing. The state is only valid until the arena is reset.
+	Stabiliser_State stabiliser_from_statevector(const std::span<const std::complex<float>> statevector, Scratch_Arena &arena, bool assume_valid = false);
+	Stabiliser_State stabiliser_from_statevector(const std::size_t number_qubits, const std::span<const std::size_t> indices, const std::span<const std::complex<float>> amplitudes, Scratch_Arena &arena, bool assume_valid = false);
+
+	/// The tests rewind the arena when done, so leave it as they found it
+	bool is_stabiliser_state(const std::span<const std::complex<float>> statevector, Scratch_Arena &arena);
+	bool is_stabiliser_state(const std::size_t number_qubits, const std::span<const std::size_t> indices, const std::span<const std::complex<float>> amplitudes, Scratch_Arena &arena);
+
+	/// The same conversions and tests for double precision amplitudes, e.g. from a simulator working in complex128,
+	/// which are then read as they are rather than copied to single precision. The amplitudes are compared in double
+	/// precision, with the tighter amplitude_tolerance<double> (see util/phase.h), though the global phase of the
+	/// state is still stored in single precision.
+	Stabiliser_State stabiliser_from_statevector(const std::span<const std::complex<double>> statevector, bool assume_valid = false);
+	bool is_stabiliser_state(const std::span<const std::complex<double>> statevector);
+	Stabiliser_State stabiliser_from_statevector(const std::size_t number_qubits, const std::span<const std::size_t> indices, const std::span<const std::complex<double>> amplitudes, bool assume_valid = false);
+	bool is_stabiliser_state(const std::size_t number_qubits, const std::span<const std::size_t> indices, const std::span<const std::complex<double>> amplitudes);
+
+	Stabiliser_State stabiliser_from_statevector(const std::span<const std::complex<double>> statevector, Scratch_Arena &arena, bool assume_valid = false);
+	Stabiliser_State stabiliser_from_statevector(const std::size_t number_qubits, const std::span<const std::size_t> indices, const std::span<const std::complex<double>> amplitudes, Scratch_Arena &arena, bool assume_valid = false);
+	bool is_stabiliser_state(const std::span<const std::complex<double>> statevector, Scratch_Arena &arena);
+	bool is_stabiliser_state(const std::size_t number_qubits, const std::span<const std::size_t> indices, const std::span<const std::complex<double>> amplitudes, Scratch_Arena &arena);
 }
 
 #endif
\ No newline at end of file
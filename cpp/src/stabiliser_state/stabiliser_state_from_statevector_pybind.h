@@ -3,21 +3,67 @@
 
 #include <pybind11/pybind11.h>
 #include <pybind11/complex.h>
+#include <pybind11/numpy.h>
 #include <pybind11/stl.h>
 
+#include <span>
+
 #include "stabiliser_state_from_statevector.h"
 
 namespace py = pybind11;
 using namespace fst;
 
-// Eliminate copying by making types opaque, accept np arrays?
 namespace fst_pybind
 {
+    /// Views the entries of a contiguous numpy array in place
+    template <typename T>
+    std::span<const T> array_span(const py::array_t<T, py::array::c_style> &array)
+    {
+        return {array.data(), static_cast<std::size_t>(array.size())};
+    }
+
+    /// Binds the overloads taking contiguous numpy arrays of the given complex type, which are read in place and in
+    /// their own precision. Only arrays of exactly that type match, so these come before the overloads taking lists.
+    template <typename Real>
+    void init_statevector_array_overloads(py::module_ &m)
+    {
+        using Array = py::array_t<std::complex<Real>, py::array::c_style>;
+
+        m.def("stabiliser_state_from_statevector", [](const Array &statevector, const bool assume_valid) { return stabiliser_from_statevector(array_span(statevector), assume_valid); },
+            py::arg("statevector").noconvert(), py::arg("assume_valid") = false);
+        m.def("is_stabiliser_state", [](const Array &statevector) { return is_stabiliser_state(array_span(statevector)); }, py::arg("statevector").noconvert());
+        m.def("stabiliser_state_from_sparse_statevector", [](const std::size_t number_qubits, const std::vector<std::size_t> &indices, const Array &amplitudes, const bool assume_valid)
+            {
+                return stabiliser_from_statevector(number_qubits, indices, array_span(amplitudes), assume_valid);
+            },
+            py::arg("number_qubits"), py::arg("indices"), py::arg("amplitudes").noconvert(), py::arg("assume_valid") = false);
+        m.def("is_sparse_stabiliser_state", [](const std::size_t number_qubits, const std::vector<std::size_t> &indices, const Array &amplitudes)
+            {
+                return is_stabiliser_state(number_qubits, indices, array_span(amplitudes));
+            },
+            py::arg("number_qubits"), py::arg("indices"), py::arg("amplitudes").noconvert());
+    }
+
     void init_stabiliser_state_from_statevector(py::module_ &m)
     {
-        m.def("stabiliser_state_from_statevector", &stabiliser_from_statevector, py::arg("statevector"), py::arg("assume_valid") = false, "Converts a state vector of complex amplitudes into a stabiliser state object. Assuming valid is faster, but will result in undefined behaviour if the state vector is not in fact a valid stabiliser state");
-        m.def("is_stabiliser_state", &is_stabiliser_state, py::arg("statevector"), "Tests whether a state vector of complex amplitudes corresponds to a stabiliser state");
+        init_statevector_array_overloads<double>(m);
+        init_statevector_array_overloads<float>(m);
+
+        m.def("stabiliser_state_from_statevector", [](const std::vector<std::complex<float>> &statevector, const bool assume_valid) { return stabiliser_from_statevector(statevector, assume_valid); },
+            py::arg("statevector"), py::arg("assume_valid") = false, "Converts a state vector of complex amplitudes into a stabiliser state object. A contiguous numpy array of dtype complex128 or complex64 is read in place and compared in its own precision, and anything else is converted to complex64. Assuming valid is faster, but will result in undefined behaviour if the state vector is not in fact a valid stabiliser state");
+        m.def("is_stabiliser_state", [](const std::vector<std::complex<float>> &statevector) { return is_stabiliser_state(statevector); },
+            py::arg("statevector"), "Tests whether a state vector of complex amplitudes corresponds to a stabiliser state. A contiguous numpy array of dtype complex128 or complex64 is read in place and compared in its own precision");
         m.def("stab_in_the_dark", &stab_in_the_dark, py::arg("statevector"), ";)");
+        m.def("stabiliser_state_from_sparse_statevector", [](const std::size_t number_qubits, const std::vector<std::size_t> &indices, const std::vector<std::complex<float>> &amplitudes, const bool assume_valid)
+            {
+                return stabiliser_from_statevector(number_qubits, indices, amplitudes, assume_valid);
+            },
+            py::arg("number_qubits"), py::arg("indices"), py::arg("amplitudes"), py::arg("assume_valid") = false, "Converts a sparse state vector on number_qubits qubits, given as a list of basis indices and the amplitudes at those indices (all other amplitudes being zero), into a stabiliser state object, without allocating the full 2^n state vector. The amplitudes may be a contiguous numpy array of dtype complex128 or complex64, which is read in place. Assuming valid is faster, but will result in undefined behaviour if the state vector is not in fact a valid stabiliser state");
+        m.def("is_sparse_stabiliser_state", [](const std::size_t number_qubits, const std::vector<std::size_t> &indices, const std::vector<std::complex<float>> &amplitudes)
+            {
+                return is_stabiliser_state(number_qubits, indices, amplitudes);
+            },
+            py::arg("number_qubits"), py::arg("indices"), py::arg("amplitudes"), "Tests whether a sparse state vector, given as a list of basis indices and amplitudes, corresponds to a stabiliser state");
     }
 }
 
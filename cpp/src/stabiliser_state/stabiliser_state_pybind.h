@@ -3,9 +3,15 @@
 
 #include <pybind11/pybind11.h>
 #include <pybind11/complex.h>
+#include <pybind11/numpy.h>
 #include <pybind11/stl.h>
 
+#include <algorithm>
+#include <cstdint>
+
 #include "stabiliser_state.h"
+#include "serialisation/pickle_pybind.h"
+#include "util/random.h"
 
 namespace py = pybind11;
 using namespace fst;
@@ -14,8 +20,49 @@ using namespace pybind11::literals;
 // TODO: Try and export the operator ==
 namespace fst_pybind
 {
+    /// Python iterator over the support of a stabiliser state, yielding (indices, amplitudes) NumPy arrays
+    struct Support_Chunks
+    {
+        Support_Iterator iterator;
+        std::size_t support_size;
+        std::size_t chunk_size;
+    };
+
+    /// Reads up to count (index, amplitude) pairs from the iterator into a pair of NumPy arrays
+    py::tuple read_support_chunk(Support_Iterator &iterator, const std::size_t support_size, const std::size_t count)
+    {
+        const std::size_t chunk_size = std::min(count, support_size - std::min(iterator.position(), support_size));
+
+        py::array_t<std::uint64_t> indices(chunk_size);
+        py::array_t<std::complex<float>> amplitudes(chunk_size);
+        auto indices_view = indices.mutable_unchecked<1>();
+        auto amplitudes_view = amplitudes.mutable_unchecked<1>();
+
+        for (std::size_t i = 0; i < chunk_size; i++, ++iterator)
+        {
+            const auto [index, amplitude] = *iterator;
+            indices_view(i) = index;
+            amplitudes_view(i) = amplitude;
+        }
+
+        return py::make_tuple(indices, amplitudes);
+    }
+
     void init_stabiliser_state(py::module_ &m)
     {
+        py::class_<Support_Chunks>(m, "Support_Chunks")
+            .def("__iter__", [](Support_Chunks &chunks) -> Support_Chunks & { return chunks; })
+            .def("__next__", [](Support_Chunks &chunks)
+            {
+                if (chunks.iterator == std::default_sentinel)
+                {
+                    throw py::stop_iteration();
+                }
+
+                return read_support_chunk(chunks.iterator, chunks.support_size, chunks.chunk_size);
+            })
+            .doc() = "Iterator over the support of a stabiliser state, yielding (indices, amplitudes) tuples of NumPy arrays of type (uint64, complex64)";
+
         py::class_<Stabiliser_State>(m, "Stabiliser_State")
             .def_readwrite("number_qubits", &Stabiliser_State::number_qubits, "int\t\tThe number of qubits")
             .def_readwrite("basis_vectors", &Stabiliser_State::basis_vectors, "list[int]\tBasis vectors for the vector space")
@@ -28,8 +75,24 @@ namespace fst_pybind
             .def_readwrite("row_reduced", &Stabiliser_State::row_reduced, "bool\t\tWhether the matrix of basis vectors is row reduced")
             .def(py::init<const std::size_t>(), "number_qubits"_a) // TODO: Do we want this?
             .def(py::init<Check_Matrix &>(), "check_matrix"_a)
-            .def("get_state_vector", &Stabiliser_State::get_state_vector, "Returns the state vector of length 2^n of the stabiliser state (with respect to the computational basis), as type list[complex]")
+            .def("get_state_vector", [](const Stabiliser_State &state, const bool double_precision) -> py::object
+                {
+                    return double_precision ? py::cast(state.get_state_vector<double>()) : py::cast(state.get_state_vector<float>());
+                },
+                py::arg("double_precision") = false, "Returns the state vector of length 2^n of the stabiliser state (with respect to the computational basis), as type list[complex]. The amplitudes are formed in single precision, or in double precision if double_precision is set")
+            .def("get_sparse_state_vector", &Stabiliser_State::get_sparse_state_vector, "Returns only the non-zero amplitudes of the stabiliser state, as a tuple (indices, amplitudes) of type (list[int], list[complex]), each of length 2^dim. The entries are in Gray code order over the affine space, not sorted by index")
+            .def("iter_support", [](const Stabiliser_State &state) { return py::make_iterator(state.support().begin(), state.support().end()); }, py::keep_alive<0, 1>(), "Returns a lazy iterator over the (index, amplitude) pairs of the non-zero amplitudes, in Gray code order over the affine space. The state must not be modified while the iterator is in use")
+            .def("iter_support_chunks", [](const Stabiliser_State &state, const std::size_t chunk_size) { return Support_Chunks{Support_Iterator(state), state.support().size(), std::max<std::size_t>(chunk_size, 1)}; }, py::arg("chunk_size") = 1 << 16, py::keep_alive<0, 1>(), "Returns a lazy iterator over the non-zero amplitudes, in Gray code order over the affine space, yielding (indices, amplitudes) tuples of NumPy arrays with at most chunk_size entries each. The state must not be modified while the iterator is in use")
+            .def("get_support_chunk", [](const Stabiliser_State &state, const std::size_t start, const std::size_t count) { Support_Iterator iterator(state, start); return read_support_chunk(iterator, state.support().size(), count); }, py::arg("start"), py::arg("count"), "Returns the non-zero amplitudes at positions start, ..., start + count - 1 of the Gray code order over the affine space, as a tuple (indices, amplitudes) of NumPy arrays")
             .def("row_reduce_basis", &Stabiliser_State::row_reduce_basis, "Row reduces the basis to reduced row-echelon form. Note that the quadratic form and the real and imaginary linear parts are also updated, so the instance represents the same stabiliser state")
+            .def("canonicalise", &Stabiliser_State::canonicalise, "Puts the state in its canonical form: the basis is row reduced and sorted by pivot, and the shift is zero at the pivots. The forms and global phase are updated so the instance represents the same stabiliser state")
+            .def("is_canonical", &Stabiliser_State::is_canonical, "Returns whether the basis and shift are in canonical form")
+            .def("measure", py::overload_cast<const Pauli &, Random_Generator &>(&Stabiliser_State::measure), py::arg("observable"), py::arg("generator"), "Measures the Hermitian Pauli observable, returning the outcome m (for the eigenvalue (-1)^m) as a bool, and collapses the state onto the corresponding eigenspace in O(n^2) time. The global phase is left as is")
+            .def("measure", py::overload_cast<const std::size_t, Random_Generator &>(&Stabiliser_State::measure), py::arg("qubit"), py::arg("generator"), "Measures the given qubit in the computational basis, returning the outcome as a bool, and collapses the state")
+            .def("marginal_probability", &Stabiliser_State::marginal_probability, py::arg("qubit_mask"), py::arg("outcomes"), "Returns the probability that measuring the qubits set in qubit_mask in the computational basis gives the corresponding bits of outcomes, without collapsing the state. For the prefix b of length k of the measured bit string, use qubit_mask = 2^k - 1")
+            .def("__eq__", &Stabiliser_State::operator==, py::arg("other"), "Returns whether the states have the same state vector (up to a small error in the global phase)")
+            .def("__hash__", [](const Stabiliser_State &state) { return std::hash<Stabiliser_State>{}(state); })
+            .def(get_pickle<Stabiliser_State>(&deserialise_stabiliser_state))
             .doc() = "The class used to represent a stabiliser state. The state is stored using the ideas of Dehaene & De Moore, as an affine space, and a quadratic and linear form over that space. More precisely, it is stored as a list of basis vectors for a vector space, a constant vector that is added to every element of the vector space to reach, the affine space, and a quadratic and linear form defined on the vector space";
     }
 }
@@ -0,0 +1,194 @@
+#include "stabiliser_state_rank.h"
+#include "util/bit_kernels.h"
+#include "util/f2_helper.h"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <stdexcept>
+
+namespace fst
+{
+	namespace
+	{
+		void check_number_qubits(const std::size_t number_qubits)
+		{
+			if (number_qubits > max_stabiliser_state_rank_qubits)
+			{
+				throw std::invalid_argument("Stabiliser states can only be ranked on at most 9 qubits.");
+			}
+		}
+
+		/// The number of free bits of the states whose reduced basis has the given pivots
+		std::size_t number_free_bits(const std::size_t number_qubits, const std::size_t pivots)
+		{
+			const std::size_t dim = std::popcount(pivots);
+			std::size_t free_bits = number_qubits - dim + 2 * dim + dim * (dim - 1) / 2;
+
+			// The j-th basis vector (sorted by pivot) is free below its pivot, away from the other pivots
+			std::size_t j = 0;
+
+			for (std::size_t remaining = pivots; remaining; remaining &= remaining - 1, j++)
+			{
+				free_bits += std::countr_zero(remaining) - j;
+			}
+
+			return free_bits;
+		}
+
+		/// The possible pivots of the reduced basis, ordered by number and then numerically, with the number of
+		/// states before each (and in total, as the last offset)
+		struct Pivot_Table
+		{
+			std::vector<std::size_t> pivots;
+			std::vector<std::uint64_t> offsets;
+			std::vector<std::size_t> index_of_pivots;
+		};
+
+		const Pivot_Table &pivot_table(const std::size_t number_qubits)
+		{
+			static const std::array<Pivot_Table, max_stabiliser_state_rank_qubits + 1> tables = []
+			{
+				std::array<Pivot_Table, max_stabiliser_state_rank_qubits + 1> tables;
+
+				for (std::size_t n = 0; n <= max_stabiliser_state_rank_qubits; n++)
+				{
+					Pivot_Table &table = tables[n];
+					table.index_of_pivots.resize(integral_pow_2(n));
+					table.offsets.push_back(0);
+
+					for (std::size_t dim = 0; dim <= n; dim++)
+					{
+						for (std::size_t pivots = 0; pivots < integral_pow_2(n); pivots++)
+						{
+							if (std::size_t(std::popcount(pivots)) == dim)
+							{
+								table.index_of_pivots[pivots] = table.pivots.size();
+								table.pivots.push_back(pivots);
+								table.offsets.push_back(table.offsets.back() + (std::uint64_t(1) << number_free_bits(n, pivots)));
+							}
+						}
+					}
+				}
+
+				return tables;
+			}();
+
+			return tables[number_qubits];
+		}
+	}
+
+	std::uint64_t number_stabiliser_states(const std::size_t number_qubits)
+	{
+		check_number_qubits(number_qubits);
+
+		return pivot_table(number_qubits).offsets.back();
+	}
+
+	std::uint64_t rank_stabiliser_state(const Stabiliser_State &state)
+	{
+		check_number_qubits(state.number_qubits);
+
+		Stabiliser_State canonical_state = state;
+		canonical_state.canonicalise();
+
+		std::size_t pivots = 0;
+
+		for (const std::size_t basis_vector : canonical_state.basis_vectors)
+		{
+			pivots |= std::bit_floor(basis_vector);
+		}
+
+		const std::size_t dim = canonical_state.dim;
+		const std::size_t non_pivots = (integral_pow_2(state.number_qubits) - 1) & ~pivots;
+
+		const Pivot_Table &table = pivot_table(state.number_qubits);
+		const std::uint64_t rank = table.offsets[table.index_of_pivots[pivots]];
+
+		std::uint64_t local_rank = 0;
+		const auto push_bits = [&local_rank](const std::uint64_t bits, const std::size_t number_bits)
+		{
+			local_rank = (local_rank << number_bits) | bits;
+		};
+
+		for (const std::size_t basis_vector : canonical_state.basis_vectors)
+		{
+			const std::size_t below_pivot = non_pivots & (std::bit_floor(basis_vector) - 1);
+			push_bits(extract_bits(basis_vector, below_pivot), std::popcount(below_pivot));
+		}
+
+		push_bits(extract_bits(canonical_state.shift, non_pivots), std::popcount(non_pivots));
+		push_bits(canonical_state.real_linear_part, dim);
+		push_bits(canonical_state.imaginary_part, dim);
+
+		for (std::size_t i = 0; i < dim; i++)
+		{
+			for (std::size_t j = i + 1; j < dim; j++)
+			{
+				push_bits(canonical_state.quadratic_form.at(integral_pow_2(i) | integral_pow_2(j)), 1);
+			}
+		}
+
+		return rank + local_rank;
+	}
+
+	Stabiliser_State unrank_stabiliser_state(const std::size_t number_qubits, std::uint64_t rank)
+	{
+		check_number_qubits(number_qubits);
+
+		const Pivot_Table &table = pivot_table(number_qubits);
+
+		if (rank >= table.offsets.back())
+		{
+			throw std::invalid_argument("The rank is at least the number of stabiliser states.");
+		}
+
+		const std::size_t index = std::upper_bound(table.offsets.begin(), table.offsets.end(), rank) - table.offsets.begin() - 1;
+		const std::size_t state_pivots = table.pivots[index];
+		rank -= table.offsets[index];
+
+		const std::size_t dim = std::popcount(state_pivots);
+		const std::size_t non_pivots = (integral_pow_2(number_qubits) - 1) & ~state_pivots;
+
+		Stabiliser_State state(number_qubits, dim);
+
+		const auto pop_bits = [&rank](const std::size_t number_bits)
+		{
+			const std::uint64_t bits = rank & ((std::uint64_t(1) << number_bits) - 1);
+			rank >>= number_bits;
+			return bits;
+		};
+
+		state.quadratic_form[0] = 0;
+
+		for (std::size_t i = dim; i-- > 0;)
+		{
+			for (std::size_t j = dim; j-- > i + 1;)
+			{
+				state.quadratic_form[integral_pow_2(i) | integral_pow_2(j)] = pop_bits(1);
+			}
+		}
+
+		state.imaginary_part = pop_bits(dim);
+		state.real_linear_part = pop_bits(dim);
+		state.shift = std::size_t(deposit_bits(pop_bits(std::popcount(non_pivots)), non_pivots));
+
+		state.basis_vectors.resize(dim);
+		std::size_t remaining = state_pivots;
+
+		for (std::size_t j = 0; j < dim; j++, remaining &= remaining - 1)
+		{
+			state.basis_vectors[j] = integral_pow_2(std::size_t(std::countr_zero(remaining)));
+		}
+
+		for (std::size_t j = dim; j-- > 0;)
+		{
+			const std::size_t below_pivot = non_pivots & (state.basis_vectors[j] - 1);
+			state.basis_vectors[j] |= std::size_t(deposit_bits(pop_bits(std::popcount(below_pivot)), below_pivot));
+		}
+
+		state.row_reduced = true;
+
+		return state;
+	}
+}
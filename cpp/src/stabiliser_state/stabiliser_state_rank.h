@@ -0,0 +1,29 @@
+#ifndef _FAST_STABILISER_STABILISER_STATE_RANK_H
+#define _FAST_STABILISER_STABILISER_STATE_RANK_H
+
+#include "stabiliser_state.h"
+
+#include <cstdint>
+
+namespace fst
+{
+	/// The largest number of qubits for which the stabiliser states (up to global phase) can be ranked into 64 bits
+	constexpr std::size_t max_stabiliser_state_rank_qubits = 9;
+
+	/// Returns the number of stabiliser states on the given number of qubits, up to global phase
+	std::uint64_t number_stabiliser_states(const std::size_t number_qubits);
+
+	/// Returns the rank of the stabiliser state (up to global phase), a unique integer in
+	/// [0, number_stabiliser_states(n)). The rank of the basis state |x> is x.
+	///
+	/// States are ordered by the dimension and then the pivots of the row reduced basis of their support, and then by
+	/// the bits of the reduced basis, the reduced shift and the linear and quadratic forms of the phases with respect
+	/// to the reduced basis. Throws std::invalid_argument for more than max_stabiliser_state_rank_qubits qubits.
+	std::uint64_t rank_stabiliser_state(const Stabiliser_State &state);
+
+	/// The inverse of rank_stabiliser_state, returning the stabiliser state with the given rank, with a row reduced
+	/// basis and amplitude at the shift a positive real number
+	Stabiliser_State unrank_stabiliser_state(const std::size_t number_qubits, std::uint64_t rank);
+}
+
+#endif
@@ -0,0 +1,55 @@
+#ifndef _FAST_STABILISER_STABILISER_STATE_RANK_PYBIND_H
+#define _FAST_STABILISER_STABILISER_STATE_RANK_PYBIND_H
+
+#include <pybind11/pybind11.h>
+#include <pybind11/numpy.h>
+#include <pybind11/stl.h>
+
+#include <span>
+
+#include "stabiliser_state_rank.h"
+
+namespace py = pybind11;
+using namespace fst;
+
+namespace fst_pybind
+{
+	void init_stabiliser_state_rank(py::module_ &m)
+	{
+		m.attr("max_stabiliser_state_rank_qubits") = max_stabiliser_state_rank_qubits;
+
+		m.def("number_stabiliser_states", &number_stabiliser_states, py::arg("number_qubits"), "Returns the number of stabiliser states on the given number of qubits, up to global phase");
+		m.def("rank_stabiliser_state", &rank_stabiliser_state, py::arg("stabiliser_state"), "Returns the rank of the stabiliser state (up to global phase), a unique integer in [0, number_stabiliser_states(n))");
+		m.def("unrank_stabiliser_state", &unrank_stabiliser_state, py::arg("number_qubits"), py::arg("rank"), "Returns the stabiliser state with the given rank");
+
+		m.def("rank_stabiliser_states", [](const std::vector<Stabiliser_State> &states)
+			{
+				py::array_t<std::uint64_t> ranks(static_cast<py::ssize_t>(states.size()));
+				std::uint64_t *data = ranks.mutable_data();
+
+				for (std::size_t i = 0; i < states.size(); i++)
+				{
+					data[i] = rank_stabiliser_state(states[i]);
+				}
+
+				return ranks;
+			},
+			py::arg("stabiliser_states"), "Returns the ranks of a list of stabiliser states as a numpy array of dtype uint64");
+
+		m.def("unrank_stabiliser_states", [](const std::size_t number_qubits, py::array_t<std::uint64_t, py::array::c_style | py::array::forcecast> ranks)
+			{
+				std::vector<Stabiliser_State> states;
+				states.reserve(ranks.size());
+
+				for (const std::uint64_t rank : std::span(ranks.data(), static_cast<std::size_t>(ranks.size())))
+				{
+					states.push_back(unrank_stabiliser_state(number_qubits, rank));
+				}
+
+				return states;
+			},
+			py::arg("number_qubits"), py::arg("ranks"), "Returns the list of stabiliser states with the given ranks");
+	}
+}
+
+#endif
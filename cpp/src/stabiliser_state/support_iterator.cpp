@@ -0,0 +1,120 @@
+#include "support_iterator.h"
+#include "stabiliser_state.h"
+#include "util/f2_helper.h"
+
+#include <cmath>
+#include <ranges>
+
+namespace fst
+{
+	static_assert(std::input_iterator<Support_Iterator>);
+	static_assert(std::ranges::input_range<Support_Range>);
+
+	Support_Iterator::Support_Iterator(const Stabiliser_State &state, const std::size_t position)
+		: state(&state), support_size(integral_pow_2(state.dim)), iterate(position)
+	{
+		quadratic_rows.resize(state.dim, 0);
+
+		for (std::size_t i = 0; i < state.dim; i++)
+		{
+			for (std::size_t j = i + 1; j < state.dim; j++)
+			{
+				if (state.quadratic_form.at(integral_pow_2(i) | integral_pow_2(j)))
+				{
+					quadratic_rows[i] |= integral_pow_2(j);
+					quadratic_rows[j] |= integral_pow_2(i);
+				}
+			}
+		}
+
+		if (iterate >= support_size)
+		{
+			iterate = support_size;
+			return;
+		}
+
+		vector_index = iterate ^ (iterate >> 1);
+		total_index = state.shift;
+		bool real_exponent = f2_dot_product(vector_index, state.real_linear_part);
+
+		for (std::size_t j = 0; j < state.dim; j++)
+		{
+			if (bit_set_at(vector_index, j))
+			{
+				total_index ^= state.basis_vectors[j];
+				// Only count each pair {i, j} once, when i < j
+				real_exponent ^= f2_dot_product(vector_index & (integral_pow_2(j) - 1), quadratic_rows[j]);
+			}
+		}
+
+		imag_exponent = f2_dot_product(vector_index, state.imaginary_part);
+		phase_exponent = 4 * real_exponent + 2 * imag_exponent;
+		normalised_global_phase = state.global_phase / float(std::sqrt(support_size));
+	}
+
+	Support_Iterator::value_type Support_Iterator::operator*() const
+	{
+		return {total_index, multiply_by_phase(normalised_global_phase, phase_exponent)};
+	}
+
+	Support_Iterator &Support_Iterator::operator++()
+	{
+		if (++iterate >= support_size)
+		{
+			iterate = support_size;
+			return *this;
+		}
+
+		// Iterate through the Gray code
+		const std::size_t new_vector_index = iterate ^ (iterate >> 1);
+		const std::size_t flipped_bit = integral_log_2(vector_index ^ new_vector_index);
+
+		total_index ^= state->basis_vectors[flipped_bit];
+		const bool real_update_exponent = bit_set_at(state->real_linear_part, flipped_bit) ^ f2_dot_product(quadratic_rows[flipped_bit], vector_index);
+
+		const bool new_imag_exponent = bit_set_at(state->imaginary_part, flipped_bit) ^ imag_exponent;
+
+		// multiply by i if going from 1 to i, multiply by -i = w^6 if going from i to 1
+		phase_exponent += 4 * real_update_exponent + 2 * new_imag_exponent + 6 * imag_exponent;
+
+		vector_index = new_vector_index;
+		imag_exponent = new_imag_exponent;
+
+		return *this;
+	}
+
+	void Support_Iterator::operator++(int)
+	{
+		++*this;
+	}
+
+	std::size_t Support_Iterator::position() const
+	{
+		return iterate;
+	}
+
+	Phase_Exponent Support_Iterator::amplitude_phase_exponent() const
+	{
+		return phase_exponent;
+	}
+
+	bool Support_Iterator::operator==(std::default_sentinel_t) const
+	{
+		return iterate == support_size;
+	}
+
+	Support_Iterator Support_Range::begin() const
+	{
+		return Support_Iterator(*state);
+	}
+
+	std::default_sentinel_t Support_Range::end() const
+	{
+		return std::default_sentinel;
+	}
+
+	std::size_t Support_Range::size() const
+	{
+		return integral_pow_2(state->dim);
+	}
+}
@@ -0,0 +1,79 @@
+#ifndef _FAST_STABILISER_SUPPORT_ITERATOR_H
+#define _FAST_STABILISER_SUPPORT_ITERATOR_H
+
+#include "util/phase.h"
+
+#include <complex>
+#include <cstddef>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+namespace fst
+{
+	struct Stabiliser_State;
+
+	/// An input iterator over the non-zero amplitudes of a stabiliser state, yielding (basis index, amplitude)
+	/// pairs. The 2^dim elements of the affine space are visited in Gray code order, so each step flips a single
+	/// basis vector and updates the phase in constant time. Only O(n) state is held, so the amplitudes can be
+	/// streamed without ever allocating the 2^n state vector.
+	///
+	/// The iterator refers to the stabiliser state it was created from, which must outlive it and not be modified.
+	class Support_Iterator
+	{
+		public:
+		using iterator_concept = std::input_iterator_tag;
+		using value_type = std::pair<std::size_t, std::complex<float>>;
+		using difference_type = std::ptrdiff_t;
+
+		Support_Iterator() = default;
+
+		/// Creates an iterator pointing at the element at the given position of the Gray code walk, computing its
+		/// amplitude directly in O(n) time. Positions run from 0 to 2^dim, the latter being the end of the walk.
+		Support_Iterator(const Stabiliser_State &state, const std::size_t position = 0);
+
+		value_type operator*() const;
+
+		Support_Iterator &operator++();
+		void operator++(int);
+
+		/// The position in the Gray code walk, i.e. the number of elements before this one
+		std::size_t position() const;
+
+		/// The amplitude is global_phase / sqrt(2^dim) * w^k for this exponent k (see util/phase.h), so that it can
+		/// be formed in another precision
+		Phase_Exponent amplitude_phase_exponent() const;
+
+		bool operator==(std::default_sentinel_t) const;
+
+		private:
+		const Stabiliser_State *state = nullptr;
+
+		/// quadratic_rows[i] has j-th bit Q(e_i, e_j), so the quadratic form can be updated with a popcount
+		std::vector<std::size_t> quadratic_rows;
+
+		std::size_t support_size = 0;
+		std::size_t iterate = 0;
+		std::size_t vector_index = 0;
+		std::size_t total_index = 0;
+		bool imag_exponent = 0;
+
+		/// The amplitude is normalised_global_phase * e^(i pi phase_exponent/4)
+		Phase_Exponent phase_exponent = 0;
+		std::complex<float> normalised_global_phase = 0;
+	};
+
+	/// The range of (basis index, amplitude) pairs in the support of a stabiliser state, see Support_Iterator
+	struct Support_Range
+	{
+		const Stabiliser_State *state;
+
+		Support_Iterator begin() const;
+		std::default_sentinel_t end() const;
+
+		/// The number of elements in the range, 2^dim
+		std::size_t size() const;
+	};
+}
+
+#endif
@@ -0,0 +1,202 @@
+#include "bit_kernels.h"
+#include "cpu_features.h"
+
+#include <array>
+#include <bit>
+
+#ifdef FST_X86
+#include <immintrin.h>
+#endif
+
+// PEXT and PDEP on 64-bit words are only available in 64-bit mode
+#if defined(FST_X86) && (defined(__x86_64__) || defined(_M_X64))
+#define FST_X86_64 1
+#endif
+
+namespace fst
+{
+	std::uint64_t extract_bits_scalar(const std::uint64_t value, std::uint64_t mask)
+	{
+		std::uint64_t result = 0;
+
+		for (std::size_t index = 0; mask; mask &= mask - 1, index++)
+		{
+			result |= ((value >> std::countr_zero(mask)) & 1) << index;
+		}
+
+		return result;
+	}
+
+	std::uint64_t deposit_bits_scalar(const std::uint64_t bits, std::uint64_t mask)
+	{
+		std::uint64_t result = 0;
+
+		for (std::size_t index = 0; mask; mask &= mask - 1, index++)
+		{
+			result |= ((bits >> index) & 1) << std::countr_zero(mask);
+		}
+
+		return result;
+	}
+
+	std::uint64_t and_popcount_scalar(const std::uint64_t *first, const std::uint64_t *second, const std::size_t size)
+	{
+		std::uint64_t count = 0;
+
+		for (std::size_t k = 0; k < size; k++)
+		{
+			count += std::popcount(first[k] & second[k]);
+		}
+
+		return count;
+	}
+
+#ifdef FST_X86
+	// The same loop as the scalar kernel, but std::popcount compiles to the POPCNT instruction
+	FST_TARGET_POPCNT std::uint64_t and_popcount_popcnt(const std::uint64_t *first, const std::uint64_t *second, const std::size_t size)
+	{
+		std::uint64_t count = 0;
+
+		for (std::size_t k = 0; k < size; k++)
+		{
+			count += std::popcount(first[k] & second[k]);
+		}
+
+		return count;
+	}
+
+#ifdef FST_X86_64
+	FST_TARGET_BMI2 std::uint64_t extract_bits_bmi2(const std::uint64_t value, const std::uint64_t mask)
+	{
+		return _pext_u64(value, mask);
+	}
+
+	FST_TARGET_BMI2 std::uint64_t deposit_bits_bmi2(const std::uint64_t bits, const std::uint64_t mask)
+	{
+		return _pdep_u64(bits, mask);
+	}
+#endif
+
+	/// Counts the bits of each byte by looking up each half in a table of the counts of 4-bit numbers, and sums
+	/// them into the four 64-bit lanes (Mula's method)
+	FST_TARGET_AVX2 static inline __m256i popcount_avx2(const __m256i block)
+	{
+		const __m256i nibble_counts = _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4, 0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+		const __m256i low_nibbles = _mm256_set1_epi8(0x0f);
+
+		const __m256i low_counts = _mm256_shuffle_epi8(nibble_counts, _mm256_and_si256(block, low_nibbles));
+		const __m256i high_counts = _mm256_shuffle_epi8(nibble_counts, _mm256_and_si256(_mm256_srli_epi16(block, 4), low_nibbles));
+
+		return _mm256_sad_epu8(_mm256_add_epi8(low_counts, high_counts), _mm256_setzero_si256());
+	}
+
+	FST_TARGET_AVX2 std::uint64_t and_popcount_avx2(const std::uint64_t *first, const std::uint64_t *second, const std::size_t size)
+	{
+		__m256i counts = _mm256_setzero_si256();
+		std::size_t k = 0;
+
+		for (; k + 4 <= size; k += 4)
+		{
+			const __m256i first_block = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(first + k));
+			const __m256i second_block = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(second + k));
+			counts = _mm256_add_epi64(counts, popcount_avx2(_mm256_and_si256(first_block, second_block)));
+		}
+
+		alignas(32) std::array<std::uint64_t, 4> lane_counts;
+		_mm256_store_si256(reinterpret_cast<__m256i *>(lane_counts.data()), counts);
+
+		return lane_counts[0] + lane_counts[1] + lane_counts[2] + lane_counts[3] + and_popcount_scalar(first + k, second + k, size - k);
+	}
+
+	FST_TARGET_AVX512_VPOPCNTDQ std::uint64_t and_popcount_avx512(const std::uint64_t *first, const std::uint64_t *second, const std::size_t size)
+	{
+		__m512i counts = _mm512_setzero_si512();
+		std::size_t k = 0;
+
+		for (; k + 8 <= size; k += 8)
+		{
+			const __m512i first_block = _mm512_loadu_si512(first + k);
+			const __m512i second_block = _mm512_loadu_si512(second + k);
+			counts = _mm512_add_epi64(counts, _mm512_popcnt_epi64(_mm512_and_si512(first_block, second_block)));
+		}
+
+		alignas(64) std::array<std::uint64_t, 8> lane_counts;
+		_mm512_store_si512(lane_counts.data(), counts);
+
+		std::uint64_t count = and_popcount_scalar(first + k, second + k, size - k);
+
+		for (const std::uint64_t lane_count : lane_counts)
+		{
+			count += lane_count;
+		}
+
+		return count;
+	}
+#endif
+
+	namespace
+	{
+		struct Bit_Kernels
+		{
+			decltype(&extract_bits_scalar) extract = extract_bits_scalar;
+			decltype(&deposit_bits_scalar) deposit = deposit_bits_scalar;
+			decltype(&and_popcount_scalar) popcount = and_popcount_scalar;
+		};
+
+		/// The kernels of each Kernel_Variant. Within a variant, instructions that the CPU does not report (BMI2 and
+		/// VPOPCNTDQ are missing on some CPUs with AVX2 and AVX-512 respectively) fall back to the previous variant.
+		const Bit_Kernels &bit_kernels()
+		{
+			static const std::array<Bit_Kernels, 4> table = []
+			{
+				std::array<Bit_Kernels, 4> table;
+
+#ifdef FST_X86
+				const Cpu_Features &features = cpu_features();
+
+				Bit_Kernels &sse42_kernels = table[static_cast<std::size_t>(Kernel_Variant::sse42)];
+				sse42_kernels.popcount = and_popcount_popcnt;
+
+				Bit_Kernels &avx2_kernels = table[static_cast<std::size_t>(Kernel_Variant::avx2)];
+				avx2_kernels = sse42_kernels;
+				avx2_kernels.popcount = and_popcount_avx2;
+
+#ifdef FST_X86_64
+				if (features.bmi2)
+				{
+					avx2_kernels.extract = extract_bits_bmi2;
+					avx2_kernels.deposit = deposit_bits_bmi2;
+				}
+#endif
+
+				Bit_Kernels &avx512_kernels = table[static_cast<std::size_t>(Kernel_Variant::avx512)];
+				avx512_kernels = avx2_kernels;
+
+				if (features.avx512vpopcntdq)
+				{
+					avx512_kernels.popcount = and_popcount_avx512;
+				}
+#endif
+
+				return table;
+			}();
+
+			return table[static_cast<std::size_t>(active_kernel_variant())];
+		}
+	}
+
+	std::uint64_t extract_bits(const std::uint64_t value, const std::uint64_t mask)
+	{
+		return bit_kernels().extract(value, mask);
+	}
+
+	std::uint64_t deposit_bits(const std::uint64_t bits, const std::uint64_t mask)
+	{
+		return bit_kernels().deposit(bits, mask);
+	}
+
+	std::uint64_t and_popcount(const std::uint64_t *first, const std::uint64_t *second, const std::size_t size)
+	{
+		return bit_kernels().popcount(first, second, size);
+	}
+}
@@ -0,0 +1,35 @@
+#ifndef _FAST_STABILISER_BIT_KERNELS_H
+#define _FAST_STABILISER_BIT_KERNELS_H
+
+#include <cstddef>
+#include <cstdint>
+
+namespace fst
+{
+	/// Packs the bits of value at the set bits of mask into the low bits of the result, as PEXT does.
+	/// Like the other kernels, this dispatches to the implementation for the active Kernel_Variant.
+	std::uint64_t extract_bits(const std::uint64_t value, const std::uint64_t mask);
+
+	/// The inverse of extract_bits, spreading the low bits of bits over the set bits of mask, as PDEP does
+	std::uint64_t deposit_bits(const std::uint64_t bits, const std::uint64_t mask);
+
+	/// Returns the total number of set bits of first[k] & second[k] for k < size. For two rows of a bit-packed
+	/// matrix over F_2, its parity is their inner product.
+	std::uint64_t and_popcount(const std::uint64_t *first, const std::uint64_t *second, const std::size_t size);
+
+	/// The individual kernels. Each must only be called on CPUs supporting the instructions it is named after.
+	std::uint64_t extract_bits_scalar(const std::uint64_t value, const std::uint64_t mask);
+	std::uint64_t deposit_bits_scalar(const std::uint64_t bits, const std::uint64_t mask);
+	std::uint64_t and_popcount_scalar(const std::uint64_t *first, const std::uint64_t *second, const std::size_t size);
+
+	std::uint64_t and_popcount_popcnt(const std::uint64_t *first, const std::uint64_t *second, const std::size_t size);
+
+	std::uint64_t extract_bits_bmi2(const std::uint64_t value, const std::uint64_t mask);
+	std::uint64_t deposit_bits_bmi2(const std::uint64_t bits, const std::uint64_t mask);
+
+	std::uint64_t and_popcount_avx2(const std::uint64_t *first, const std::uint64_t *second, const std::size_t size);
+
+	std::uint64_t and_popcount_avx512(const std::uint64_t *first, const std::uint64_t *second, const std::size_t size);
+}
+
+#endif
@@ -0,0 +1,77 @@
+#include "cpu_features.h"
+
+#include <array>
+#include <atomic>
+#include <stdexcept>
+#include <string>
+
+namespace fst
+{
+	namespace
+	{
+		constexpr std::array<Kernel_Variant, 4> variants_by_width {
+			Kernel_Variant::avx512, Kernel_Variant::avx2, Kernel_Variant::sse42, Kernel_Variant::scalar
+		};
+
+		std::atomic<Kernel_Variant> &kernel_variant()
+		{
+			static std::atomic<Kernel_Variant> variant = []
+			{
+				for (const Kernel_Variant widest_variant : variants_by_width)
+				{
+					if (is_kernel_variant_supported(widest_variant))
+					{
+						return widest_variant;
+					}
+				}
+
+				return Kernel_Variant::scalar;
+			}();
+
+			return variant;
+		}
+	}
+
+	std::string_view kernel_variant_name(const Kernel_Variant variant)
+	{
+		switch (variant)
+		{
+			case Kernel_Variant::scalar: return "scalar";
+			case Kernel_Variant::sse42: return "sse42";
+			case Kernel_Variant::avx2: return "avx2";
+			case Kernel_Variant::avx512: return "avx512";
+		}
+
+		throw std::invalid_argument("Unknown kernel variant.");
+	}
+
+	bool is_kernel_variant_supported(const Kernel_Variant variant)
+	{
+		const Cpu_Features &features = cpu_features();
+
+		switch (variant)
+		{
+			case Kernel_Variant::scalar: return true;
+			case Kernel_Variant::sse42: return features.popcnt;
+			case Kernel_Variant::avx2: return features.popcnt && features.avx2;
+			case Kernel_Variant::avx512: return features.popcnt && features.avx2 && features.avx512f;
+		}
+
+		return false;
+	}
+
+	Kernel_Variant active_kernel_variant()
+	{
+		return kernel_variant().load(std::memory_order_relaxed);
+	}
+
+	void set_kernel_variant(const Kernel_Variant variant)
+	{
+		if (!is_kernel_variant_supported(variant))
+		{
+			throw std::invalid_argument("The CPU does not support the " + std::string(kernel_variant_name(variant)) + " kernels.");
+		}
+
+		kernel_variant().store(variant, std::memory_order_relaxed);
+	}
+}
@@ -0,0 +1,122 @@
+#ifndef _FAST_STABILISER_CPU_FEATURES_H
+#define _FAST_STABILISER_CPU_FEATURES_H
+
+#include <string_view>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define FST_X86 1
+#endif
+
+#if defined(FST_X86) && defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#include <immintrin.h>
+#endif
+
+// GCC and Clang only allow the intrinsics of an instruction set in functions compiled for it, so kernels are
+// marked with the instruction set they use. MSVC allows the intrinsics everywhere.
+#if defined(FST_X86) && (defined(__GNUC__) || defined(__clang__))
+#define FST_TARGET_POPCNT __attribute__((target("popcnt")))
+#define FST_TARGET_BMI2 __attribute__((target("popcnt,bmi2")))
+#define FST_TARGET_AVX2 __attribute__((target("avx2")))
+#define FST_TARGET_AVX512 __attribute__((target("avx512f")))
+#define FST_TARGET_AVX512_VPOPCNTDQ __attribute__((target("avx512f,avx512vpopcntdq")))
+#else
+#define FST_TARGET_POPCNT
+#define FST_TARGET_BMI2
+#define FST_TARGET_AVX2
+#define FST_TARGET_AVX512
+#define FST_TARGET_AVX512_VPOPCNTDQ
+#endif
+
+namespace fst
+{
+	/// The instruction set extensions that the vectorised kernels can make use of. These are detected at runtime,
+	/// so a single binary can be compiled for a baseline architecture and still use the wider instructions where
+	/// they are available.
+	struct Cpu_Features
+	{
+		bool popcnt = false;
+		bool bmi2 = false;
+		bool avx2 = false;
+		bool avx512f = false;
+		bool avx512vpopcntdq = false;
+	};
+
+	/// Queries the current CPU, including whether the operating system saves the wider registers
+	inline Cpu_Features detect_cpu_features()
+	{
+		Cpu_Features features;
+
+#if defined(FST_X86) && defined(_MSC_VER) && !defined(__clang__)
+		int registers[4];
+		__cpuid(registers, 0);
+		const int max_leaf = registers[0];
+
+		if (max_leaf < 7)
+		{
+			return features;
+		}
+
+		__cpuid(registers, 1);
+		features.popcnt = (registers[2] >> 23) & 1;
+		const bool os_saves_registers = (registers[2] >> 27) & 1;
+
+		if (!os_saves_registers)
+		{
+			return features;
+		}
+
+		const unsigned long long saved_state = _xgetbv(0);
+		const bool os_saves_ymm = (saved_state & 0x6) == 0x6;
+		const bool os_saves_zmm = (saved_state & 0xe6) == 0xe6;
+
+		__cpuidex(registers, 7, 0);
+		features.bmi2 = (registers[1] >> 8) & 1;
+		features.avx2 = os_saves_ymm && ((registers[1] >> 5) & 1);
+		features.avx512f = os_saves_zmm && ((registers[1] >> 16) & 1);
+		features.avx512vpopcntdq = features.avx512f && ((registers[2] >> 14) & 1);
+#elif defined(FST_X86) && (defined(__GNUC__) || defined(__clang__))
+		__builtin_cpu_init();
+		features.popcnt = __builtin_cpu_supports("popcnt");
+		features.bmi2 = __builtin_cpu_supports("bmi2");
+		features.avx2 = __builtin_cpu_supports("avx2");
+		features.avx512f = __builtin_cpu_supports("avx512f");
+		features.avx512vpopcntdq = __builtin_cpu_supports("avx512vpopcntdq");
+#endif
+
+		return features;
+	}
+
+	/// The features of the current CPU, detected once on first use
+	inline const Cpu_Features &cpu_features()
+	{
+		static const Cpu_Features features = detect_cpu_features();
+		return features;
+	}
+
+	/// The sets of kernels that can be dispatched to, in increasing order of width. Each level only uses the
+	/// instructions it is named after (and those of the lower levels) where the CPU reports them: sse42 uses POPCNT,
+	/// avx2 also uses BMI2 (PEXT/PDEP) and 256-bit vectors, and avx512 also uses AVX-512F and VPOPCNTDQ.
+	enum class Kernel_Variant
+	{
+		scalar,
+		sse42,
+		avx2,
+		avx512
+	};
+
+	std::string_view kernel_variant_name(const Kernel_Variant variant);
+
+	/// Whether the current CPU can run the given variant
+	bool is_kernel_variant_supported(const Kernel_Variant variant);
+
+	/// The variant that the kernels currently dispatch to. This is the widest supported variant, chosen when the
+	/// library is loaded, unless overridden by set_kernel_variant.
+	Kernel_Variant active_kernel_variant();
+
+	/// Makes all kernels dispatch to the given variant, e.g. to compare or benchmark them on one machine. Throws
+	/// std::invalid_argument if the current CPU does not support the variant.
+	void set_kernel_variant(const Kernel_Variant variant);
+}
+
+#endif
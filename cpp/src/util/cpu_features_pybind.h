@@ -0,0 +1,71 @@
+#ifndef _FAST_STABILISER_CPU_FEATURES_PYBIND_H
+#define _FAST_STABILISER_CPU_FEATURES_PYBIND_H
+
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+
+#include <array>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "cpu_features.h"
+
+namespace py = pybind11;
+using namespace fst;
+
+namespace fst_pybind
+{
+	constexpr std::array<Kernel_Variant, 4> kernel_variants {
+		Kernel_Variant::scalar, Kernel_Variant::sse42, Kernel_Variant::avx2, Kernel_Variant::avx512
+	};
+
+	Kernel_Variant kernel_variant_from_name(const std::string &name)
+	{
+		for (const Kernel_Variant variant : kernel_variants)
+		{
+			if (kernel_variant_name(variant) == name)
+			{
+				return variant;
+			}
+		}
+
+		throw std::invalid_argument("Unknown kernel variant " + name + ".");
+	}
+
+	void init_cpu_features(py::module_ &m)
+	{
+		m.def("cpu_features", []
+			{
+				const Cpu_Features &features = fst::cpu_features();
+				return std::map<std::string, bool> {
+					{"popcnt", features.popcnt}, {"bmi2", features.bmi2}, {"avx2", features.avx2},
+					{"avx512f", features.avx512f}, {"avx512vpopcntdq", features.avx512vpopcntdq}
+				};
+			}, "Returns the instruction set extensions detected on the current CPU");
+
+		m.def("kernel_variants", []
+			{
+				std::vector<std::string> names;
+
+				for (const Kernel_Variant variant : kernel_variants)
+				{
+					if (is_kernel_variant_supported(variant))
+					{
+						names.emplace_back(kernel_variant_name(variant));
+					}
+				}
+
+				return names;
+			}, "Returns the names of the kernel variants supported by the current CPU, from narrowest to widest");
+
+		m.def("kernel_variant", [] { return std::string(kernel_variant_name(active_kernel_variant())); },
+			"Returns the name of the kernel variant in use: one of 'scalar', 'sse42', 'avx2' or 'avx512'");
+
+		m.def("set_kernel_variant", [](const std::string &name) { set_kernel_variant(kernel_variant_from_name(name)); }, py::arg("name"),
+			"Makes the kernels use the given variant, which must be supported by the current CPU");
+	}
+}
+
+#endif
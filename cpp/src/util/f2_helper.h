@@ -87,6 +87,39 @@ namespace fst
 		const unsigned int dot_product = f2_dot_product(x, y);
 		return {float_not(dot_product), static_cast<float>(dot_product)};
 	}
+
+	/// Whether permutation (mapping index i to permutation[i]) is a permutation of 0, ..., size - 1, for size at
+	/// most 64
+	constexpr bool is_bit_permutation(const std::span<const std::size_t> permutation, const std::size_t size) noexcept
+	{
+		std::size_t images = 0;
+
+		for (const std::size_t image : permutation)
+		{
+			if (image >= size || bit_set_at(images, image))
+			{
+				return false;
+			}
+
+			images |= std::size_t(1) << image;
+		}
+
+		return permutation.size() == size;
+	}
+
+	/// Moves bit i of number to bit permutation[i]
+	template <std::unsigned_integral T>
+	constexpr T permute_bits(const T number, const std::span<const std::size_t> permutation) noexcept
+	{
+		T permuted = 0;
+
+		for (std::size_t i = 0; i < permutation.size(); i++)
+		{
+			permuted |= T(bit_set_at(number, i)) << permutation[i];
+		}
+
+		return permuted;
+	}
 }
 
-#endif
\ No newline at end of file
+#endif
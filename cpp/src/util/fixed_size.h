@@ -0,0 +1,30 @@
+#ifndef _FAST_STABILISER_FIXED_SIZE_H
+#define _FAST_STABILISER_FIXED_SIZE_H
+
+#include <cstddef>
+#include <utility>
+
+namespace fst
+{
+	/// The largest number of qubits for which the fixed size variants (Fixed_Stabiliser_State<N>, Fixed_Clifford<N>)
+	/// are instantiated. Above this, the generic classes are used.
+	constexpr std::size_t max_fixed_qubits = 16;
+
+	/// Returns function.template operator()<N>() for N = number_qubits, which must be at most max_fixed_qubits. This
+	/// lets a size only known at runtime select a kernel specialised at compile time for that size.
+	template <std::size_t N = 0, typename Function>
+	decltype(auto) dispatch_fixed_qubits(const std::size_t number_qubits, Function &&function)
+	{
+		if constexpr (N < max_fixed_qubits)
+		{
+			if (number_qubits != N)
+			{
+				return dispatch_fixed_qubits<N + 1>(number_qubits, std::forward<Function>(function));
+			}
+		}
+
+		return function.template operator()<N>();
+	}
+}
+
+#endif
@@ -0,0 +1,15 @@
+#ifndef _FAST_STABILISER_HASH_H
+#define _FAST_STABILISER_HASH_H
+
+#include <cstddef>
+
+namespace fst
+{
+	/// Mixes value into the hash seed, as in boost::hash_combine
+	constexpr void hash_combine(std::size_t &seed, const std::size_t value) noexcept
+	{
+		seed ^= value + 0x9e3779b97f4a7c15 + (seed << 6) + (seed >> 2);
+	}
+}
+
+#endif
@@ -0,0 +1,170 @@
+#include "mapped_file.h"
+
+#include <fstream>
+#include <stdexcept>
+#include <utility>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace fst
+{
+#ifdef _WIN32
+	Mapped_File::Mapped_File(const std::string &path)
+	{
+		file_handle = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+
+		if (file_handle == INVALID_HANDLE_VALUE)
+		{
+			file_handle = nullptr;
+			throw std::runtime_error("Could not open " + path);
+		}
+
+		LARGE_INTEGER file_size;
+
+		if (!GetFileSizeEx(file_handle, &file_size))
+		{
+			release();
+			throw std::runtime_error("Could not read the size of " + path);
+		}
+
+		size = static_cast<std::size_t>(file_size.QuadPart);
+
+		if (size == 0)
+		{
+			return;
+		}
+
+		mapping_handle = CreateFileMappingA(file_handle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+		const void *view = mapping_handle ? MapViewOfFile(mapping_handle, FILE_MAP_READ, 0, 0, 0) : nullptr;
+
+		if (view == nullptr)
+		{
+			release();
+			throw std::runtime_error("Could not map " + path);
+		}
+
+		address = static_cast<const std::byte *>(view);
+	}
+
+	void Mapped_File::release() noexcept
+	{
+		if (address)
+		{
+			UnmapViewOfFile(address);
+		}
+
+		if (mapping_handle)
+		{
+			CloseHandle(mapping_handle);
+		}
+
+		if (file_handle)
+		{
+			CloseHandle(file_handle);
+		}
+
+		address = nullptr;
+		size = 0;
+		mapping_handle = nullptr;
+		file_handle = nullptr;
+	}
+#else
+	Mapped_File::Mapped_File(const std::string &path)
+	{
+		const int descriptor = open(path.c_str(), O_RDONLY);
+
+		if (descriptor == -1)
+		{
+			throw std::runtime_error("Could not open " + path);
+		}
+
+		struct stat file_status;
+
+		if (fstat(descriptor, &file_status) == -1)
+		{
+			close(descriptor);
+			throw std::runtime_error("Could not read the size of " + path);
+		}
+
+		size = static_cast<std::size_t>(file_status.st_size);
+
+		if (size > 0)
+		{
+			void *view = mmap(nullptr, size, PROT_READ, MAP_SHARED, descriptor, 0);
+
+			if (view == MAP_FAILED)
+			{
+				close(descriptor);
+				throw std::runtime_error("Could not map " + path);
+			}
+
+			address = static_cast<const std::byte *>(view);
+		}
+
+		// The mapping stays valid after the file is closed
+		close(descriptor);
+	}
+
+	void Mapped_File::release() noexcept
+	{
+		if (address)
+		{
+			munmap(const_cast<std::byte *>(address), size);
+		}
+
+		address = nullptr;
+		size = 0;
+	}
+#endif
+
+	Mapped_File::~Mapped_File()
+	{
+		release();
+	}
+
+	Mapped_File::Mapped_File(Mapped_File &&other) noexcept
+	{
+		*this = std::move(other);
+	}
+
+	Mapped_File &Mapped_File::operator=(Mapped_File &&other) noexcept
+	{
+		if (this != &other)
+		{
+			release();
+
+			std::swap(address, other.address);
+			std::swap(size, other.size);
+#ifdef _WIN32
+			std::swap(file_handle, other.file_handle);
+			std::swap(mapping_handle, other.mapping_handle);
+#endif
+		}
+
+		return *this;
+	}
+
+	std::span<const std::byte> Mapped_File::data() const
+	{
+		return {address, size};
+	}
+
+	void write_file(const std::string &path, std::span<const std::byte> bytes)
+	{
+		std::ofstream file(path, std::ios::binary | std::ios::trunc);
+
+		if (!file || !file.write(reinterpret_cast<const char *>(bytes.data()), static_cast<std::streamsize>(bytes.size())))
+		{
+			throw std::runtime_error("Could not write " + path);
+		}
+	}
+}
@@ -0,0 +1,42 @@
+#ifndef _FAST_STABILISER_MAPPED_FILE_H
+#define _FAST_STABILISER_MAPPED_FILE_H
+
+#include <cstddef>
+#include <span>
+#include <string>
+
+namespace fst
+{
+	/// A read-only memory mapping of a whole file, so its contents can be read in place without copying them into
+	/// memory. The mapping is released when the instance is destroyed.
+	class Mapped_File
+	{
+		public:
+		/// Maps the file at the given path, throwing std::runtime_error if it cannot be opened or mapped
+		explicit Mapped_File(const std::string &path);
+		~Mapped_File();
+
+		Mapped_File(Mapped_File &&other) noexcept;
+		Mapped_File &operator=(Mapped_File &&other) noexcept;
+		Mapped_File(const Mapped_File &) = delete;
+		Mapped_File &operator=(const Mapped_File &) = delete;
+
+		std::span<const std::byte> data() const;
+
+		private:
+		const std::byte *address = nullptr;
+		std::size_t size = 0;
+
+#ifdef _WIN32
+		void *file_handle = nullptr;
+		void *mapping_handle = nullptr;
+#endif
+
+		void release() noexcept;
+	};
+
+	/// Writes the bytes to the file at the given path, replacing its contents, and throwing std::runtime_error on failure
+	void write_file(const std::string &path, std::span<const std::byte> bytes);
+}
+
+#endif
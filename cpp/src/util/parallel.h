@@ -0,0 +1,57 @@
+#ifndef _FAST_STABILISER_PARALLEL_H
+#define _FAST_STABILISER_PARALLEL_H
+
+#include <algorithm>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+namespace fst
+{
+	/// The number of threads used by the parallel algorithms, the number of hardware threads by default
+	inline unsigned int &number_threads()
+	{
+		static unsigned int threads = std::max(1u, std::thread::hardware_concurrency());
+		return threads;
+	}
+
+	/// Calls function(begin, end) on disjoint ranges covering [0, size), with each begin a multiple of grain_size,
+	/// spread over up to number_threads() threads (including the calling one). Ranges of a single grain are not
+	/// split, so small problems run on the calling thread without starting any threads. The function must not throw.
+	template <typename Function>
+	void parallel_for(const std::size_t size, const std::size_t grain_size, Function &&function)
+	{
+		const std::size_t number_grains = (size + grain_size - 1) / grain_size;
+		const std::size_t number_workers = std::min<std::size_t>(number_threads(), number_grains);
+
+		if (number_workers <= 1)
+		{
+			function(std::size_t(0), size);
+			return;
+		}
+
+		const auto run_worker = [&](const std::size_t worker)
+		{
+			const std::size_t begin = (number_grains * worker / number_workers) * grain_size;
+			const std::size_t end = std::min(size, (number_grains * (worker + 1) / number_workers) * grain_size);
+			function(begin, end);
+		};
+
+		std::vector<std::thread> workers;
+		workers.reserve(number_workers - 1);
+
+		for (std::size_t worker = 1; worker < number_workers; worker++)
+		{
+			workers.emplace_back(run_worker, worker);
+		}
+
+		run_worker(0);
+
+		for (std::thread &thread : workers)
+		{
+			thread.join();
+		}
+	}
+}
+
+#endif
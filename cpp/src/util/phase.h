@@ -0,0 +1,78 @@
+#ifndef _FAST_STABILISER_PHASE_H
+#define _FAST_STABILISER_PHASE_H
+
+#include <array>
+#include <complex>
+#include <concepts>
+#include <optional>
+
+namespace fst
+{
+	/// Phases that are powers of the eighth root of unity w = e^(i pi/4) are tracked as their exponent,
+	/// an integer mod 8. In particular i^k = w^(2k), so (-1)^sign_bit * (-i)^imag_bit = w^(4 sign_bit + 6 imag_bit).
+	/// Arithmetic on phases is then exact integer addition, and complex values are only formed at output.
+	using Phase_Exponent = unsigned int;
+
+	/// w^k for k = 0, ..., 7, rounded to the given precision
+	template <std::floating_point Real>
+	inline constexpr std::array<std::complex<Real>, 8> eighth_roots_of_unity {{
+		{Real(1), Real(0)}, {Real(0.70710678118654752440L), Real(0.70710678118654752440L)}, {Real(0), Real(1)},
+		{Real(-0.70710678118654752440L), Real(0.70710678118654752440L)}, {Real(-1), Real(0)},
+		{Real(-0.70710678118654752440L), Real(-0.70710678118654752440L)}, {Real(0), Real(-1)},
+		{Real(0.70710678118654752440L), Real(-0.70710678118654752440L)}
+	}};
+
+	/// Returns w^exponent
+	template <std::floating_point Real = float>
+	constexpr std::complex<Real> phase_from_exponent(const Phase_Exponent exponent) noexcept
+	{
+		return eighth_roots_of_unity<Real>[exponent & 7];
+	}
+
+	/// The squared distance, relative to the squared magnitude of the amplitudes involved, below which two amplitudes
+	/// are taken to be equal when testing whether a state vector or matrix is a stabiliser state or a Clifford. Being
+	/// relative, this does not depend on the number of qubits, whereas the amplitudes of a state on n qubits are as
+	/// small as 2^(-n/2).
+	template <std::floating_point Real>
+	inline constexpr Real amplitude_tolerance = std::same_as<Real, float> ? Real(1e-3) : Real(1e-8);
+
+	/// Whether the amplitudes are equal up to the tolerance above, relative to the reference amplitude
+	template <std::floating_point Real>
+	constexpr bool amplitudes_match(const std::complex<Real> amplitude, const std::complex<Real> reference) noexcept
+	{
+		return std::norm(amplitude - reference) < amplitude_tolerance<Real> * std::norm(reference);
+	}
+
+	/// Returns w^exponent * number. When the exponent is even (i.e. the phase is a power of i), this only swaps
+	/// and negates the real and imaginary parts, so is exact.
+	template <typename T>
+	constexpr std::complex<T> multiply_by_phase(const std::complex<T> number, const Phase_Exponent exponent) noexcept
+	{
+		switch (exponent & 7)
+		{
+			case 0: return number;
+			case 2: return {-number.imag(), number.real()};
+			case 4: return -number;
+			case 6: return {number.imag(), -number.real()};
+			default: return number * phase_from_exponent<T>(exponent);
+		}
+	}
+
+	/// If number is within the given (squared) distance of a power of i, returns the exponent of that power as
+	/// an element of Z_8 (so one of 0, 2, 4, 6). Otherwise, returns nothing.
+	template <std::floating_point Real>
+	std::optional<Phase_Exponent> quarter_phase_exponent(const std::complex<Real> number, const Real tolerance = Real(0.125))
+	{
+		for (Phase_Exponent exponent = 0; exponent < 8; exponent += 2)
+		{
+			if (std::norm(number - phase_from_exponent<Real>(exponent)) < tolerance)
+			{
+				return exponent;
+			}
+		}
+
+		return std::nullopt;
+	}
+}
+
+#endif
@@ -0,0 +1,113 @@
+#ifndef _FAST_STABILISER_RANDOM_H
+#define _FAST_STABILISER_RANDOM_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+
+namespace fst
+{
+	/// A small and fast seedable pseudorandom number generator (xoshiro256** by Blackman and Vigna). It satisfies
+	/// std::uniform_random_bit_generator, so can also be used with the standard library distributions.
+	class Random_Generator
+	{
+		public:
+		using result_type = std::uint64_t;
+
+		/// The state is filled from the seed with splitmix64, as recommended by the authors of xoshiro
+		explicit Random_Generator(std::uint64_t seed = 0)
+		{
+			for (std::uint64_t &word : state)
+			{
+				seed += 0x9e3779b97f4a7c15;
+				std::uint64_t mixed = seed;
+				mixed = (mixed ^ (mixed >> 30)) * 0xbf58476d1ce4e5b9;
+				mixed = (mixed ^ (mixed >> 27)) * 0x94d049bb133111eb;
+				word = mixed ^ (mixed >> 31);
+			}
+		}
+
+		static constexpr result_type min()
+		{
+			return 0;
+		}
+
+		static constexpr result_type max()
+		{
+			return std::numeric_limits<result_type>::max();
+		}
+
+		result_type operator()()
+		{
+			const std::uint64_t result = rotate_left(state[1] * 5, 7) * 9;
+			const std::uint64_t shifted = state[1] << 17;
+
+			state[2] ^= state[0];
+			state[3] ^= state[1];
+			state[1] ^= state[2];
+			state[0] ^= state[3];
+			state[2] ^= shifted;
+			state[3] = rotate_left(state[3], 45);
+
+			return result;
+		}
+
+		/// Returns a uniformly random integer with the given number of bits, i.e. a uniformly random vector in
+		/// F_2^number_bits. Throws for more than 64 bits.
+		std::uint64_t random_bits(const std::size_t number_bits)
+		{
+			if (number_bits > 64)
+			{
+				throw std::invalid_argument("At most 64 random bits can be generated at once.");
+			}
+
+			return number_bits == 0 ? 0 : (*this)() >> (64 - number_bits);
+		}
+
+		bool random_bit()
+		{
+			return (*this)() >> 63;
+		}
+
+		/// Returns a uniformly random double in [0, 1), with 53 random bits
+		double random_unit()
+		{
+			return double((*this)() >> 11) * 0x1.0p-53;
+		}
+
+		/// Returns true with the given probability
+		bool random_event(const double probability)
+		{
+			return random_unit() < probability;
+		}
+
+		/// Returns a uniformly random integer in [0, bound), for bound > 0
+		std::uint64_t random_below(const std::uint64_t bound)
+		{
+			// Reject the lowest (2^64 mod bound) values, so that the remainder is uniform
+			const std::uint64_t threshold = (0 - bound) % bound;
+
+			while (true)
+			{
+				const std::uint64_t value = (*this)();
+
+				if (value >= threshold)
+				{
+					return value % bound;
+				}
+			}
+		}
+
+		private:
+		std::array<std::uint64_t, 4> state;
+
+		static constexpr std::uint64_t rotate_left(const std::uint64_t value, const int shift)
+		{
+			return (value << shift) | (value >> (64 - shift));
+		}
+	};
+}
+
+#endif
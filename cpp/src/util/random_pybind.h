@@ -0,0 +1,28 @@
+#ifndef _FAST_STABILISER_RANDOM_PYBIND_H
+#define _FAST_STABILISER_RANDOM_PYBIND_H
+
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+
+#include <optional>
+#include <random>
+
+#include "random.h"
+
+namespace py = pybind11;
+using namespace fst;
+
+namespace fst_pybind
+{
+	void init_random(py::module_ &m)
+	{
+		py::class_<Random_Generator>(m, "Random_Generator", "A seedable pseudorandom number generator, used by the random generators of paulis, cliffords and stabiliser states")
+			.def(py::init([](const std::optional<std::uint64_t> seed)
+				{ return Random_Generator(seed.value_or((std::uint64_t(std::random_device()()) << 32) | std::random_device()())); }),
+				py::arg("seed") = py::none(), "Seeds the generator, from std::random_device if no seed is given")
+			.def("random_bits", &Random_Generator::random_bits, py::arg("number_bits"), "Returns a uniformly random integer with the given number of bits, throwing for more than 64")
+			.def("random_below", &Random_Generator::random_below, py::arg("bound"), "Returns a uniformly random integer in [0, bound)");
+	}
+}
+
+#endif
@@ -0,0 +1,122 @@
+#include "scratch_arena.h"
+#include "stats.h"
+
+#include <algorithm>
+#include <cstdint>
+
+namespace fst
+{
+	namespace
+	{
+		constexpr std::size_t minimum_block_size = 4096;
+
+		/// Blocks are aligned to cache lines, so that larger alignments are rarely needed
+		constexpr std::size_t block_alignment = 64;
+	}
+
+	Scratch_Arena::Scratch_Arena(const std::size_t initial_bytes, std::pmr::memory_resource *upstream)
+		: upstream(upstream)
+	{
+		if (initial_bytes > 0)
+		{
+			blocks.push_back({static_cast<std::byte *>(upstream->allocate(initial_bytes, block_alignment)), initial_bytes});
+			FST_COUNT(bytes_allocated, initial_bytes);
+		}
+	}
+
+	Scratch_Arena::~Scratch_Arena()
+	{
+		for (const Block &block : blocks)
+		{
+			upstream->deallocate(block.data, block.size, block_alignment);
+		}
+	}
+
+	Scratch_Arena::Marker Scratch_Arena::mark() const
+	{
+		return position;
+	}
+
+	void Scratch_Arena::rewind(const Marker marker)
+	{
+		position = marker;
+	}
+
+	void Scratch_Arena::reset()
+	{
+		position = {};
+	}
+
+	std::size_t Scratch_Arena::capacity() const
+	{
+		std::size_t total_size = 0;
+
+		for (const Block &block : blocks)
+		{
+			total_size += block.size;
+		}
+
+		return total_size;
+	}
+
+	std::size_t Scratch_Arena::bytes_used() const
+	{
+		std::size_t used = position.offset;
+
+		for (std::size_t block = 0; block < position.block && block < blocks.size(); block++)
+		{
+			used += blocks[block].size;
+		}
+
+		return used;
+	}
+
+	void *Scratch_Arena::do_allocate(const std::size_t bytes, const std::size_t alignment)
+	{
+		// Try the current block, then any later blocks kept from before the last rewind, and only then a new block
+		for (;; position = {position.block + 1, 0})
+		{
+			if (position.block == blocks.size())
+			{
+				const std::size_t size = std::max(blocks.empty() ? minimum_block_size : 2 * blocks.back().size, bytes + alignment);
+				blocks.push_back({static_cast<std::byte *>(upstream->allocate(size, block_alignment)), size});
+				FST_COUNT(bytes_allocated, size);
+			}
+
+			const Block &block = blocks[position.block];
+			const std::size_t padding = -(reinterpret_cast<std::uintptr_t>(block.data) + position.offset) & (alignment - 1);
+
+			if (padding + bytes <= block.size - position.offset)
+			{
+				std::byte *pointer = block.data + position.offset + padding;
+				position.offset += padding + bytes;
+				return pointer;
+			}
+		}
+	}
+
+	void Scratch_Arena::do_deallocate(void *, const std::size_t, const std::size_t)
+	{
+	}
+
+	bool Scratch_Arena::do_is_equal(const std::pmr::memory_resource &other) const noexcept
+	{
+		return this == &other;
+	}
+
+	Scratch_Scope::Scratch_Scope(Scratch_Arena &arena)
+		: arena(arena), marker(arena.mark())
+	{
+	}
+
+	Scratch_Scope::~Scratch_Scope()
+	{
+		arena.rewind(marker);
+	}
+
+	Scratch_Arena &thread_scratch_arena()
+	{
+		thread_local Scratch_Arena arena;
+		return arena;
+	}
+}
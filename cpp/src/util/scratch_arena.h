@@ -0,0 +1,83 @@
+#ifndef _FAST_STABILISER_SCRATCH_ARENA_H
+#define _FAST_STABILISER_SCRATCH_ARENA_H
+
+#include <cstddef>
+#include <memory_resource>
+#include <vector>
+
+namespace fst
+{
+	/// A memory resource for short-lived allocations. Memory is handed out from a list of blocks by bumping a
+	/// pointer, and nothing is freed until the arena is rewound. The blocks are kept when rewinding, so once the
+	/// arena has grown to the most memory needed at once (e.g. by one iteration of a loop of conversions), it
+	/// allocates nothing.
+	///
+	/// Containers allocated in the arena, such as the states returned by the conversions taking an arena, are only
+	/// valid until it is rewound past them. Copies of them use the default allocator, so may be kept.
+	class Scratch_Arena : public std::pmr::memory_resource
+	{
+		public:
+		/// A position in the arena
+		struct Marker
+		{
+			std::size_t block = 0;
+			std::size_t offset = 0;
+		};
+
+		explicit Scratch_Arena(const std::size_t initial_bytes = 0, std::pmr::memory_resource *upstream = std::pmr::new_delete_resource());
+		~Scratch_Arena() override;
+
+		Scratch_Arena(const Scratch_Arena &) = delete;
+		Scratch_Arena &operator=(const Scratch_Arena &) = delete;
+
+		Marker mark() const;
+
+		/// Frees everything allocated since the marker was taken
+		void rewind(const Marker marker);
+
+		/// Frees everything allocated in the arena, keeping its blocks for later allocations
+		void reset();
+
+		/// The total size of the blocks
+		std::size_t capacity() const;
+
+		/// The number of bytes handed out since the arena was last reset, including padding
+		std::size_t bytes_used() const;
+
+		private:
+		struct Block
+		{
+			std::byte *data;
+			std::size_t size;
+		};
+
+		std::pmr::memory_resource *upstream;
+		std::vector<Block> blocks;
+		Marker position;
+
+		void *do_allocate(const std::size_t bytes, const std::size_t alignment) override;
+		void do_deallocate(void *pointer, const std::size_t bytes, const std::size_t alignment) override;
+		bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override;
+	};
+
+	/// Rewinds an arena on destruction to where it was on construction, freeing the temporaries allocated in between
+	class Scratch_Scope
+	{
+		public:
+		explicit Scratch_Scope(Scratch_Arena &arena);
+		~Scratch_Scope();
+
+		Scratch_Scope(const Scratch_Scope &) = delete;
+		Scratch_Scope &operator=(const Scratch_Scope &) = delete;
+
+		private:
+		Scratch_Arena &arena;
+		Scratch_Arena::Marker marker;
+	};
+
+	/// The arena of the calling thread, which the conversions use for their temporaries when they are not given an
+	/// arena. Each conversion rewinds it when done, so anything the caller allocates in it beforehand is kept.
+	Scratch_Arena &thread_scratch_arena();
+}
+
+#endif
@@ -0,0 +1,136 @@
+#include "stats.h"
+
+#include <algorithm>
+#include <mutex>
+#include <stdexcept>
+#include <vector>
+
+namespace fst
+{
+	namespace
+	{
+		/// The stats of the running threads, together with the totals of the threads that have exited and the totals
+		/// at the last reset
+		struct Stats_Registry
+		{
+			std::mutex mutex;
+			std::vector<const Thread_Stats *> threads;
+			Stats_Snapshot exited_threads;
+			Stats_Snapshot at_reset;
+		};
+
+		Stats_Registry &stats_registry()
+		{
+			// Never destroyed, as threads may exit (and so unregister) during static destruction
+			static Stats_Registry *registry = new Stats_Registry;
+			return *registry;
+		}
+
+		template <std::size_t size>
+		void add_values(std::array<std::uint64_t, size> &total, const std::array<std::atomic<std::uint64_t>, size> &values)
+		{
+			for (std::size_t i = 0; i < size; i++)
+			{
+				total[i] += values[i].load(std::memory_order_relaxed);
+			}
+		}
+
+		void add_thread_stats(Stats_Snapshot &total, const Thread_Stats &stats)
+		{
+			add_values(total.counters, stats.counters);
+			add_values(total.timer_calls, stats.timer_calls);
+			add_values(total.timer_nanoseconds, stats.timer_nanoseconds);
+		}
+
+		/// The stats of all threads since the library was loaded, with the registry locked
+		Stats_Snapshot total_stats(const Stats_Registry &registry)
+		{
+			Stats_Snapshot total = registry.exited_threads;
+
+			for (const Thread_Stats *stats : registry.threads)
+			{
+				add_thread_stats(total, *stats);
+			}
+
+			return total;
+		}
+
+		template <std::size_t size>
+		void subtract_values(std::array<std::uint64_t, size> &total, const std::array<std::uint64_t, size> &values)
+		{
+			for (std::size_t i = 0; i < size; i++)
+			{
+				total[i] -= values[i];
+			}
+		}
+	}
+
+	Thread_Stats::Thread_Stats()
+	{
+		Stats_Registry &registry = stats_registry();
+		const std::lock_guard lock(registry.mutex);
+		registry.threads.push_back(this);
+	}
+
+	Thread_Stats::~Thread_Stats()
+	{
+		Stats_Registry &registry = stats_registry();
+		const std::lock_guard lock(registry.mutex);
+		add_thread_stats(registry.exited_threads, *this);
+		registry.threads.erase(std::find(registry.threads.begin(), registry.threads.end(), this));
+	}
+
+	Stats_Snapshot stats_snapshot()
+	{
+		Stats_Registry &registry = stats_registry();
+		const std::lock_guard lock(registry.mutex);
+
+		Stats_Snapshot snapshot = total_stats(registry);
+		subtract_values(snapshot.counters, registry.at_reset.counters);
+		subtract_values(snapshot.timer_calls, registry.at_reset.timer_calls);
+		subtract_values(snapshot.timer_nanoseconds, registry.at_reset.timer_nanoseconds);
+
+		return snapshot;
+	}
+
+	void reset_stats()
+	{
+		Stats_Registry &registry = stats_registry();
+		const std::lock_guard lock(registry.mutex);
+		registry.at_reset = total_stats(registry);
+	}
+
+	std::string_view stats_counter_name(const Stats_Counter counter)
+	{
+		switch (counter)
+		{
+			case Stats_Counter::row_reduction_ops: return "row_reduction_ops";
+			case Stats_Counter::gray_code_steps: return "gray_code_steps";
+			case Stats_Counter::rejected_support: return "rejected_support";
+			case Stats_Counter::rejected_normalisation: return "rejected_normalisation";
+			case Stats_Counter::rejected_phase: return "rejected_phase";
+			case Stats_Counter::rejected_amplitude: return "rejected_amplitude";
+			case Stats_Counter::random_measurements: return "random_measurements";
+			case Stats_Counter::bytes_allocated: return "bytes_allocated";
+		}
+
+		throw std::invalid_argument("Unknown stats counter.");
+	}
+
+	std::string_view stats_timer_name(const Stats_Timer timer)
+	{
+		switch (timer)
+		{
+			case Stats_Timer::check_matrix_row_reduce: return "check_matrix_row_reduce";
+			case Stats_Timer::state_from_check_matrix: return "state_from_check_matrix";
+			case Stats_Timer::state_from_statevector: return "state_from_statevector";
+			case Stats_Timer::state_vector: return "state_vector";
+			case Stats_Timer::clifford_matrix: return "clifford_matrix";
+			case Stats_Timer::clifford_from_matrix: return "clifford_from_matrix";
+			case Stats_Timer::tableau_run: return "tableau_run";
+			case Stats_Timer::frame_sampling: return "frame_sampling";
+		}
+
+		throw std::invalid_argument("Unknown stats timer.");
+	}
+}
@@ -0,0 +1,166 @@
+#ifndef _FAST_STABILISER_STATS_H
+#define _FAST_STABILISER_STATS_H
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace fst
+{
+	/// The events counted on the hot paths
+	enum class Stats_Counter
+	{
+		/// Multiplications of rows of check matrices, and additions of basis vectors of stabiliser states
+		row_reduction_ops,
+		/// Steps of the Gray code walks over the support of a state, or over the columns of a Clifford
+		gray_code_steps,
+		/// State vectors rejected by the conversion to stabiliser states, because the support is not an affine space
+		rejected_support,
+		/// ... because the amplitudes do not have the norm of a stabiliser state
+		rejected_normalisation,
+		/// ... because the phase of an amplitude is not given by the linear and quadratic forms
+		rejected_phase,
+		/// ... because an amplitude differs from that of the stabiliser state determined by the others
+		rejected_amplitude,
+		/// Measurements of tableaus with random outcomes, which update O(n^2) bits rather than reading them
+		random_measurements,
+		/// Bytes allocated for state vectors and matrices, and for the blocks of scratch arenas
+		bytes_allocated,
+	};
+
+	/// The phases that are timed
+	enum class Stats_Timer
+	{
+		check_matrix_row_reduce,
+		state_from_check_matrix,
+		state_from_statevector,
+		state_vector,
+		clifford_matrix,
+		clifford_from_matrix,
+		tableau_run,
+		frame_sampling,
+	};
+
+	constexpr std::size_t number_stats_counters = static_cast<std::size_t>(Stats_Counter::bytes_allocated) + 1;
+	constexpr std::size_t number_stats_timers = static_cast<std::size_t>(Stats_Timer::frame_sampling) + 1;
+
+	std::string_view stats_counter_name(const Stats_Counter counter);
+	std::string_view stats_timer_name(const Stats_Timer timer);
+
+	/// The counters and timers of all threads, since they were last reset
+	struct Stats_Snapshot
+	{
+		std::array<std::uint64_t, number_stats_counters> counters {};
+		std::array<std::uint64_t, number_stats_timers> timer_calls {};
+		std::array<std::uint64_t, number_stats_timers> timer_nanoseconds {};
+
+		std::uint64_t count(const Stats_Counter counter) const
+		{
+			return counters[static_cast<std::size_t>(counter)];
+		}
+
+		std::uint64_t calls(const Stats_Timer timer) const
+		{
+			return timer_calls[static_cast<std::size_t>(timer)];
+		}
+
+		double seconds(const Stats_Timer timer) const
+		{
+			return timer_nanoseconds[static_cast<std::size_t>(timer)] * 1e-9;
+		}
+	};
+
+	/// Whether the library was built with the stats (FST_ENABLE_STATS). Otherwise, the counting and timing
+	/// compiles to nothing and the snapshots are all zero.
+	constexpr bool stats_enabled()
+	{
+#ifdef FST_ENABLE_STATS
+		return true;
+#else
+		return false;
+#endif
+	}
+
+	/// Sums the stats of the running threads and of the threads that have exited. Each thread only writes its own
+	/// stats, so this can be called while other threads are working, and sees their stats up to a moment ago.
+	Stats_Snapshot stats_snapshot();
+
+	/// Makes later snapshots count from now. This does not touch the stats of other threads, so is also safe to
+	/// call while they are working.
+	void reset_stats();
+
+	/// The stats of one thread, which only that thread writes to. The values are atomic so that snapshots may
+	/// read them at any time, but as there is a single writer they are updated with a plain load and store.
+	struct Thread_Stats
+	{
+		std::array<std::atomic<std::uint64_t>, number_stats_counters> counters {};
+		std::array<std::atomic<std::uint64_t>, number_stats_timers> timer_calls {};
+		std::array<std::atomic<std::uint64_t>, number_stats_timers> timer_nanoseconds {};
+
+		Thread_Stats();
+		~Thread_Stats();
+
+		Thread_Stats(const Thread_Stats &) = delete;
+		Thread_Stats &operator=(const Thread_Stats &) = delete;
+
+		static void add(std::atomic<std::uint64_t> &value, const std::uint64_t amount)
+		{
+			value.store(value.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+		}
+	};
+
+	/// The stats of the calling thread
+	inline Thread_Stats &thread_stats()
+	{
+		thread_local Thread_Stats stats;
+		return stats;
+	}
+
+	inline void add_to_counter(const Stats_Counter counter, const std::uint64_t amount)
+	{
+		Thread_Stats::add(thread_stats().counters[static_cast<std::size_t>(counter)], amount);
+	}
+
+	/// Adds the time from its construction to its destruction to a timer
+	class Scoped_Timer
+	{
+		public:
+		explicit Scoped_Timer(const Stats_Timer timer)
+			: timer(static_cast<std::size_t>(timer)), start(std::chrono::steady_clock::now())
+		{
+		}
+
+		~Scoped_Timer()
+		{
+			const auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+			Thread_Stats &stats = thread_stats();
+			Thread_Stats::add(stats.timer_calls[timer], 1);
+			Thread_Stats::add(stats.timer_nanoseconds[timer], elapsed.count());
+		}
+
+		Scoped_Timer(const Scoped_Timer &) = delete;
+		Scoped_Timer &operator=(const Scoped_Timer &) = delete;
+
+		private:
+		std::size_t timer;
+		std::chrono::steady_clock::time_point start;
+	};
+}
+
+#define FST_STATS_CONCATENATE_(first, second) first##second
+#define FST_STATS_CONCATENATE(first, second) FST_STATS_CONCATENATE_(first, second)
+
+/// FST_COUNT(counter, amount) adds to one of the Stats_Counters, and FST_TIME_SCOPE(timer) times the rest of the
+/// enclosing scope. Both compile to nothing unless FST_ENABLE_STATS is defined.
+#ifdef FST_ENABLE_STATS
+#define FST_COUNT(counter, amount) ::fst::add_to_counter(::fst::Stats_Counter::counter, (amount))
+#define FST_TIME_SCOPE(timer) const ::fst::Scoped_Timer FST_STATS_CONCATENATE(fst_scoped_timer_, __LINE__)(::fst::Stats_Timer::timer)
+#else
+#define FST_COUNT(counter, amount) ((void) 0)
+#define FST_TIME_SCOPE(timer) ((void) 0)
+#endif
+
+#endif
@@ -0,0 +1,47 @@
+#ifndef _FAST_STABILISER_STATS_PYBIND_H
+#define _FAST_STABILISER_STATS_PYBIND_H
+
+#include <pybind11/pybind11.h>
+
+#include <string>
+
+#include "stats.h"
+
+namespace py = pybind11;
+using namespace fst;
+
+namespace fst_pybind
+{
+	void init_stats(py::module_ &m)
+	{
+		m.def("stats", []
+			{
+				const Stats_Snapshot snapshot = stats_snapshot();
+				py::dict counters;
+				py::dict timers;
+
+				for (std::size_t counter = 0; counter < number_stats_counters; counter++)
+				{
+					counters[py::str(std::string(stats_counter_name(Stats_Counter(counter))))] = snapshot.counters[counter];
+				}
+
+				for (std::size_t timer = 0; timer < number_stats_timers; timer++)
+				{
+					py::dict timer_stats;
+					timer_stats["calls"] = snapshot.calls(Stats_Timer(timer));
+					timer_stats["seconds"] = snapshot.seconds(Stats_Timer(timer));
+					timers[py::str(std::string(stats_timer_name(Stats_Timer(timer))))] = timer_stats;
+				}
+
+				py::dict stats;
+				stats["counters"] = counters;
+				stats["timers"] = timers;
+				return stats;
+			}, "Returns the counters, and the number of calls and total seconds of each timed phase, summed over all threads since the last reset");
+
+		m.def("reset_stats", &reset_stats, "Makes the stats count from now");
+		m.def("stats_enabled", &stats_enabled, "Whether the library was built with the stats (FST_ENABLE_STATS); otherwise they are always zero");
+	}
+}
+
+#endif
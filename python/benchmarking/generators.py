@@ -22,7 +22,7 @@ def random_pauli_matrix(n: int) -> np.ndarray:
     p = random.randrange(1 << n)
     q = random.randrange(1 << n)
 
-    return fst.Pauli(n, p, q, s, t).generate_matrix()
+    return fst.Pauli(n, p, q, s, t).get_monomial_matrix().to_dense()
 
 
 def random_almost_pauli_matrix(n: int) -> np.ndarray:
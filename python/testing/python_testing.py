@@ -1,6 +1,6 @@
 print("### LAUNCHING PYTHON TESTS ###")
 
-import sys, unittest
+import sys, unittest, pickle, tempfile, os
 from math import sqrt
 import numpy as np
 
@@ -54,6 +54,88 @@ class TestStabiliserStateMethods(unittest.TestCase):
         # Check doesn't raise an exception
         fst.stabiliser_state_from_statevector(almost_stabiliser_statevector, assume_valid = True)
 
+    def test_random_stabiliser_state(self):
+        generator = fst.Random_Generator(1)
+
+        for stabiliser_state in fst.random_stabiliser_states(4, 10, generator):
+            self.assertTrue(fst.is_stabiliser_state(stabiliser_state.get_state_vector()))
+
+        check_matrix = fst.random_check_matrix(4, generator)
+        self.assertTrue(fst.is_stabiliser_state(fst.Stabiliser_State(check_matrix).get_state_vector()))
+
+        self.assertFalse(fst.is_stabiliser_state(fst.random_almost_stabiliser_statevector(4, generator)))
+
+    def test_fixed_size_statevectors(self):
+        generator = fst.Random_Generator(6)
+
+        # Up to 16 qubits the conversion uses the fixed size kernels, and above it the generic one
+        for number_qubits in [0, 1, 5, 16, 17]:
+            stabiliser_state = fst.random_stabiliser_state(number_qubits, generator)
+            statevector = stabiliser_state.get_state_vector()
+
+            self.assertTrue(fst.is_stabiliser_state(statevector))
+            self.assertEqual(fst.stabiliser_state_from_statevector(statevector), stabiliser_state)
+
+    def test_canonical_form(self):
+        generator = fst.Random_Generator(4)
+
+        for stabiliser_state in fst.random_stabiliser_states(4, 10, generator):
+            # The state from the state vector is stored with a different basis
+            other_state = fst.stabiliser_state_from_statevector(stabiliser_state.get_state_vector())
+            self.assertEqual(stabiliser_state, other_state)
+            self.assertEqual(hash(stabiliser_state), hash(other_state))
+
+            check_matrix = fst.Check_Matrix(stabiliser_state)
+            other_check_matrix = fst.Check_Matrix(other_state)
+            self.assertEqual(check_matrix, other_check_matrix)
+            self.assertEqual(hash(check_matrix), hash(other_check_matrix))
+
+            statevector = np.array(stabiliser_state.get_state_vector())
+            stabiliser_state.canonicalise()
+            self.assertTrue(stabiliser_state.is_canonical())
+            self.assertTrue(np.allclose(statevector, np.array(stabiliser_state.get_state_vector())))
+
+        self.assertEqual(len(set(fst.random_stabiliser_states(1, 200, generator))), 6)
+
+    def test_large_check_matrix_canonical_form(self):
+        # Above 32 qubits the x and z bits of a pauli no longer fit in one word together
+        generator = fst.Random_Generator(8)
+
+        for number_qubits in [33, 48, 64]:
+            check_matrix = fst.random_check_matrix(number_qubits, generator)
+            paulis = check_matrix.get_paulis()[::-1]
+
+            for i in range(1, number_qubits):
+                paulis[i].multiply_by_pauli_on_right(paulis[i - 1])
+
+            other_check_matrix = fst.Check_Matrix(paulis)
+            self.assertEqual(check_matrix, other_check_matrix)
+            self.assertEqual(hash(check_matrix), hash(other_check_matrix))
+
+            other_check_matrix.canonicalise()
+            self.assertTrue(other_check_matrix.is_canonical())
+            pivots = {(pauli.x_vector.bit_length(), pauli.z_vector.bit_length() if pauli.x_vector == 0 else 0) for pauli in other_check_matrix.get_paulis()}
+            self.assertEqual(len(pivots), number_qubits)
+
+            # Each generator is measured deterministically with outcome 0
+            self.assertFalse(other_check_matrix.measure(paulis[-1], generator))
+
+    def test_stabiliser_state_rank(self):
+        self.assertEqual(fst.number_stabiliser_states(2), 60)
+
+        for rank in range(60):
+            self.assertEqual(fst.rank_stabiliser_state(fst.unrank_stabiliser_state(2, rank)), rank)
+
+        stabiliser_states = fst.random_stabiliser_states(5, 10, fst.Random_Generator(1))
+        ranks = fst.rank_stabiliser_states(stabiliser_states)
+        self.assertEqual(ranks.dtype, np.uint64)
+
+        for stabiliser_state, unranked_state in zip(stabiliser_states, fst.unrank_stabiliser_states(5, ranks)):
+            # Ranks ignore the global phase
+            statevector = np.array(stabiliser_state.get_state_vector())
+            unranked_statevector = np.array(unranked_state.get_state_vector())
+            self.assertAlmostEqual(abs(np.vdot(statevector, unranked_statevector)), 1, places = 5)
+
     def test_consistency_again(self):
         stabiliser_statevector = np.array([0, 1, 0, 0, 0, 0, 1, 0]) / np.sqrt(2)
         self.assertTrue(fst.is_stabiliser_state(stabiliser_statevector))
@@ -65,6 +147,214 @@ class TestStabiliserStateMethods(unittest.TestCase):
         
         self.assertTrue( np.linalg.norm(stabiliser_statevector - output_statevector) <= 1e-7 )
         
+    def test_sparse_statevector(self):
+        stabiliser_statevector = np.array([0, 1, 0, 0, 0, 0, 1j, 0]) / np.sqrt(2)
+        indices, amplitudes = fst.stabiliser_state_from_statevector(stabiliser_statevector).get_sparse_state_vector()
+
+        self.assertTrue(fst.is_sparse_stabiliser_state(3, indices, amplitudes))
+        self.assertFalse(fst.is_sparse_stabiliser_state(3, indices, [amplitudes[0], 2*amplitudes[1]]))
+
+        sparse_state = fst.stabiliser_state_from_sparse_statevector(3, [6, 1], [1j/np.sqrt(2), 1/np.sqrt(2)])
+        self.assertTrue(np.allclose(stabiliser_statevector, np.array(sparse_state.get_state_vector())))
+
+        # The dense state vector for this would need 2^50 entries
+        large_state = fst.stabiliser_state_from_sparse_statevector(50, [3, 3 | 1 << 49], [.5**.5, -.5**.5])
+        self.assertEqual(large_state.dim, 1)
+        self.assertEqual(sorted(large_state.get_sparse_state_vector()[0]), [3, 3 | 1 << 49])
+
+    def test_support_iterator(self):
+        stabiliser_statevector = np.array([1, 0, 1j, 0, -1, 0, 1j, 0]) / 2
+        stabiliser_state = fst.stabiliser_state_from_statevector(stabiliser_statevector)
+
+        streamed = np.zeros(8, dtype = complex)
+        for index, amplitude in stabiliser_state.iter_support():
+            streamed[index] = amplitude
+
+        self.assertTrue(np.allclose(stabiliser_statevector, streamed))
+
+        chunks = list(stabiliser_state.iter_support_chunks(3))
+        self.assertEqual([len(indices) for indices, _ in chunks], [3, 1])
+
+        indices, amplitudes = stabiliser_state.get_support_chunk(1, 2)
+        self.assertTrue(np.array_equal(indices, chunks[0][0][1:]))
+        self.assertTrue(np.allclose(amplitudes, chunks[0][1][1:]))
+
+    def test_stats(self):
+        fst.reset_stats()
+        self.assertFalse(fst.is_stabiliser_state(self.get_non_stabiliser_statevector(3)))
+        fst.stabiliser_state_from_statevector(self.get_uniform_stabiliser_state(3)).get_state_vector()
+
+        stats = fst.stats()
+        rejections = sum(count for name, count in stats['counters'].items() if name.startswith('rejected_'))
+
+        if not fst.stats_enabled():
+            self.assertEqual(rejections, 0)
+            return
+
+        self.assertEqual(rejections, 1)
+        self.assertGreater(stats['counters']['gray_code_steps'], 0)
+        self.assertEqual(stats['timers']['state_vector']['calls'], 1)
+        self.assertEqual(stats['timers']['state_from_statevector']['calls'], 2)
+
+        fst.reset_stats()
+        self.assertTrue(all(count == 0 for count in fst.stats()['counters'].values()))
+
+    def test_scratch_arena_reuse(self):
+        # Above the fixed-size paths, the temporaries live in the thread's scratch arena, which is only grown once
+        statevector = self.get_uniform_stabiliser_state(17)
+        self.assertTrue(fst.is_stabiliser_state(statevector))
+
+        fst.reset_stats()
+        self.assertTrue(fst.is_stabiliser_state(statevector))
+        self.assertFalse(fst.is_stabiliser_state(self.get_non_stabiliser_statevector(17)))
+        self.assertEqual(fst.stats()['counters']['bytes_allocated'], 0)
+
+    def test_measurement(self):
+        generator = fst.Random_Generator(2)
+
+        # Measuring Z on |0> is deterministic, and Z_0 on the GHZ state then fixes the other qubits
+        self.assertFalse(fst.stabiliser_state_from_statevector([1, 0]).measure(0, generator))
+
+        for _ in range(10):
+            ghz_state = fst.stabiliser_state_from_statevector(np.array([1, 0, 0, 0, 0, 0, 0, 1]) / np.sqrt(2))
+            outcome = ghz_state.measure(0, generator)
+            self.assertEqual(ghz_state.measure(2, generator), outcome)
+            self.assertTrue(np.allclose(np.array(ghz_state.get_state_vector()), np.eye(8)[7 if outcome else 0]))
+
+        for stabiliser_state in fst.random_stabiliser_states(4, 20, generator):
+            observable = fst.random_pauli(4, generator)
+            statevector = np.array(stabiliser_state.get_state_vector())
+            eigenvalue_statevector = np.array(observable.get_matrix()) @ statevector
+
+            check_matrix = fst.Check_Matrix(stabiliser_state)
+            outcome = stabiliser_state.measure(observable, generator)
+
+            # The collapsed state is the normalised projection onto the eigenspace
+            projection = (statevector + (-1)**outcome * eigenvalue_statevector) / 2
+            self.assertTrue(np.allclose(np.array(stabiliser_state.get_state_vector()), projection / np.linalg.norm(projection), atol = 1e-5))
+
+            # The check matrix collapses to the same state whenever it sees the same outcome
+            if check_matrix.measure(observable, generator) == outcome:
+                self.assertEqual(check_matrix, fst.Check_Matrix(stabiliser_state))
+
+    def test_marginal_probability(self):
+        generator = fst.Random_Generator(3)
+
+        for stabiliser_state in fst.random_stabiliser_states(5, 10, generator):
+            probabilities = np.abs(np.array(stabiliser_state.get_state_vector()))**2
+            check_matrix = fst.Check_Matrix(stabiliser_state)
+
+            # Prefixes of length k are the qubits in the mask 2^k - 1
+            for length in range(6):
+                for outcomes in range(1 << length):
+                    expected = probabilities[np.arange(32) % (1 << length) == outcomes].sum()
+                    self.assertAlmostEqual(stabiliser_state.marginal_probability((1 << length) - 1, outcomes), expected, places = 5)
+                    self.assertAlmostEqual(check_matrix.marginal_probability((1 << length) - 1, outcomes), expected, places = 5)
+
+    def test_tensor_and_permute(self):
+        generator = fst.Random_Generator(4)
+        first, second = fst.random_stabiliser_state(2, generator), fst.random_stabiliser_state(3, generator)
+
+        product = fst.tensor(first, second)
+        self.assertTrue(np.allclose(product.get_state_vector(), np.kron(first.get_state_vector(), second.get_state_vector()), atol = 1e-5))
+        self.assertEqual(fst.tensor(fst.Check_Matrix(first), fst.Check_Matrix(second)), fst.Check_Matrix(product))
+
+        # Reversing the qubits reverses the bits of the basis indices
+        reversed_state = fst.permute_qubits(product, [4, 3, 2, 1, 0])
+        indices = [int(format(i, "05b")[::-1], 2) for i in range(32)]
+        self.assertTrue(np.allclose(np.array(reversed_state.get_state_vector())[indices], product.get_state_vector(), atol = 1e-5))
+        self.assertRaises(ValueError, fst.permute_qubits, product, [0, 0, 1, 2, 3])
+
+    def test_partial_trace(self):
+        generator = fst.Random_Generator(5)
+        first, second = fst.random_check_matrix(2, generator), fst.random_check_matrix(3, generator)
+
+        # Tracing out one factor of a product state leaves the other
+        self.assertEqual(fst.Check_Matrix(fst.partial_trace(fst.tensor(first, second), 0b00111)), first)
+
+        # Each qubit of a Bell pair is maximally mixed
+        bell = fst.Check_Matrix([fst.Pauli(2, 3, 0, 0, 0), fst.Pauli(2, 0, 3, 0, 0)])
+        self.assertEqual(fst.partial_trace(bell, 0b01), [])
+
+    def test_incremental_check_matrix(self):
+        # Replacing Z_1 by -Z_1 on |00> gives |10>, and replacing it by X_1 then gives |+0>
+        check_matrix = fst.Check_Matrix([fst.Pauli(2, 0, 1, 0, 0), fst.Pauli(2, 0, 2, 0, 0)])
+        check_matrix.replace_generator(1, fst.Pauli(2, 0, 2, 1, 0))
+        self.assertEqual(check_matrix, fst.Check_Matrix(fst.stabiliser_state_from_statevector([0, 0, 1, 0])))
+
+        check_matrix.multiply_generator(1, fst.Pauli(2, 2, 2, 0, 0))
+        self.assertTrue(np.allclose(check_matrix.get_state_vector(), np.array([1, 0, 1, 0]) / np.sqrt(2), atol = 1e-5))
+
+        # Removing and adding back a generator of a Bell pair passes through the partial group of Z_0 Z_1
+        bell = fst.Check_Matrix([fst.Pauli(2, 3, 0, 0, 0), fst.Pauli(2, 0, 3, 0, 0)])
+        bell.remove_generator(0)
+        self.assertEqual(bell.get_paulis(), [fst.Pauli(2, 0, 3, 0, 0)])
+        self.assertRaises(ValueError, bell.add_generator, fst.Pauli(2, 1, 0, 0, 0))
+        self.assertRaises(ValueError, bell.add_generator, fst.Pauli(2, 0, 3, 1, 0))
+
+        bell.add_generator(fst.Pauli(2, 3, 0, 0, 0))
+        self.assertEqual(bell, fst.Check_Matrix([fst.Pauli(2, 3, 0, 0, 0), fst.Pauli(2, 0, 3, 0, 0)]))
+        self.assertRaises(ValueError, bell.add_generator, fst.Pauli(2, 0, 1, 0, 0))
+
+        # A partial group can't be pickled, but one built up from the trivial group to n generators can
+        generator = fst.Random_Generator(3)
+        paulis = fst.random_check_matrix(4, generator).get_paulis()
+        check_matrix = fst.Check_Matrix(4)
+        self.assertEqual(check_matrix.get_paulis(), [])
+
+        for pauli in paulis[:-1]:
+            check_matrix.add_generator(pauli)
+
+        self.assertRaises(ValueError, pickle.dumps, check_matrix)
+
+        check_matrix.add_generator(paulis[-1])
+        self.assertEqual(check_matrix, fst.Check_Matrix(paulis))
+        self.assertEqual(pickle.loads(pickle.dumps(check_matrix)), check_matrix)
+
+    def test_check_matrix_validation(self):
+        generator = fst.Random_Generator(6)
+        paulis = fst.random_check_matrix(5, generator).get_paulis()
+        self.assertTrue(fst.is_valid_check_matrix(paulis))
+        self.assertEqual(fst.Check_Matrix(paulis, validate = True), fst.Check_Matrix(paulis))
+
+        # Fewer paulis still generate a stabiliser group, but not a check matrix
+        self.assertTrue(fst.is_stabiliser_group(paulis[:3]))
+        self.assertFalse(fst.is_valid_check_matrix(paulis[:3]))
+
+        anticommuting = [fst.Pauli(2, 1, 0, 0, 0), fst.Pauli(2, 0, 1, 0, 0)]
+        dependent = [fst.Pauli(2, 0, 1, 0, 0), fst.Pauli(2, 0, 1, 1, 0)]
+        non_hermitian = [fst.Pauli(2, 1, 0, 0, 1), fst.Pauli(2, 0, 2, 0, 0)]
+
+        for invalid in [anticommuting, dependent, non_hermitian]:
+            self.assertFalse(fst.is_stabiliser_group(invalid))
+            self.assertRaises(ValueError, fst.Check_Matrix, invalid, validate = True)
+
+    def test_statevector_precision(self):
+        # Beyond 10 qubits the amplitudes are too small for an absolute tolerance to see a wrong phase
+        stabiliser_state = fst.random_stabiliser_state(12, fst.Random_Generator(7))
+        statevector = np.array(stabiliser_state.get_state_vector(double_precision = True))
+        self.assertEqual(statevector.dtype, np.complex128)
+        self.assertTrue(np.allclose(statevector, stabiliser_state.get_state_vector(), rtol = 1e-6, atol = 0))
+
+        for array in [statevector, statevector.astype(np.complex64)]:
+            self.assertTrue(fst.is_stabiliser_state(array))
+            self.assertEqual(fst.stabiliser_state_from_statevector(array), stabiliser_state)
+
+        indices, amplitudes = stabiliser_state.get_sparse_state_vector()
+        self.assertTrue(fst.is_sparse_stabiliser_state(12, indices, statevector[indices]))
+        self.assertEqual(fst.stabiliser_state_from_sparse_statevector(12, indices, statevector[indices]), stabiliser_state)
+
+        wrong_phase = statevector.copy()
+        wrong_phase[indices[-1]] *= 1j
+        self.assertFalse(fst.is_stabiliser_state(wrong_phase))
+        self.assertFalse(fst.is_stabiliser_state(wrong_phase.astype(np.complex64)))
+
+        # Double precision arrays are compared with a tighter (relative) tolerance
+        rescaled = statevector.copy()
+        rescaled[indices[-1]] *= 1.001
+        self.assertFalse(fst.is_stabiliser_state(rescaled))
+        self.assertTrue(fst.is_stabiliser_state(rescaled.astype(np.complex64)))
+
     def get_uniform_stabiliser_state(self, number_qubits : int):
         support_size = 1 << number_qubits
         return np.ones(support_size, dtype = complex)/sqrt(support_size)
@@ -74,6 +364,137 @@ class TestStabiliserStateMethods(unittest.TestCase):
         non_stabiliser_statevector[-1] *= -1
         return non_stabiliser_statevector
 
+class TestPauliMethods(unittest.TestCase):
+    def test_phase_exponent(self):
+        expected_phases = {0: 1, 2: 1j, 4: -1, 6: -1j}
+
+        for exponent, phase in expected_phases.items():
+            pauli = fst.Pauli(2, 1, 3, 0, 0)
+            pauli.set_phase_exponent(exponent)
+
+            self.assertEqual(exponent, pauli.get_phase_exponent())
+            self.assertEqual(phase, pauli.get_phase())
+
+        with self.assertRaises(ValueError):
+            fst.Pauli(1, 1, 0, 0, 0).set_phase_exponent(1)
+
+    def test_apply_in_place(self):
+        rng = np.random.default_rng(0)
+
+        for number_qubits in range(6):
+            size = 1 << number_qubits
+            vector = (rng.standard_normal(size) + 1j * rng.standard_normal(size)).astype(np.complex64)
+            x_vector, z_vector = int(rng.integers(size)), int(rng.integers(size))
+            pauli = fst.Pauli(number_qubits, x_vector, z_vector, 1, bin(x_vector & z_vector).count('1') % 2)
+
+            expected = np.array(pauli.get_matrix()) @ vector
+            self.assertTrue(np.allclose(expected, pauli.multiply_vector(vector)))
+
+            pauli.apply_in_place(vector)
+            self.assertTrue(np.allclose(expected, vector))
+
+            eigenstate = vector + np.array(pauli.multiply_vector(vector), dtype = np.complex64)
+            self.assertTrue(pauli.has_eigenstate(eigenstate, 0))
+
+    def test_multiply_vector_precision(self):
+        rng = np.random.default_rng(1)
+        vector = rng.standard_normal(16) + 1j * rng.standard_normal(16)
+        pauli = fst.Pauli(4, 5, 3, 1, 0)
+
+        # Arrays of dtype complex128 are multiplied in double precision, so exactly
+        self.assertTrue(np.array_equal(np.array(pauli.get_matrix()) @ vector, pauli.multiply_vector(vector)))
+
+    def test_kernel_variants(self):
+        rng = np.random.default_rng(1)
+        vector = (rng.standard_normal(64) + 1j * rng.standard_normal(64)).astype(np.complex64)
+        pauli = fst.Pauli(6, 45, 27, 1, 1)
+        expected = np.array(pauli.get_matrix()) @ vector
+
+        # Symplectic tableaus [[I, S], [0, I]] [[I, 0], [T, I]] for symmetric S and T, on rows of 5 and 9 words, which
+        # are not a whole number of AVX2 or AVX-512 blocks, and the same with a bit flipped
+        tableaus = []
+
+        for number_qubits in [300, 520]:
+            first, second = (rng.integers(0, 2, (number_qubits, number_qubits)) for _ in range(2))
+            identity, zero = np.eye(number_qubits, dtype = int), np.zeros((number_qubits, number_qubits), dtype = int)
+            tableau = np.block([[identity, np.triu(first) ^ np.triu(first, 1).T], [zero, identity]]) \
+                @ np.block([[identity, zero], [np.triu(second) ^ np.triu(second, 1).T, identity]]) % 2
+            broken = tableau.copy()
+            broken[3, number_qubits - 1] ^= 1
+
+            for matrix, symplectic in [(tableau, True), (broken, False)]:
+                blocks = [matrix[:number_qubits, :number_qubits], matrix[:number_qubits, number_qubits:], matrix[number_qubits:, :number_qubits], matrix[number_qubits:, number_qubits:]]
+                tableaus.append(([block.astype(bool) for block in blocks], symplectic))
+
+        widest_variant = fst.kernel_variant()
+        variants = fst.kernel_variants()
+        self.assertEqual(variants[0], 'scalar')
+        self.assertEqual(variants[-1], widest_variant)
+        self.assertIn('popcnt', fst.cpu_features())
+
+        try:
+            for variant in variants:
+                fst.set_kernel_variant(variant)
+                self.assertEqual(fst.kernel_variant(), variant)
+                self.assertTrue(np.allclose(expected, pauli.multiply_vector(vector)))
+                self.assertEqual(fst.rank_stabiliser_state(fst.unrank_stabiliser_state(5, 12345)), 12345)
+
+                for blocks, symplectic in tableaus:
+                    self.assertEqual(fst.is_symplectic(*blocks), symplectic)
+        finally:
+            fst.set_kernel_variant(widest_variant)
+
+        with self.assertRaises(ValueError):
+            fst.set_kernel_variant('mmx')
+
+    def test_pauli_rotation(self):
+        rng = np.random.default_rng(1)
+        number_qubits = 5
+        size = 1 << number_qubits
+
+        vector = (rng.standard_normal(size) + 1j * rng.standard_normal(size)).astype(np.complex64)
+        expected = vector.astype(complex)
+        rotations = []
+
+        for x_vector, z_vector, angle in [(3, 5, 0.3), (0, 7, 1.2), (17, 16, -0.4)]:
+            pauli = fst.Pauli(number_qubits, x_vector, z_vector, 0, bin(x_vector & z_vector).count('1') % 2)
+            matrix = np.array(pauli.get_matrix())
+            expected = (np.cos(angle / 2) * np.eye(size) - 1j * np.sin(angle / 2) * matrix) @ expected
+            rotations.append((pauli, angle))
+
+        batched = vector.copy()
+        fst.apply_pauli_rotations(batched, rotations)
+        self.assertTrue(np.allclose(expected, batched, atol = 1e-5))
+
+        for pauli, angle in rotations:
+            fst.apply_pauli_rotation(vector, pauli, angle)
+        self.assertTrue(np.allclose(expected, vector, atol = 1e-5))
+
+        with self.assertRaises(ValueError):
+            fst.apply_pauli_rotation(vector, fst.Pauli(number_qubits, 1, 1, 0, 0), 0.1)
+
+    def test_monomial_matrix(self):
+        X = fst.Pauli(2, 1, 0, 0, 0)
+        Y = fst.Pauli(2, 2, 2, 0, 1)
+        XY = fst.Pauli(2, 3, 2, 0, 1)
+
+        monomial_matrix = XY.get_monomial_matrix()
+        dense_matrix = np.array(XY.get_matrix())
+
+        self.assertTrue(np.allclose(dense_matrix, monomial_matrix.to_dense()))
+        self.assertTrue(np.allclose(dense_matrix, np.array(monomial_matrix.get_matrix())))
+        self.assertEqual(monomial_matrix, X.get_monomial_matrix() @ Y.get_monomial_matrix())
+
+        data, indices, indptr = monomial_matrix.get_csr_arrays()
+        for row in range(4):
+            self.assertEqual(dense_matrix[row][indices[indptr[row]]], data[indptr[row]])
+
+        vector = [1, 2j, 3, 4]
+        self.assertTrue(np.allclose(dense_matrix @ vector, monomial_matrix.multiply_vector(vector)))
+
+        with self.assertRaises(ValueError):
+            fst.Monomial_Matrix([0, 0], [1, 1])
+
 class TestCliffordMethods(unittest.TestCase):
     def test_clifford_consistency(self):
         X = fst.Pauli(1,1,0,0,0)
@@ -103,6 +524,19 @@ class TestCliffordMethods(unittest.TestCase):
 
         self.assertTrue(np.allclose(expected_matrix, matrix))
 
+    def test_monomial_clifford(self):
+        # CNOT from qubit 0 to qubit 1, followed by S on qubit 1
+        matrix = [[1, 0, 0, 0], [0, 0, 0, 1], [0, 0, 1j, 0], [0, 1j, 0, 0]]
+        monomial_matrix = fst.Monomial_Matrix([0, 3, 2, 1], [1, 1j, 1j, 1])
+
+        self.assertTrue(fst.is_clifford_matrix(matrix))
+        self.assertTrue(fst.is_clifford_matrix(monomial_matrix))
+        self.assertTrue(np.allclose(matrix, np.array(fst.clifford_from_matrix(matrix).get_matrix())))
+        self.assertTrue(np.allclose(matrix, np.array(fst.clifford_from_matrix(monomial_matrix).get_matrix())))
+
+        # Controlled-S is monomial, but not a Clifford
+        self.assertFalse(fst.is_clifford_matrix(fst.Monomial_Matrix([0, 1, 2, 3], [1, 1, 1, 1j])))
+
     def test_almost_clifford(self):
         almost_hadamard = self.get_almost_clifford_matrix()
 
@@ -112,6 +546,173 @@ class TestCliffordMethods(unittest.TestCase):
         # Check doesn't Raise an exception
         fst.clifford_from_matrix(almost_hadamard, assume_valid = True)
 
+    def test_random_clifford(self):
+        for clifford in fst.random_cliffords(3, 10, fst.Random_Generator(1)):
+            self.assertTrue(fst.is_clifford_matrix(clifford.get_matrix()))
+
+        # The same seed gives the same clifford
+        first_matrix = np.array(fst.random_clifford(3, fst.Random_Generator(2)).get_matrix())
+        second_matrix = np.array(fst.random_clifford(3, fst.Random_Generator(2)).get_matrix())
+        self.assertTrue(np.allclose(first_matrix, second_matrix))
+
+        self.assertFalse(fst.is_clifford_matrix(fst.random_almost_clifford_matrix(3, fst.Random_Generator(3))))
+
+        # The first column takes the global phase, which can't be zero
+        clifford = fst.random_clifford(2, fst.Random_Generator(5))
+        clifford.global_phase = 1j
+        first_column = np.array(clifford.get_matrix())[:, 0]
+        first_entry = first_column[np.flatnonzero(abs(first_column) > 1e-5)[0]]
+        self.assertTrue(np.isclose(first_entry / abs(first_entry), 1j))
+
+        clifford.global_phase = 0
+        self.assertRaises(ValueError, clifford.get_matrix)
+
+        # Random objects are packed into 64 bit words
+        generator = fst.Random_Generator(4)
+        self.assertLess(generator.random_bits(64), 2**64)
+        self.assertRaises(ValueError, generator.random_bits, 65)
+        self.assertRaises(ValueError, fst.random_pauli, 65, generator)
+        self.assertRaises(ValueError, fst.random_clifford, 65, generator)
+        self.assertRaises(ValueError, fst.random_stabiliser_state, 65, generator)
+
+    def test_clifford_tensor(self):
+        generator = fst.Random_Generator(6)
+        first, second = fst.random_clifford(1, generator), fst.random_clifford(2, generator)
+
+        product = fst.tensor(first, second)
+        self.assertTrue(np.allclose(product.get_matrix(), np.kron(first.get_matrix(), second.get_matrix()), atol = 1e-5))
+
+        # Permuting the qubits permutes the rows and columns of the matrix alike
+        permuted = np.array(fst.permute_qubits(product, [2, 0, 1]).get_matrix())
+        indices = [((i & 1) << 2) | (i >> 1) for i in range(8)]
+        self.assertTrue(np.allclose(permuted[np.ix_(indices, indices)], product.get_matrix(), atol = 1e-5))
+
+    def test_clifford_synthesis(self):
+        generator = fst.Random_Generator(7)
+
+        for clifford in fst.random_cliffords(3, 10, generator):
+            circuit = fst.synthesise_circuit(clifford)
+            matrix = np.array(clifford.get_matrix())
+
+            # Applying the circuit to each basis vector gives the columns of the matrix, up to a global phase
+            columns = np.eye(8, dtype = np.complex64)
+
+            for column in columns:
+                fst.apply_circuit(circuit, column)
+
+            phase = np.vdot(matrix[:, 0], columns[0])
+            self.assertAlmostEqual(abs(phase), 1, places = 5)
+            self.assertTrue(np.allclose(columns.T, phase * matrix, atol = 1e-5))
+
+        self.assertGreater(len(fst.synthesise_circuit(fst.random_clifford(40, generator))), 0)
+
+    def test_clifford_columns(self):
+        clifford = fst.random_clifford(4, fst.Random_Generator(8))
+        matrix = np.array(clifford.get_matrix())
+
+        self.assertTrue(np.allclose(clifford.get_columns(5, 7), matrix[:, 5:12].T, atol = 1e-5))
+        self.assertRaises(ValueError, clifford.get_columns, 10, 7)
+
+        with tempfile.TemporaryDirectory() as directory:
+            path = os.path.join(directory, "matrix.bin")
+            clifford.write_matrix(path)
+            self.assertTrue(np.allclose(np.fromfile(path, dtype = np.complex64).reshape(16, 16).T, matrix, atol = 1e-5))
+
+        # Beyond the fixed size kernel, the matrix is filled from the columns, which must agree with one at a time
+        clifford = fst.random_clifford(10, fst.Random_Generator(10))
+        matrix = np.array(clifford.get_matrix())
+        self.assertTrue(fst.is_clifford_matrix(matrix))
+
+        for column in [0, 1, 3, 500, 1023]:
+            self.assertTrue(np.allclose(clifford.get_columns(column, 1)[0], matrix[:, column], atol = 1e-5))
+
+    def test_clifford_numpy(self):
+        clifford = fst.random_clifford(10, fst.Random_Generator(9))
+        tableau = clifford.to_numpy()
+        x2x, x2z, z2x, z2z, x_signs, z_signs = tableau
+        self.assertEqual((x2x.dtype, x2x.shape, x_signs.shape), (np.dtype(bool), (10, 10), (10,)))
+
+        # The packed arrays are those of numpy.packbits, and both formats give back the tableau
+        packed_tableau = clifford.to_numpy(bit_packed = True)
+        self.assertTrue(np.array_equal(packed_tableau[0], np.packbits(x2x, axis = -1, bitorder = "little")))
+
+        for arrays in [tableau, packed_tableau]:
+            other_clifford = fst.Clifford.from_numpy(*arrays, validate = True)
+            self.assertEqual((other_clifford.z_conjugates, other_clifford.x_conjugates), (clifford.z_conjugates, clifford.x_conjugates))
+            self.assertTrue(fst.is_symplectic(*arrays[:4]))
+
+        # Z_0 must be mapped to a pauli anticommuting with the image of X_0
+        self.assertFalse(fst.is_symplectic(x2x, x2z, np.vstack([x2x[:1], z2x[1:]]), np.vstack([x2z[:1], z2z[1:]])))
+        self.assertRaises(ValueError, fst.Clifford.from_numpy, x2x, x2z, x2x, x2z, validate = True)
+
+        # The images of the Z_i are the stabilisers of U|0>
+        check_matrix = fst.Check_Matrix.from_numpy(z2x, z2z, z_signs, validate = True)
+        self.assertEqual(check_matrix, fst.Check_Matrix(clifford.z_conjugates))
+        self.assertTrue(all(np.array_equal(array, expected) for array, expected in zip(check_matrix.to_numpy(), (z2x, z2z, z_signs))))
+
+    def test_clifford_equality(self):
+        clifford = fst.random_clifford(3, fst.Random_Generator(5))
+        other_clifford = fst.clifford_from_matrix(clifford.get_matrix())
+
+        self.assertEqual(clifford, other_clifford)
+        self.assertEqual(hash(clifford), hash(other_clifford))
+
+    def test_serialisation(self):
+        generator = fst.Random_Generator(6)
+        cliffords = fst.random_cliffords(3, 5, generator)
+
+        for clifford in cliffords:
+            self.assertEqual(pickle.loads(pickle.dumps(clifford)), clifford)
+
+        batch = fst.Batch(fst.write_batch(cliffords))
+        self.assertEqual(batch.type, "Clifford")
+        self.assertEqual(batch.number_qubits, 3)
+        self.assertEqual(batch.to_list(), cliffords)
+
+        columns = batch.columns()
+        self.assertEqual(columns["z_conjugates_x"].shape, (5, 3))
+        self.assertEqual(columns["z_conjugates_x"].dtype, np.uint8)
+        self.assertEqual(list(columns["z_conjugates_x"][1]), [pauli.x_vector for pauli in cliffords[1].z_conjugates])
+
+        with tempfile.TemporaryDirectory() as directory:
+            path = os.path.join(directory, "states.fstb")
+            states = fst.random_stabiliser_states(4, 5, generator)
+            fst.save_batch(path, states)
+
+            batch = fst.Batch.open(path)
+            self.assertEqual(len(batch), 5)
+            self.assertEqual(batch[-1], states[-1])
+            self.assertRaises(IndexError, lambda: batch[5])
+            self.assertRaises(IndexError, lambda: batch[-6])
+            self.assertEqual(fst.Batch(np.memmap(path, dtype = np.uint8, mode = "r")).to_list(), states)
+            del batch
+
+    def test_check_matrix_serialisation(self):
+        check_matrix = fst.Check_Matrix([fst.Pauli(3, 7, 0, 0, 0), fst.Pauli(3, 0, 6, 0, 0), fst.Pauli(3, 0, 5, 1, 0)])
+        self.assertEqual(fst.Batch(fst.write_batch([check_matrix])).to_list(), [check_matrix])
+
+        partial = fst.Check_Matrix([fst.Pauli(3, 7, 0, 0, 0)])
+        self.assertRaises(ValueError, fst.write_batch, [partial])
+
+        too_many = fst.Check_Matrix([fst.Pauli(2, 3, 0, 0, 0), fst.Pauli(2, 0, 3, 0, 0), fst.Pauli(2, 3, 0, 1, 0)])
+        self.assertRaises(ValueError, fst.write_batch, [too_many])
+
+    def test_clifford_rank(self):
+        self.assertEqual(fst.number_cliffords(1), 24)
+        self.assertEqual(fst.number_cliffords(7), fst.rank_clifford(fst.unrank_clifford(7, fst.number_cliffords(7) - 1)) + 1)
+
+        cliffords = fst.random_cliffords(4, 10, fst.Random_Generator(1))
+        ranks = fst.rank_cliffords(cliffords)
+        self.assertEqual(ranks.shape, (10, 2))
+
+        for clifford, unranked_clifford in zip(cliffords, fst.unrank_cliffords(4, ranks)):
+            self.assertTrue(np.allclose(np.array(clifford.get_matrix()), np.array(unranked_clifford.get_matrix())))
+            self.assertEqual(fst.rank_clifford(clifford), fst.rank_clifford(unranked_clifford))
+
+        # The conjugates must be Hermitian, so iX is rejected where X is ranked
+        self.assertLess(fst.rank_clifford(fst.Clifford([fst.Pauli(1, 0, 1, 0, 0)], [fst.Pauli(1, 1, 0, 0, 0)])), fst.number_cliffords(1))
+        self.assertRaises(ValueError, fst.rank_clifford, fst.Clifford([fst.Pauli(1, 0, 1, 0, 0)], [fst.Pauli(1, 1, 0, 0, 1)]))
+
     def get_hadamard_tensor_hadamard(self):
         return [[.5, .5, .5, .5], [.5, -.5, .5, -.5], [.5, .5, -.5, -.5], [.5, -.5, -.5, .5]]
     
@@ -119,4 +720,108 @@ class TestCliffordMethods(unittest.TestCase):
         matrix = self.get_hadamard_tensor_hadamard()
         matrix[3][3] *= -1
 
-        return matrix
\ No newline at end of file
+        return matrix
+
+
+class TestSimulationMethods(unittest.TestCase):
+    def test_bell_circuit(self):
+        circuit = fst.Circuit(2)
+        circuit.append("H", 0)
+        circuit.append("CNOT", [0, 1])
+        circuit.append("M", [0, 1])
+        self.assertEqual(circuit.number_measurements, 2)
+        self.assertEqual(circuit.get_operations()[1], ("CNOT", [0, 1]))
+        self.assertRaises(ValueError, circuit.append, "CNOT", [0, 0])
+
+        generator = fst.Random_Generator(1)
+        outcomes = set()
+
+        for _ in range(20):
+            tableau = fst.Tableau(2)
+            first, second = tableau.run(circuit, generator)
+            self.assertEqual(first, second)
+            outcomes.add(first)
+
+        self.assertEqual(outcomes, {False, True})
+
+    def test_tableau_state(self):
+        generator = fst.Random_Generator(2)
+
+        for check_matrix in [fst.random_check_matrix(4, generator) for _ in range(10)]:
+            tableau = fst.Tableau(check_matrix)
+            self.assertEqual(tableau.to_check_matrix(), check_matrix)
+
+            for i in range(4):
+                for j in range(4):
+                    self.assertEqual(tableau.get_destabiliser(i).anticommutes_with(tableau.get_stabiliser(j)), i == j)
+
+            # The gates act on the state as the dense matrices do
+            tableau.h(0)
+            tableau.cz(1, 2)
+            tableau.s(3)
+            hadamard = np.array([[1, 1], [1, -1]]) / np.sqrt(2)
+            cz = np.diag([1, 1, 1, -1])
+            phase = np.diag([1, 1j])
+            # Qubit q is bit q of the basis index, so the last factor of the Kronecker product acts on qubit 0
+            unitary = np.kron(phase, np.kron(cz, hadamard))
+            expected = unitary @ np.array(check_matrix.get_state_vector())
+            self.assertAlmostEqual(abs(np.vdot(expected, np.array(tableau.to_stabiliser_state().get_state_vector()))), 1, places = 5)
+
+    def test_large_circuit(self):
+        # Far beyond a state vector, measuring each qubit of a GHZ state twice gives the same bit everywhere
+        circuit = fst.Circuit(1000)
+        circuit.append("H", 0)
+        circuit.append("CNOT", [target for qubit in range(999) for target in (qubit, qubit + 1)])
+        circuit.append("M", list(range(1000)) * 2)
+
+        record = fst.Tableau(1000).run(circuit, fst.Random_Generator(3))
+        self.assertEqual(len(record), 2000)
+        self.assertEqual(len(set(record)), 1)
+
+    def test_cancel_inverse_gates(self):
+        circuit = fst.Circuit(2)
+        circuit.append("H", 0)
+        circuit.append("CNOT", [0, 1])
+        circuit.append("S", 1)
+        circuit.append("S_DAG", 1)
+        circuit.append("CNOT", [0, 1])
+        circuit.append("H", 0)
+        circuit.append("M", 0)
+
+        self.assertEqual(fst.cancel_inverse_gates(circuit).get_operations(), [("M", [0])])
+
+    def test_frame_sampler(self):
+        circuit = fst.Circuit(2)
+        circuit.append("H", 0)
+        circuit.append("CNOT", [0, 1])
+        circuit.append("M", [0, 1])
+        generator = fst.Random_Generator(4)
+
+        sampler = fst.Frame_Sampler(circuit, generator, shots_per_block = 128)
+        records = sampler.sample(1000, generator)
+        self.assertEqual(records.shape, (1000, 1))
+        bits = np.unpackbits(records, axis = 1, bitorder = "little")[:, :2]
+        self.assertTrue(np.array_equal(bits[:, 0], bits[:, 1]))
+        self.assertTrue(200 < bits[:, 0].sum() < 800)
+
+        self.assertRaises(ValueError, fst.Frame_Sampler, circuit, generator, 100)
+        self.assertRaises(ValueError, circuit.append, "H", [0], 0.5)
+
+    def test_frame_sampler_noise(self):
+        circuit = fst.Circuit(3)
+        circuit.append("X_ERROR", [0], 1)
+        circuit.append("Z_ERROR", [1], 1)
+        circuit.append("X_ERROR", [2], 0.25)
+        circuit.append("M", [0, 1, 2])
+        generator = fst.Random_Generator(5)
+
+        sampler = fst.Frame_Sampler(circuit, generator)
+        self.assertEqual(sampler.reference_record, [False, False, False])
+
+        # Write into a caller's buffer
+        records = np.zeros((4000, sampler.record_bytes), dtype = np.uint8)
+        sampler.sample_into(records, generator)
+        bits = np.unpackbits(records, axis = 1, bitorder = "little")[:, :3]
+        self.assertTrue(bits[:, 0].all())
+        self.assertFalse(bits[:, 1].any())
+        self.assertAlmostEqual(bits[:, 2].mean(), 0.25, delta = 0.03)